@@ -115,6 +115,13 @@ else
 $(error Cannot find $(GNUTLS))
 endif
 
+ZLIB=zlib
+ifeq ($(shell pkg-config --exists $(ZLIB) && echo 1), 1)
+LIBS+=$(ZLIB)
+else
+$(error Cannot find $(ZLIB))
+endif
+
 # >=json-c-0.11 renamed its library, pc file, and include dir
 # first check for >=0.11, if it doesn't exist check for <0.11
 ifeq ($(shell pkg-config --exists json-c && echo 1), 1)
@@ -1246,14 +1246,14 @@ exar_help(int ret)
             "   dwbem --archive option [arguments]\n\n" 
            "OPTIONS:\n" 
            "    h                   Print this help and exit.\n"
-           "    a[v] archive file   Appends a file or directory to an archive\n"
+           "    a[vz] archive file  Appends a file or directory to an archive\n"
            "    d[v] archive file   Deletes a file from an archive, the file path is the\n"
            "                        relative file path of the file in the archive\n"
            "    e[v] archive file   Extracts a file from an archive and writes the content\n" 
            "                        to stdout, the archive is not modified, the file path \n"
            "                        is the relative file path of the file in the archive.\n"
            "    l[v] archive        List archive content\n"
-           "    p[v] path [outname] Pack file or directory 'path'. If <outname> is \n"
+           "    p[vz] path [out]    Pack file or directory 'path'. If <out> is \n"
            "                        omitted the default output name is <path>.exar.\n"
            "    s[v] archive file   Search for a file and write the content to stdout, the \n" 
            "                        archive is not modified, the filename is the basename\n" 
@@ -1261,7 +1261,8 @@ exar_help(int ret)
            "                        parts are stripped\n"
            "    u[v] file [dir]     Pack 'file' to directory 'dir' or to current directory.\n"
            "    v                   Verbose, pass multiple times (up to 3) to \n"
-           "                        get more verbose messages.\n\n"
+           "                        get more verbose messages.\n"
+           "    z                   Compress files when packing or appending.\n\n"
            "EXAMPLES:\n"
            "    dwbem --archive p /tmp/foo          -- pack /tmp/foo to foo.exar\n"
            "    dwbem --archive s foo.js > foo.js   -- Extract foo.js from the archive\n"
@@ -1289,7 +1290,7 @@ exar_xextract(const char *archive, const char *path,
 void 
 parse_exar_options(char **argv)
 {
-    int argc = 0, flag = 0;
+    int argc = 0, flag = 0, compress = 0;
     const char *options;
 
     if (argv == NULL)
@@ -1327,6 +1328,9 @@ parse_exar_options(char **argv)
             case 'v' : 
                 flag |= MAX(EXAR_FLAG_v, MIN(EXAR_VERBOSE_MASK, ((flag & EXAR_VERBOSE_MASK) << 1)));
                 break;
+            case 'z' : 
+                compress = 1;
+                break;
             case 'h' : 
                 exar_help(EXIT_SUCCESS);
             default : 
@@ -1336,6 +1340,8 @@ parse_exar_options(char **argv)
     }
     if (flag & EXAR_VERBOSE_MASK)
         exar_verbose(flag);
+    if (compress)
+        exar_compression(-1);
 
     if (EXAR_CHECK_FLAG(flag, a) && argc > 2)
         exar_append(argv[1], argv[2]);
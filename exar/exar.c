@@ -30,12 +30,15 @@
 #include <string.h>
 #include <stdio.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <stdarg.h>
 #include <unistd.h>
 #include <ftw.h>
 #include <errno.h>
 #include <assert.h>
 #include <inttypes.h>
+#include <pthread.h>
+#include <zlib.h>
 #include "exar.h"
 
 #define EXAR_VERSION_BASE "exar-"
@@ -52,6 +55,8 @@
 
 #define DIR_FLAG    (100)
 #define FILE_FLAG  (102)
+#define ZFILE_FLAG (122)
+#define HAS_DATA(flag) ((flag) == FILE_FLAG || (flag) == ZFILE_FLAG)
 
 #define MAX_FILE_HANDLES 64
 
@@ -59,6 +64,21 @@
 
 #define EXAR_NAME_MAX 4096
 
+/* 
+ * The index is stored as regular file member with a name that can never be
+ * packed (hidden files are ignored), the last SZ_FOOTER bytes of its content
+ * point back to its header.
+ * */
+#define EXAR_INDEX_NAME ".exar-index"
+#define EXAR_INDEX_MAGIC "exidx-1"
+
+#define SZ_MAGIC   8
+#define SZ_FOOTER  (SZ_MAGIC + 2*SZ_SIZE)
+#define SZ_ENTRY   (SZ_DFLAG + 2*SZ_SIZE)
+
+#define MAX_CACHED_ARCHIVES 8
+#define MAX_PACK_THREADS 8
+
 #define EE_OK     0
 #define EE_ERROR -1
 #define EE_EOF   -2
@@ -70,6 +90,47 @@ struct exar_header_s {
 };
 #define EXAR_HEADER_EMPTY  { 0, 0, { 0 } }  
 
+struct exar_entry_s {
+    char *name;
+    const char *base;
+    unsigned char flag;
+    off_t offset;
+    off_t size;
+    size_t order;
+    unsigned char *inflated;
+    off_t inflated_size;
+};
+
+/*
+ * File or directory collected for packing, files are read and compressed
+ * before they are written
+ * */
+struct exar_member_s {
+    char *path;
+    char *name;
+    unsigned char flag;
+    off_t size;
+    unsigned char *data;
+    off_t data_size;
+};
+
+/* 
+ * Mapped archive with its member table, kept as long as the archive doesn't
+ * change on disk
+ * */
+struct exar_archive_s {
+    char *path;
+    unsigned char *data;
+    int mapped;
+    dev_t dev;
+    ino_t ino;
+    off_t fsize;
+    time_t mtime;
+    struct exar_entry_s *entries;
+    struct exar_entry_s **by_base;
+    size_t n;
+};
+
 #define LOG(level, ...) do { if (s_verbose & EXAR_VERBOSE_L##level) { \
     fprintf(stderr, "exar-log%d: ", level); \
     fprintf(stderr, __VA_ARGS__); } } while(0)
@@ -78,6 +139,13 @@ static size_t s_offset;
 static FILE *s_out;
 static unsigned char s_verbose = 0;
 static const char *s_out_path;
+static struct exar_archive_s s_archives[MAX_CACHED_ARCHIVES];
+static size_t s_next_archive;
+static int s_compression = 0;
+static struct exar_member_s *s_members;
+static size_t s_n_members;
+static size_t s_next_member;
+static pthread_mutex_t s_member_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 static void *
 xcalloc(size_t nmemb, size_t size)
@@ -90,6 +158,23 @@ xcalloc(size_t nmemb, size_t size)
     }
     return ret;
 }
+static void *
+xrealloc(void *ptr, size_t size)
+{
+    void *ret = realloc(ptr, size);
+    if (ret == NULL)
+    {
+        fprintf(stderr, "Cannot realloc %zu bytes\n", size);
+        exit(EXIT_FAILURE);
+    }
+    return ret;
+}
+static char *
+xstrdup(const char *str)
+{
+    size_t l = strlen(str) + 1;
+    return memcpy(xcalloc(l, 1), str, l);
+}
 
 static size_t 
 get_offset(char *buffer, size_t n, const char *path, int *end)
@@ -187,13 +272,13 @@ static int
 check_header(struct exar_header_s *head, const char *size) {
     char *endptr;
     off_t fs;
-    if (head->eh_flag != DIR_FLAG && head->eh_flag != FILE_FLAG)
+    if (head->eh_flag != DIR_FLAG && !HAS_DATA(head->eh_flag))
     {
         LOG(1, "No file flag found\n");
         fprintf(stderr, "The archive seems to be corrupted\n");
         return EE_ERROR;
     }
-    if (head->eh_flag == FILE_FLAG)
+    if (HAS_DATA(head->eh_flag))
     {
         fs = strtol(size, &endptr, 16);
         if (*endptr)
@@ -288,6 +373,7 @@ get_file_header_from_data(const unsigned char *data, int *offset, struct exar_he
         LOG(1, "The archive seems to be corrupted\n");
         return EE_ERROR;
     }
+    head->eh_name[i] = '\0';
     *offset += i+1;
 
     LOG(2, "Found file header (%s, %c, %jd)\n", head->eh_name, head->eh_flag, (intmax_t)head->eh_size);
@@ -298,7 +384,7 @@ next_file(FILE *f, struct exar_header_s *header)
 {
     if (*(header->eh_name))
     {
-        if (header->eh_flag == FILE_FLAG)
+        if (HAS_DATA(header->eh_flag))
         {
             if (fseek(f, header->eh_size, SEEK_CUR) != 0)
                 return EE_ERROR;
@@ -308,80 +394,646 @@ next_file(FILE *f, struct exar_header_s *header)
     }
     return get_file_header(f, header);
 }
+static const char *
+base_name(const char *name)
+{
+    const char *slash = strrchr(name, '/');
+    return slash == NULL ? name : slash + 1;
+}
 static int 
 find_cmp(const char *name, const char *search)
 {
-    char buffer[EXAR_NAME_MAX] = {0};
     if (strcmp(name, search) != 0)
+        return strcmp(base_name(name), search);
+    return 0;
+}
+static int 
+is_index(const struct exar_header_s *head)
+{
+    return head->eh_flag == FILE_FLAG && strcmp(head->eh_name, EXAR_INDEX_NAME) == 0;
+}
+
+static int 
+write_file_header(FILE *f, const char *name, char flag, off_t r)
+{
+    unsigned char version[SZ_VERSION] = {0};
+    char buffer[HDR_NAME] = {0};
+    size_t l_name; 
+    char term = 0;
+
+    l_name = strlen(name);
+    if (l_name > EXAR_NAME_MAX)
     {
-        size_t offset = get_offset(buffer, EXAR_NAME_MAX, name, NULL);
-        return strcmp(&name[offset], search);
+        fprintf(stderr, "Filename too long\n");
+        return EE_ERROR;
     }
-    return 0;
+
+    LOG(2, "Writing version header (%s)\n", EXAR_VERSION);
+
+    memcpy(version, EXAR_VERSION, sizeof(version));
+    if (fwrite(version, 1, sizeof(version), f) != sizeof(version))
+    {
+        fprintf(stderr, "Failed to write %zu bytes", sizeof(version));
+        return EE_ERROR;
+    }
+
+    LOG(2, "Writing file header for %s\n", name);
+
+    memset(buffer, 0, sizeof(buffer));
+    buffer[HDR_DFLAG] = flag;
+    snprintf(buffer + HDR_SIZE, SZ_SIZE, "%.13x", HAS_DATA(flag) ? (unsigned int)r : 0);
+    if (fwrite(buffer, 1, HDR_NAME, f) != HDR_NAME)
+        return EE_ERROR;
+    if (fwrite(name, 1, l_name, f) != l_name)
+        return EE_ERROR;
+    if (fwrite(&term, 1, 1, f) != 1)
+        return EE_ERROR;
+
+    return EE_OK;
 }
+/*
+ * Index {{{
+ * */
 static int 
-contains(const char *archive, const char *name, int (*cmp)(const char *, const char *))
+parse_hex(const char *field, off_t *value)
+{
+    char *endptr;
+    if (field[SZ_SIZE-1] != '\0')
+        return EE_ERROR;
+    *value = strtoll(field, &endptr, 16);
+    if (*endptr || *value < 0)
+        return EE_ERROR;
+    return EE_OK;
+}
+/* 
+ * Writes a 13 digit hex number, fields are limited to 52 bit
+ * */
+static void 
+write_hex(char *field, uintmax_t value)
+{
+    snprintf(field, SZ_SIZE, "%.13jx", value & (uintmax_t)0xfffffffffffffULL);
+}
+static void 
+add_entry(struct exar_entry_s **entries, size_t *n, const char *name, unsigned char flag, off_t offset, off_t size)
+{
+    struct exar_entry_s *entry;
+    if ((*n & (*n - 1)) == 0)
+        *entries = xrealloc(*entries, (*n == 0 ? 1 : 2 * *n) * sizeof(struct exar_entry_s));
+    entry = &(*entries)[*n];
+    entry->name = xstrdup(name);
+    entry->base = base_name(entry->name);
+    entry->flag = flag;
+    entry->offset = offset;
+    entry->size = size;
+    entry->order = *n;
+    entry->inflated = NULL;
+    entry->inflated_size = 0;
+    (*n)++;
+}
+static void 
+free_entries(struct exar_entry_s *entries, size_t n)
+{
+    for (size_t i=0; i<n; i++)
+    {
+        free(entries[i].name);
+        free(entries[i].inflated);
+    }
+    free(entries);
+}
+/*
+ * Reads all member headers sequentially, used for archives without index
+ * */
+static int 
+scan_entries(FILE *f, struct exar_entry_s **entries, size_t *n)
 {
-    FILE *f = NULL;
     struct exar_header_s header = EXAR_HEADER_EMPTY;
-    int result = EE_ERROR;
+    int status;
 
-    if ((f = open_archive(archive, "r")) == NULL)
+    LOG(2, "Scanning archive\n");
+    rewind(f);
+    while ((status = get_file_header(f, &header)) == EE_OK)
+    {
+        if (!is_index(&header))
+            add_entry(entries, n, header.eh_name, header.eh_flag, ftello(f), header.eh_size);
+        if (HAS_DATA(header.eh_flag) && fseeko(f, header.eh_size, SEEK_CUR) != 0)
+            return EE_ERROR;
+    }
+    return status == EE_EOF ? EE_OK : EE_ERROR;
+}
+/*
+ * Checks the footer at the end of the archive, on success idx_offset is set to
+ * the offset of the index header
+ * */
+static int 
+read_footer(FILE *f, off_t fsize, off_t *idx_offset, off_t *count)
+{
+    char footer[SZ_FOOTER];
+
+    if (fsize < SZ_FOOTER || fseeko(f, fsize - SZ_FOOTER, SEEK_SET) != 0)
+        return EE_ERROR;
+    if (fread(footer, 1, SZ_FOOTER, f) != SZ_FOOTER)
+        return EE_ERROR;
+    if (memcmp(footer, EXAR_INDEX_MAGIC, SZ_MAGIC))
+        return EE_ERROR;
+    if (parse_hex(footer + SZ_MAGIC, idx_offset) != EE_OK 
+            || parse_hex(footer + SZ_MAGIC + SZ_SIZE, count) != EE_OK)
+        return EE_ERROR;
+    return *idx_offset < fsize ? EE_OK : EE_ERROR;
+}
+static int 
+read_index(FILE *f, off_t fsize, struct exar_entry_s **entries, size_t *n)
+{
+    struct exar_header_s header = EXAR_HEADER_EMPTY;
+    off_t idx_offset, count, offset, size, length;
+    char *data = NULL, *tmp, *end;
+    int ret = EE_ERROR;
+
+    if (read_footer(f, fsize, &idx_offset, &count) != EE_OK)
+        return EE_ERROR;
+
+    LOG(2, "Reading index\n");
+    if (fseeko(f, idx_offset, SEEK_SET) != 0 || get_file_header(f, &header) != EE_OK || !is_index(&header))
+        return EE_ERROR;
+    if (ftello(f) + header.eh_size != fsize || header.eh_size < SZ_FOOTER)
+        return EE_ERROR;
+
+    length = header.eh_size - SZ_FOOTER;
+    data = xcalloc(length + 1, 1);
+    if (fread(data, 1, length, f) != (size_t)length)
         goto finish;
-    while (next_file(f, &header) == EE_OK)
+
+    for (tmp = data, end = data + length; count > 0; count--)
+    {
+        if (end - tmp <= SZ_ENTRY 
+                || parse_hex(tmp + SZ_DFLAG, &offset) != EE_OK 
+                || parse_hex(tmp + SZ_DFLAG + SZ_SIZE, &size) != EE_OK
+                || offset + size > idx_offset)
+            goto finish;
+        add_entry(entries, n, tmp + SZ_ENTRY, tmp[HDR_DFLAG], offset, size);
+        tmp += SZ_ENTRY + strlen(tmp + SZ_ENTRY) + 1;
+    }
+    if (tmp == end)
+        ret = EE_OK;
+finish:
+    if (ret != EE_OK)
+    {
+        LOG(1, "Invalid index, falling back to sequential scan\n");
+        free_entries(*entries, *n);
+        *entries = NULL;
+        *n = 0;
+    }
+    free(data);
+    return ret;
+}
+/*
+ * Removes a trailing index, so that members can be appended
+ * */
+static void 
+strip_index(const char *archive)
+{
+    FILE *f;
+    struct stat st;
+    off_t idx_offset, count;
+
+    if (stat(archive, &st) != 0 || (f = fopen(archive, "r")) == NULL)
+        return;
+    if (read_footer(f, st.st_size, &idx_offset, &count) == EE_OK)
     {
-        if (cmp(header.eh_name, name) == 0)
+        LOG(2, "Removing index from %s\n", archive);
+        if (truncate(archive, idx_offset) != 0)
+            perror(archive);
+    }
+    fclose(f);
+}
+/*
+ * Appends an index of all members to the archive
+ * */
+static int 
+write_index(const char *archive)
+{
+    FILE *f = NULL;
+    struct exar_entry_s *entries = NULL;
+    size_t n = 0, length = SZ_FOOTER;
+    char *data = NULL, *tmp;
+    off_t idx_offset;
+    int ret = EE_ERROR;
+
+    if ((f = open_archive(archive, "r+")) == NULL)
+        return EE_ERROR;
+    if (scan_entries(f, &entries, &n) != EE_OK)
+        goto finish;
+
+    for (size_t i=0; i<n; i++)
+        length += SZ_ENTRY + strlen(entries[i].name) + 1;
+
+    data = tmp = xcalloc(length, 1);
+    for (size_t i=0; i<n; i++)
+    {
+        tmp[HDR_DFLAG] = entries[i].flag;
+        write_hex(tmp + SZ_DFLAG, entries[i].offset);
+        write_hex(tmp + SZ_DFLAG + SZ_SIZE, entries[i].size);
+        strcpy(tmp + SZ_ENTRY, entries[i].name);
+        tmp += SZ_ENTRY + strlen(entries[i].name) + 1;
+    }
+
+    if (fseeko(f, 0, SEEK_END) != 0 || (idx_offset = ftello(f)) == -1)
+        goto finish;
+    memcpy(tmp, EXAR_INDEX_MAGIC, SZ_MAGIC);
+    write_hex(tmp + SZ_MAGIC, idx_offset);
+    write_hex(tmp + SZ_MAGIC + SZ_SIZE, n);
+
+    LOG(2, "Writing index (%zu entries)\n", n);
+    if (write_file_header(f, EXAR_INDEX_NAME, FILE_FLAG, length) != EE_OK 
+            || fwrite(data, 1, length, f) != length)
+    {
+        fprintf(stderr, "Failed to write index\n");
+        goto finish;
+    }
+    ret = EE_OK;
+finish:
+    free(data);
+    free_entries(entries, n);
+    close_file(f, archive);
+    return ret;
+}/*}}}*/
+
+/*
+ * Compression {{{
+ *
+ * Content of compressed members starts with the uncompressed size followed by
+ * a zlib stream.
+ * */
+static unsigned char *
+inflate_member(const unsigned char *data, off_t size, off_t *out_size)
+{
+    unsigned char *ret;
+    off_t isize;
+    uLongf length;
+
+    if (size < SZ_SIZE || parse_hex((const char *)data, &isize) != EE_OK)
+        return NULL;
+
+    ret = xcalloc(isize + 1, sizeof(unsigned char));
+    length = isize;
+    if (uncompress(ret, &length, data + SZ_SIZE, size - SZ_SIZE) != Z_OK || (off_t)length != isize)
+    {
+        free(ret);
+        return NULL;
+    }
+    if (out_size != NULL)
+        *out_size = isize;
+    return ret;
+}
+/*
+ * Reads a file and compresses it, the file is stored uncompressed if
+ * compression doesn't reduce its size
+ * */
+static void 
+compress_member(struct exar_member_s *m)
+{
+    FILE *f;
+    unsigned char *data, *zdata;
+    uLongf length;
+
+    if (m->flag != FILE_FLAG)
+        return;
+
+    LOG(3, "Opening %s for reading\n", m->path);
+    if ((f = fopen(m->path, "r")) == NULL)
+    {
+        perror(m->path);
+        m->flag = 0;
+        return;
+    }
+    data = xcalloc(m->size + 1, sizeof(unsigned char));
+    if (fread(data, 1, m->size, f) != (size_t)m->size)
+    {
+        fprintf(stderr, "Failed to read %s\n", m->path);
+        free(data);
+        m->flag = 0;
+        fclose(f);
+        return;
+    }
+    fclose(f);
+
+    length = compressBound(m->size);
+    zdata = xcalloc(SZ_SIZE + length, sizeof(unsigned char));
+    write_hex((char *)zdata, m->size);
+    if (compress2(zdata + SZ_SIZE, &length, data, m->size, s_compression) == Z_OK && SZ_SIZE + (off_t)length < m->size)
+    {
+        LOG(2, "Compressed %s (%jd to %jd bytes)\n", m->name, (intmax_t)m->size, (intmax_t)(SZ_SIZE + length));
+        free(data);
+        m->flag = ZFILE_FLAG;
+        m->data = zdata;
+        m->data_size = SZ_SIZE + length;
+    }
+    else 
+    {
+        free(zdata);
+        m->data = data;
+        m->data_size = m->size;
+    }
+}
+static void *
+compress_worker(void *data)
+{
+    (void)data;
+    size_t i;
+    while (1)
+    {
+        pthread_mutex_lock(&s_member_mutex);
+        i = s_next_member++;
+        pthread_mutex_unlock(&s_member_mutex);
+        if (i >= s_n_members)
+            break;
+        compress_member(&s_members[i]);
+    }
+    return NULL;
+}
+/*
+ * Compresses all collected members, files are distributed over up to
+ * MAX_PACK_THREADS threads
+ * */
+static void 
+compress_members(void)
+{
+    pthread_t threads[MAX_PACK_THREADS];
+    long n_threads = sysconf(_SC_NPROCESSORS_ONLN);
+    long started = 0;
+
+    n_threads = MIN(MIN(n_threads, MAX_PACK_THREADS), (long)s_n_members);
+    s_next_member = 0;
+
+    LOG(2, "Compressing %zu files using %ld threads\n", s_n_members, n_threads);
+    for (; started < n_threads; started++)
+    {
+        if (pthread_create(&threads[started], NULL, compress_worker, NULL) != 0)
+            break;
+    }
+    // compress remaining files if no thread could be started
+    compress_worker(NULL);
+    for (long i=0; i<started; i++)
+        pthread_join(threads[i], NULL);
+}/*}}}*/
+
+/*
+ * Archive cache {{{
+ * */
+static int 
+entry_cmp(const void *a, const void *b)
+{
+    const struct exar_entry_s *ea = a, *eb = b;
+    int ret = strcmp(ea->name, eb->name);
+    return ret != 0 ? ret : (ea->order > eb->order) - (ea->order < eb->order);
+}
+static int 
+base_cmp(const void *a, const void *b)
+{
+    const struct exar_entry_s *ea = *(struct exar_entry_s * const *)a, *eb = *(struct exar_entry_s * const *)b;
+    int ret = strcmp(ea->base, eb->base);
+    return ret != 0 ? ret : (ea->order > eb->order) - (ea->order < eb->order);
+}
+static int 
+name_key_cmp(const void *key, const void *elem)
+{
+    return strcmp(key, ((const struct exar_entry_s *)elem)->name);
+}
+static int 
+base_key_cmp(const void *key, const void *elem)
+{
+    return strcmp(key, (*(struct exar_entry_s * const *)elem)->base);
+}
+static void 
+archive_close(struct exar_archive_s *a)
+{
+    if (a->path != NULL)
+    {
+        LOG(3, "Unmapping %s\n", a->path);
+        if (a->mapped)
+            munmap(a->data, a->fsize);
+        else 
+            free(a->data);
+        free_entries(a->entries, a->n);
+        free(a->by_base);
+        free(a->path);
+        memset(a, 0, sizeof(struct exar_archive_s));
+    }
+}
+static void 
+archive_uncache(const char *archive)
+{
+    for (size_t i=0; i<MAX_CACHED_ARCHIVES; i++)
+    {
+        if (archive == NULL || (s_archives[i].path != NULL && strcmp(s_archives[i].path, archive) == 0))
+            archive_close(&s_archives[i]);
+    }
+}
+/*
+ * Maps the archive, if mapping fails the archive is read into memory
+ * */
+static int 
+archive_map(struct exar_archive_s *a, FILE *f, off_t size)
+{
+    a->data = mmap(NULL, size, PROT_READ, MAP_SHARED, fileno(f), 0);
+    if (a->data != MAP_FAILED)
+    {
+        a->mapped = 1;
+        return EE_OK;
+    }
+    LOG(1, "Cannot map archive, reading it into memory\n");
+    a->data = xcalloc(size + 1, 1);
+    a->mapped = 0;
+    rewind(f);
+    if (fread(a->data, 1, size, f) != (size_t)size)
+    {
+        exar_free(a->data);
+        return EE_ERROR;
+    }
+    return EE_OK;
+}
+/*
+ * Returns a mapped archive, the archive is only remapped if it has been
+ * modified since the last call
+ * */
+static struct exar_archive_s *
+archive_get(const char *archive)
+{
+    struct exar_archive_s *a = NULL;
+    struct stat st;
+    FILE *f;
+
+    if (stat(archive, &st) != 0)
+    {
+        perror(archive);
+        archive_uncache(archive);
+        return NULL;
+    }
+    for (size_t i=0; i<MAX_CACHED_ARCHIVES; i++)
+    {
+        a = &s_archives[i];
+        if (a->path != NULL && strcmp(a->path, archive) == 0)
         {
-            result = EE_OK;
+            if (a->dev == st.st_dev && a->ino == st.st_ino && a->fsize == st.st_size && a->mtime == st.st_mtime)
+                return a;
+            LOG(3, "%s has been modified\n", archive);
+            archive_close(a);
             break;
         }
+        a = NULL;
+    }
+    if (a == NULL)
+    {
+        a = &s_archives[s_next_archive];
+        s_next_archive = (s_next_archive + 1) % MAX_CACHED_ARCHIVES;
+        archive_close(a);
     }
 
-finish:
+    if ((f = open_archive(archive, "r")) == NULL)
+        return NULL;
+    if (check_version(f, 1) != EE_OK || 
+            (read_index(f, st.st_size, &a->entries, &a->n) != EE_OK 
+             && scan_entries(f, &a->entries, &a->n) != EE_OK) ||
+            archive_map(a, f, st.st_size) != EE_OK)
+    {
+        close_file(f, archive);
+        free_entries(a->entries, a->n);
+        memset(a, 0, sizeof(struct exar_archive_s));
+        return NULL;
+    }
     close_file(f, archive);
-    return result;
+
+    a->by_base = xcalloc(a->n + 1, sizeof(struct exar_entry_s *));
+    qsort(a->entries, a->n, sizeof(struct exar_entry_s), entry_cmp);
+    for (size_t i=0; i<a->n; i++)
+        a->by_base[a->entries[i].order] = &a->entries[i];
+    qsort(a->by_base, a->n, sizeof(struct exar_entry_s *), base_cmp);
+
+    a->path = xstrdup(archive);
+    a->dev = st.st_dev;
+    a->ino = st.st_ino;
+    a->fsize = st.st_size;
+    a->mtime = st.st_mtime;
+    return a;
 }
-static unsigned char *
-extract(const char *archive, const char *file, off_t *s, int (*cmp)(const char *, const char *))
+/*
+ * Finds the first member in archive order that matches the full path or, if
+ * search is set, the filename
+ * */
+static struct exar_entry_s *
+archive_lookup(struct exar_archive_s *a, const char *name, int search)
 {
-    struct exar_header_s header = EXAR_HEADER_EMPTY;
-    FILE *f = NULL;
-    unsigned char *ret = NULL;
+    struct exar_entry_s *found = NULL, *entry, **base;
+
+    if ((entry = bsearch(name, a->entries, a->n, sizeof(struct exar_entry_s), name_key_cmp)) != NULL)
+    {
+        while (entry > a->entries && strcmp((entry-1)->name, name) == 0)
+            entry--;
+        found = entry;
+    }
+    if (search && (base = bsearch(name, a->by_base, a->n, sizeof(struct exar_entry_s *), base_key_cmp)) != NULL)
+    {
+        while (base > a->by_base && strcmp((*(base-1))->base, name) == 0)
+            base--;
+        if (found == NULL || (*base)->order < found->order)
+            found = *base;
+    }
+    return found;
+}/*}}}*/
+
+static int 
+contains(const char *archive, const char *name, int search)
+{
+    struct exar_archive_s *a;
+
+    if ((a = archive_get(archive)) == NULL)
+        return EE_ERROR;
+    return archive_lookup(a, name, search) != NULL ? EE_OK : EE_ERROR;
+}
+/*
+ * Finds a regular file in the archive, data is set to the member's content
+ * in the mapped archive
+ * */
+static struct exar_entry_s *
+find_file(const char *archive, const char *file, int search, const unsigned char **data)
+{
+    struct exar_archive_s *a;
+    struct exar_entry_s *entry;
+
+    if ((a = archive_get(archive)) == NULL)
+        return NULL;
+    if ((entry = archive_lookup(a, file, search)) == NULL)
+    {
+        fprintf(stderr, "File %s was not found in %s\n", file, archive);
+        return NULL;
+    }
+    if (!HAS_DATA(entry->flag))
+    {
+        fprintf(stderr, "%s is a directory, only regular files can be extracted\n", file);
+        return NULL;
+    }
+    if (entry->offset + entry->size > a->fsize)
+    {
+        fprintf(stderr, "Failed to read %s\n", entry->name);
+        return NULL;
+    }
+    *data = a->data + entry->offset;
+    return entry;
+}
+/*
+ * Returns a pointer to the member's content in the mapped archive, compressed
+ * members are inflated once and kept with the archive
+ * */
+static const unsigned char *
+view(const char *archive, const char *file, off_t *s, int search)
+{
+    struct exar_entry_s *entry;
+    const unsigned char *data;
     if (s != NULL)
         *s = -1;
 
-    if ((f = open_archive(archive, "r")) == NULL)
-        goto finish;
-    while (get_file_header(f, &header) == EE_OK)
+    if ((entry = find_file(archive, file, search, &data)) == NULL)
+        return NULL;
+    if (entry->flag == ZFILE_FLAG)
     {
-        if (cmp(header.eh_name, file) == 0)
+        if (entry->inflated == NULL && 
+                (entry->inflated = inflate_member(data, entry->size, &entry->inflated_size)) == NULL)
         {
-            if (header.eh_flag == FILE_FLAG)
-            {
-                ret = xcalloc(header.eh_size, sizeof(unsigned char));
-                LOG(3, "Reading %s\n", header.eh_name);
-                if (fread(ret, 1, header.eh_size, f) != (size_t)header.eh_size)
-                {
-                    fprintf(stderr, "Failed to read %s\n", header.eh_name);
-                    exar_free(ret);
-                }
-                else if (s != NULL)
-                    *s = header.eh_size;
-            }
-            else {
-                fprintf(stderr, "%s is a directory, only regular files can be extracted\n", file);
-            }
-            goto finish;
-        }
-        else if (header.eh_flag == FILE_FLAG)
-        {
-            LOG(3, "Skipping %s\n", header.eh_name);
-            fseek(f, header.eh_size, SEEK_CUR);
+            fprintf(stderr, "Failed to inflate %s\n", entry->name);
+            return NULL;
         }
+        data = entry->inflated;
+        if (s != NULL)
+            *s = entry->inflated_size;
+    }
+    else if (s != NULL)
+        *s = entry->size;
+    return data;
+}
+static unsigned char *
+extract(const char *archive, const char *file, off_t *s, int search)
+{
+    struct exar_entry_s *entry;
+    const unsigned char *data;
+    unsigned char *ret = NULL;
+    if (s != NULL)
+        *s = -1;
+
+    if ((entry = find_file(archive, file, search, &data)) == NULL)
+        return NULL;
+
+    LOG(3, "Reading %s\n", file);
+    if (entry->flag == ZFILE_FLAG)
+    {
+        if ((ret = inflate_member(data, entry->size, s)) == NULL)
+            fprintf(stderr, "Failed to inflate %s\n", entry->name);
+    }
+    else 
+    {
+        ret = xcalloc(entry->size + 1, sizeof(unsigned char));
+        memcpy(ret, data, entry->size);
+        if (s != NULL)
+            *s = entry->size;
     }
-    fprintf(stderr, "File %s was not found in %s\n", file, archive);
-finish:
-    close_file(f, archive);
     return ret;
 }
 static unsigned char *
@@ -396,9 +1048,17 @@ extract_from_data(const unsigned char *data, const char *file, off_t *s, int (*c
 
     while((get_file_header_from_data(data, &offset, &header) == EE_OK)) {
         data += offset;
+        // the index is the last member
+        if (is_index(&header))
+            break;
         if (cmp(header.eh_name, file) == 0) {
-            if (header.eh_flag == FILE_FLAG) {
-                ret = xcalloc(header.eh_size, sizeof(unsigned char));
+            if (header.eh_flag == ZFILE_FLAG) {
+                if ((ret = inflate_member(data, header.eh_size, s)) == NULL)
+                    fprintf(stderr, "Failed to inflate %s\n", file);
+                return ret;
+            }
+            else if (header.eh_flag == FILE_FLAG) {
+                ret = xcalloc(header.eh_size + 1, sizeof(unsigned char));
                 memcpy(ret, data, header.eh_size);
                 if (s != NULL) {
                     *s = header.eh_size;
@@ -416,45 +1076,6 @@ extract_from_data(const unsigned char *data, const char *file, off_t *s, int (*c
     return NULL;
 }
 
-static int 
-write_file_header(FILE *f, const char *name, char flag, off_t r)
-{
-    unsigned char version[SZ_VERSION] = {0};
-    char buffer[HDR_NAME] = {0};
-    size_t l_name; 
-    char term = 0;
-
-    l_name = strlen(name);
-    if (l_name > EXAR_NAME_MAX)
-    {
-        fprintf(stderr, "Filename too long\n");
-        return EE_ERROR;
-    }
-
-    LOG(2, "Writing version header (%s)\n", EXAR_VERSION);
-
-    memcpy(version, EXAR_VERSION, sizeof(version));
-    if (fwrite(version, 1, sizeof(version), f) != sizeof(version))
-    {
-        fprintf(stderr, "Failed to write %zu bytes", sizeof(version));
-        return EE_ERROR;
-    }
-
-    LOG(2, "Writing file header for %s\n", name);
-
-    memset(buffer, 0, sizeof(buffer));
-    buffer[HDR_DFLAG] = flag;
-    snprintf(buffer + HDR_SIZE, SZ_SIZE, "%.13x", flag == FILE_FLAG ? (unsigned int)r : 0);
-    if (fwrite(buffer, 1, HDR_NAME, f) != HDR_NAME)
-        return EE_ERROR;
-    if (fwrite(name, 1, l_name, f) != l_name)
-        return EE_ERROR;
-    if (fwrite(&term, 1, 1, f) != 1)
-        return EE_ERROR;
-
-    return EE_OK;
-}
-
 const char *
 strip_current(const char *path) {
     const char *cstrip = path;
@@ -466,6 +1087,59 @@ strip_current(const char *path) {
     return cstrip;
 }
 
+static void 
+add_member(const char *path, const char *name, unsigned char flag, off_t size)
+{
+    struct exar_member_s *m;
+    if ((s_n_members & (s_n_members - 1)) == 0)
+        s_members = xrealloc(s_members, (s_n_members == 0 ? 1 : 2 * s_n_members) * sizeof(struct exar_member_s));
+    m = &s_members[s_n_members++];
+    m->path = xstrdup(path);
+    m->name = xstrdup(name);
+    m->flag = flag;
+    m->size = size;
+    m->data = NULL;
+    m->data_size = 0;
+}
+static void 
+free_members(void)
+{
+    for (size_t i=0; i<s_n_members; i++)
+    {
+        free(s_members[i].path);
+        free(s_members[i].name);
+        free(s_members[i].data);
+    }
+    free(s_members);
+    s_members = NULL;
+    s_n_members = 0;
+}
+/*
+ * Writes collected members in the order they were found
+ * */
+static int 
+write_members(void)
+{
+    struct exar_member_s *m;
+    for (size_t i=0; i<s_n_members; i++)
+    {
+        m = &s_members[i];
+        if (m->flag == 0)
+            continue;
+        if (write_file_header(s_out, m->name, m->flag, m->data_size) != EE_OK)
+            return EE_ERROR;
+        if (m->data_size > 0)
+        {
+            LOG(2, "Writing %s (%jd bytes)\n", m->name, (intmax_t)m->data_size);
+            if (fwrite(m->data, 1, m->data_size, s_out) != (size_t)m->data_size)
+            {
+                fprintf(stderr, "Failed to write %jd bytes", (intmax_t)m->data_size);
+                return EE_ERROR;
+            }
+        }
+    }
+    return EE_OK;
+}
 static int
 ftw_pack(const char *fpath, const struct stat *st, int tf)
 {
@@ -511,8 +1185,20 @@ ftw_pack(const char *fpath, const struct stat *st, int tf)
         flag = DIR_FLAG;
     }
     else if (S_ISREG(st->st_mode))
-    {
         flag = FILE_FLAG;
+    else 
+    {
+        LOG(1, "Only directories and regular files will be packed, ignoring %s\n", fpath);
+        return 0;
+    }
+
+    if (s_compression != 0)
+    {
+        add_member(fpath, stripped, flag, st->st_size);
+        return 0;
+    }
+    if (flag == FILE_FLAG)
+    {
         LOG(3, "Opening %s for reading\n", fpath);
         f = fopen(fpath, "r");
         if (f == NULL)
@@ -521,11 +1207,6 @@ ftw_pack(const char *fpath, const struct stat *st, int tf)
             return 0;
         }
     }
-    else 
-    {
-        LOG(1, "Only directories and regular files will be packed, ignoring %s\n", fpath);
-        return 0;
-    }
 
     if (write_file_header(s_out, stripped, flag, st->st_size) != 0) 
         goto finish;
@@ -552,6 +1233,10 @@ pack (const char *archive, const char *path, const char *mode)
 {
     int ret = EE_OK;
 
+    archive_uncache(archive);
+    if (*mode == 'a')
+        strip_index(archive);
+
     LOG(3, "Opening %s for writing\n", archive);
     if ((s_out = fopen(archive, mode)) == NULL)
     {
@@ -561,12 +1246,21 @@ pack (const char *archive, const char *path, const char *mode)
     s_out_path = archive;
 
     ret = ftw(path, ftw_pack, MAX_FILE_HANDLES);
+    if (ret == 0 && s_compression != 0)
+    {
+        compress_members();
+        ret = write_members();
+    }
+    free_members();
 
     LOG(3, "Closing %s\n", archive);
 
     fclose(s_out);
     s_out_path = NULL;
 
+    if (ret == 0)
+        ret = write_index(archive);
+
     return ret;
 }
 
@@ -604,6 +1298,44 @@ exar_append(const char *archive, const char *path)
     return pack(archive, path, "a");
 }
 
+static int 
+unpack_compressed(FILE *f, struct exar_header_s *header)
+{
+    unsigned char *data, *content = NULL;
+    off_t size;
+    FILE *of = NULL;
+    int ret = EE_ERROR;
+
+    data = xcalloc(header->eh_size + 1, sizeof(unsigned char));
+    if (fread(data, 1, header->eh_size, f) != (size_t)header->eh_size)
+    {
+        fprintf(stderr, "Failed to read %s\n", header->eh_name);
+        goto finish;
+    }
+    if ((content = inflate_member(data, header->eh_size, &size)) == NULL)
+    {
+        fprintf(stderr, "Failed to inflate %s\n", header->eh_name);
+        goto finish;
+    }
+    LOG(3, "Opening %s for writing\n", header->eh_name);
+    if ((of = fopen(header->eh_name, "w")) == NULL)
+    {
+        perror(header->eh_name);
+        goto finish;
+    }
+    LOG(2, "Writing %s (%jd bytes)\n", header->eh_name, (intmax_t)size);
+    if (fwrite(content, 1, size, of) != (size_t)size)
+    {
+        fprintf(stderr, "Failed to write %jd bytes\n", (intmax_t)size);
+        goto finish;
+    }
+    ret = EE_OK;
+finish:
+    close_file(of, header->eh_name);
+    free(content);
+    free(data);
+    return ret;
+}
 int 
 exar_unpack(const char *archive, const char *dest)
 {
@@ -637,7 +1369,13 @@ exar_unpack(const char *archive, const char *dest)
         else if (status == EE_ERROR)
             goto finish;
 
-        if (header.eh_flag == DIR_FLAG) 
+        if (is_index(&header))
+        {
+            LOG(3, "Skipping index\n");
+            if (fseeko(f, header.eh_size, SEEK_CUR) != 0)
+                goto finish;
+        }
+        else if (header.eh_flag == DIR_FLAG) 
         {
             LOG(1, "Creating directory %s\n", header.eh_name);
             if (mkdir(header.eh_name, 0755) != 0 && errno != EEXIST) 
@@ -646,6 +1384,12 @@ exar_unpack(const char *archive, const char *dest)
                 goto finish;
             }
         }
+        else if (header.eh_flag == ZFILE_FLAG)
+        {
+            LOG(1, "Unpacking %s\n", header.eh_name);
+            if (unpack_compressed(f, &header) != EE_OK)
+                goto finish;
+        }
         else 
         {
             LOG(1, "Unpacking %s\n", header.eh_name);
@@ -685,14 +1429,28 @@ exar_extract(const char *archive, const char *file, off_t *s)
 {
     assert(archive != NULL && file != NULL);
 
-    return extract(archive, file, s, strcmp);
+    return extract(archive, file, s, 0);
 }
 unsigned char * 
 exar_search_extract(const char *archive, const char *file, off_t *s)
 {
     assert(archive != NULL && file != NULL);
 
-    return extract(archive, file, s, find_cmp);
+    return extract(archive, file, s, 1);
+}
+const unsigned char * 
+exar_view(const char *archive, const char *file, off_t *s)
+{
+    assert(archive != NULL && file != NULL);
+
+    return view(archive, file, s, 0);
+}
+const unsigned char * 
+exar_search_view(const char *archive, const char *file, off_t *s)
+{
+    assert(archive != NULL && file != NULL);
+
+    return view(archive, file, s, 1);
 }
 unsigned char * 
 exar_extract_from_data(const unsigned char *data, const char *file, off_t *s)
@@ -739,9 +1497,11 @@ exar_delete(const char *archive, const char *file)
 
     while ((status = get_file_header(f, &header)) == EE_OK)
     {
-        if (strcmp(header.eh_name, file) == 0)
+        if (is_index(&header))
+            fseek(f, header.eh_size, SEEK_CUR);
+        else if (strcmp(header.eh_name, file) == 0)
         {
-            if (header.eh_flag == FILE_FLAG)
+            if (HAS_DATA(header.eh_flag))
             {
                 LOG(1, "Skipping %s\n", header.eh_name);
                 fseek(f, header.eh_size, SEEK_CUR);
@@ -751,7 +1511,7 @@ exar_delete(const char *archive, const char *file)
         }
         else if (*dir_name && strncmp(dir_name, header.eh_name, dir_length) == 0)
         {
-            if (header.eh_flag == FILE_FLAG)
+            if (HAS_DATA(header.eh_flag))
             {
                 LOG(1, "Skipping %s\n", header.eh_name);
                 fseek(f, header.eh_size, SEEK_CUR);
@@ -761,7 +1521,7 @@ exar_delete(const char *archive, const char *file)
         {
             LOG(1, "Packing %s\n", header.eh_name);
             write_file_header(ftmp, header.eh_name, header.eh_flag, header.eh_size);
-            if (header.eh_flag == FILE_FLAG)
+            if (HAS_DATA(header.eh_flag))
             {
                 LOG(2, "Copying %s (%jd bytes)\n", header.eh_name, (intmax_t)header.eh_size);
                 for (off_t s=0; s<header.eh_size; s++)
@@ -791,6 +1551,9 @@ finish:
     }
     close_file(f, archive);
     close_file(ftmp, tmp_file);
+    archive_uncache(archive);
+    if (result == EE_OK)
+        result = write_index(archive);
     return result;
 }
 void 
@@ -804,7 +1567,8 @@ exar_info(const char *archive)
     if ((f = open_archive(archive, "r")) == NULL)
         goto finish;
     while(next_file(f, &header) == EE_OK)
-        fprintf(stdout, "%c %-14jd %s\n", header.eh_flag, (intmax_t)header.eh_size, header.eh_name);
+        if (!is_index(&header))
+            fprintf(stdout, "%c %-14jd %s\n", header.eh_flag, (intmax_t)header.eh_size, header.eh_name);
 finish:
     close_file(f, archive);
 }
@@ -813,14 +1577,14 @@ exar_contains(const char *archive, const char *name)
 {
     assert(archive != NULL);
 
-    return contains(archive, name, strcmp);
+    return contains(archive, name, 0);
 }
 int
 exar_search_contains(const char *archive, const char *name)
 {
     assert(archive != NULL);
 
-    return contains(archive, name, find_cmp);
+    return contains(archive, name, 1);
 }
 
 int
@@ -845,6 +1609,16 @@ exar_check_version_from_data(const unsigned char *data, size_t s)
     return version_cmp(data, 0) == EE_OK ? EE_OK : EE_ERROR;
 }
 void 
+exar_close(const char *archive)
+{
+    archive_uncache(archive);
+}
+void 
+exar_compression(int level)
+{
+    s_compression = level < -1 ? 0 : MIN(level, 9);
+}
+void 
 exar_verbose(const unsigned char v)
 {
     s_verbose = v & EXAR_VERBOSE_MASK;
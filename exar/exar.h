@@ -29,10 +29,26 @@
  *
  * file header    : - file info 22 bytes
  *                      - 7 bytes  version header, null terminated  (char)
- *                      - 1 byte   filetype flag (d|f)              (char)
+ *                      - 1 byte   filetype flag (d|f|z)            (char)
  *                      - 14 byte  file size, null terminated       (char, hex)
  *                  - file name, null terminated, maximum 4096 bytes
- * file           : saved as unsigned char
+ * file           : saved as unsigned char, compressed files (z) are stored as 
+ *                      - 14 byte  uncompressed size, null terminated (char, hex)
+ *                      - zlib stream
+ *
+ * The last member is an optional index, a regular file named .exar-index, so
+ * archives stay readable by older versions. Archives without index are
+ * scanned sequentially.
+ *
+ * index          : - one entry per member
+ *                      - 1 byte   filetype flag (d|f|z)            (char)
+ *                      - 14 byte  offset of the file, null terminated (char, hex)
+ *                      - 14 byte  file size, null terminated       (char, hex)
+ *                      - file name, null terminated
+ *                  - footer 36 bytes, last bytes of the archive
+ *                      - 8 bytes  magic "exidx-1", null terminated (char)
+ *                      - 14 byte  offset of the index header, null terminated (char, hex)
+ *                      - 14 byte  number of entries, null terminated (char, hex)
  * */
 
 #ifndef __EXAR_H__
@@ -83,8 +99,9 @@ exar_unpack(const char *path, const char *dest);
  * @file    The path of the file in the archive
  * @size    Return location for the size, if an error occurs size will be set to -1
  *
- * @returns A newly allocated char buffer with the file content or NULL if an error
- *          occured or the file was not found in the archive
+ * @returns A newly allocated, null terminated char buffer with the file
+ *          content or NULL if an error occured or the file was not found in the
+ *          archive
  * */
 unsigned char * 
 exar_extract(const char *archive, const char *file, off_t *size);
@@ -97,12 +114,45 @@ exar_extract(const char *archive, const char *file, off_t *size);
  *          the filename 
  * @size    Return location for the size, if an error occurs size will be set to -1
  *
- * @returns A newly allocated char buffer with the file content or NULL if an error
- *          occured or the file was not found in the archive
+ * @returns A newly allocated, null terminated char buffer with the file
+ *          content or NULL if an error occured or the file was not found in the
+ *          archive
  * */
 unsigned char * 
 exar_search_extract(const char *archive, const char *search, off_t *size);
 
+/* 
+ * Same as exar_extract but returns the content without copying it. The
+ * archive is mapped into memory, the returned data points into the mapping and
+ * must not be freed. It is not null terminated and stays valid until the
+ * archive is closed with exar_close or another function of the archive api
+ * finds that the archive has been modified.
+ *
+ * @archive The archive
+ * @file    The path of the file in the archive
+ * @size    Return location for the size, if an error occurs size will be set to -1
+ *
+ * @returns The file content or NULL if an error occured or the file was not
+ *          found in the archive
+ * */
+const unsigned char * 
+exar_view(const char *archive, const char *file, off_t *size);
+
+/* 
+ * Same as exar_search_extract but returns the content without copying it, see
+ * exar_view.
+ *
+ * @archive The archive
+ * @search  The search term. The search term must either match the full path or
+ *          the filename 
+ * @size    Return location for the size, if an error occurs size will be set to -1
+ *
+ * @returns The file content or NULL if an error occured or the file was not
+ *          found in the archive
+ * */
+const unsigned char * 
+exar_search_view(const char *archive, const char *search, off_t *size);
+
 /* 
  * Searches for a file and extracts the content from raw archive data. 
  * 
@@ -193,6 +243,30 @@ exar_contains(const char *archive, const char *path);
  * */
 int 
 exar_search_contains(const char *archive, const char *search);
+
+/*
+ * Archives are kept mapped between calls to exar_extract, exar_search_extract,
+ * exar_view, exar_search_view, exar_contains and exar_search_contains and
+ * remapped when they have been modified. Closes a cached archive, data
+ * returned by exar_view is no longer valid afterwards.
+ *
+ * @archive The archive or NULL to close all archives
+ * */
+void 
+exar_close(const char *archive);
+
+/*
+ * Sets the compression level used by exar_pack and exar_append. Files are
+ * compressed in parallel and only stored compressed if that reduces their size,
+ * compressed archives cannot be read by exar versions without compression
+ * support.
+ *
+ * @level 0 disables compression (default), -1 uses the default zlib level, 1
+ *        (fastest) to 9 (best compression)
+ * */
+void 
+exar_compression(int level);
+
 /*
  * Set verbosity flags, exar will be most verbose if all flags are set, log
  * messages are printed to stderr.
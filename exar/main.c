@@ -48,21 +48,22 @@ help(int ret)
             "   exar option [arguments]\n\n" 
            "OPTIONS:\n" 
            "    h                   Print this help and exit.\n"
-           "    a[v] archive file   Appends a file or directory to the archive\n"
+           "    a[vz] archive file  Appends a file or directory to the archive\n"
            "    d[v] archive file   Deletes a file from an archive, the file path is the\n"
            "                        relative file path of the file in the archive\n"
            "    e[v] archive file   Extracts a file from an archive and writes the content\n" 
            "                        to stdout, the archive is not modified, the file path \n"
            "                        is the relative file path of the file in the archive.\n"
            "    l[v] archive        List archive content\n"
-           "    p[v] path           Pack file or directory 'path'.\n"
+           "    p[vz] path          Pack file or directory 'path'.\n"
            "    s[v] archive file   Search for a file and write the content to stdout, the \n" 
            "                        archive is not modified, the filename is the basename\n" 
            "                        plus suffix of the file in the archive, all directory\n"
            "                        parts are stripped\n"
            "    u[v] file [dir]     Pack 'file' to directory 'dir' or to current directory.\n"
            "    v                   Verbose, pass multiple times (up to 3) to \n"
-           "                        get more verbose messages.\n\n"
+           "                        get more verbose messages.\n"
+           "    z                   Compress files when packing or appending.\n\n"
            "EXAMPLES:\n"
            "    exar p /tmp/foo          -- pack /tmp/foo to foo.exar\n"
            "    exar s foo.js > foo.js   -- Extract foo.js from the archive\n"
@@ -90,7 +91,7 @@ extract(const char *archive, const char *path,
 int 
 main (int argc, char **argv)
 {
-    int flag = 0;
+    int flag = 0, compress = 0;
     if (argc < 3)
     {
         help(EXIT_FAILURE);
@@ -124,6 +125,9 @@ main (int argc, char **argv)
             case 'v' : 
                 flag |= MAX(EXAR_FLAG_V, MIN(EXAR_VERBOSE_MASK, ((flag & EXAR_VERBOSE_MASK) << 1)));
                 break;
+            case 'z' : 
+                compress = 1;
+                break;
             case 'h' : 
                 help(EXIT_SUCCESS);
             default : 
@@ -133,6 +137,8 @@ main (int argc, char **argv)
     }
     if (flag & EXAR_VERBOSE_MASK)
         exar_verbose(flag);
+    if (compress)
+        exar_compression(-1);
 
     if (EXAR_CHECK_FLAG(flag, EXAR_FLAG_U))
         exar_unpack(argv[2], argv[3]);
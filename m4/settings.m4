@@ -177,6 +177,8 @@ html_input(enable-universal-access-from-file-uris, checkbox, Whether to allow fi
 html_input(enable-webgl, checkbox, Enable or disable webgl on pages)
 html_input(enable-xss-auditor, checkbox, Whether to enable the xss auditor)
 html_input(file-sync-interval, text, ``Interval to save files to hdd or 0 to directly write to hdd, see also sync-files'')
+html_input(hibernate-max-tabs, text, ``Maximum number of loaded tabs before idle background tabs are unloaded, 0 disables it'')
+html_input(hibernate-timeout, text, ``Seconds a background tab must be idle before its page is unloaded, 0 disables it'')
 html_input(history-length, text, Length of the browsing history)
 html_input(mouse-cycles-through-tabs, checkbox, Whether mouse wheel cycles through tabs)
 html_input(navigation-history-max, text, Length of the navigation history)
@@ -185,6 +187,7 @@ html_input(print-backgrounds, checkbox, Whether background images should be prin
 html_input(print-previewer, text, ``Program used for printing previews, %f will be replaced by the filename'')
 html_input(scheme-handler, text, ``Application, or script that handles uris with schemes that cannot be handled by dwb '')
 html_input(searchengine-submit-pattern, text, The pattern which will be replaced with the search terms)
+html_input(shared-files, checkbox, Share history and cookies with other instances)
 html_select(sync-files, html_options(all, cookies, history, session, cookies_history, cookies_session, history_session), ``Files to sync, see also file-sync-interval'')
 html_input(tab-key-cycles-through-elements, checkbox, Tab cycles through elements in insert mode)
 html_input(update-search-delay, text, Delay before updating search results in milliseconds)
@@ -18,6 +18,10 @@ Object.freeze((function () {
         positions : [],
         lastInput : null,
         lastPosition : 0,
+        labelled : null,
+        labelTrie : null,
+        textCache : {},
+        generation : 0,
         newTab : false,
         notify : null,
         hintTypes :  [ 
@@ -83,6 +87,9 @@ Object.freeze((function () {
         this.element = element;
         this.overlay = null;
         this.win = win;
+        this.text = null;
+        this.visible = true;
+        this.stamp = 0;
         var hint = p_createElement("div");
         var toppos = rect.top + oe.offY;
         var leftpos = rect.left + oe.offX;
@@ -163,7 +170,7 @@ Object.freeze((function () {
                 var e = globals.activeArr[i];
                 if (input && bestposition !== 0) 
                 {
-                    var content = e.element.textContent.toLowerCase().split(" ");
+                    var content = p_getText(e).split(" ");
                     for (cl=0; cl<content.length; cl++) 
                     {
                         if (content[cl].toLowerCase().indexOf(input) === 0) 
@@ -178,28 +185,8 @@ Object.freeze((function () {
                     }
                 }
             }
-            p_getTextHints(globals.activeArr);
             return ret;
         };
-        this.matchText = function(input, matchHint) 
-        {
-            var i;
-            if (matchHint) 
-            {
-                var regEx = new RegExp('^' + input);
-                return regEx.test(this.hint.textContent);
-            }
-            else 
-            {
-                var inArr = input.split(" ");
-                for (i=0; i<inArr.length; i++) 
-                {
-                    if (!this.element.textContent.toLowerCase().match(inArr[i].toLowerCase())) 
-                        return false;
-                }
-                return true;
-            }
-        };
     };
     var p_letterHint = function (element, win, rect, offsetElement) 
     {
@@ -209,27 +196,144 @@ Object.freeze((function () {
         this.betterMatch = function(input) {
             return 0;
         };
+    };
+    var p_getText = function (e) 
+    {
+        if (e.text === null) 
+            e.text = e.element.textContent.toLowerCase();
+        return e.text;
+    };
+    // Hints matching a text, every result is cached for the lifetime of the
+    // hint mode so that deleting characters is only a lookup. Appending a
+    // character can only narrow the result, so a new text is filtered from
+    // the result of its prefix
+    var p_filterText = function (text) 
+    {
+        var i, j, e, words, source, result;
+        var cache = globals.textCache;
+        if (cache[" " + text]) 
+            return cache[" " + text];
 
-        this.matchText = function(input, matchHint) 
+        source = cache[" " + text.substring(0, text.length-1)] || globals.elements;
+        words = text.toLowerCase().split(" ");
+        result = [];
+        for (i=0; i<source.length; i++) 
         {
-            var i;
-            if (matchHint) 
+            e = source[i];
+            for (j=0; j<words.length; j++) 
             {
-                return (this.hint.textContent.toLowerCase().indexOf(input.toLowerCase()) === 0);
+                if (p_getText(e).indexOf(words[j]) == -1) 
+                    break;
             }
-            else 
+            if (j == words.length) 
+                result.push(e);
+        }
+        cache[" " + text] = result;
+        return result;
+    };
+    // Every node of the trie holds the hints whose label starts with the
+    // path to the node, in hint order
+    var p_buildLabelTrie = function (arr) 
+    {
+        var i, j, label, node, c;
+        var root = { children : {}, hints : arr };
+        for (i=0; i<arr.length; i++) 
+        {
+            label = arr[i].hint.textContent.toLowerCase();
+            node = root;
+            for (j=0; j<label.length; j++) 
             {
-                var inArr = input.split(" ");
-                for (i=0; i<inArr.length; i++) 
-                {
-                    if (!this.element.textContent.toUpperCase().match(inArr[i].toUpperCase())) 
-                        return false;
-                }
-                return true;
+                c = label.charAt(j);
+                if (!node.children.hasOwnProperty(c)) 
+                    node.children[c] = { children : {}, hints : [] };
+                node = node.children[c];
+                node.hints.push(arr[i]);
             }
-        };
+        }
+        return root;
+    };
+    var p_lookupLabel = function (trie, label) 
+    {
+        var i, c;
+        var node = trie;
+        for (i=0; i<label.length && node; i++) 
+        {
+            c = label.charAt(i);
+            node = node.children.hasOwnProperty(c) ? node.children[c] : null;
+        }
+        return node ? node.hints : [];
+    };
+    var p_intersect = function (arr, set) 
+    {
+        var i;
+        var result = [];
+        var gen = ++globals.generation;
+        for (i=0; i<set.length; i++) 
+            set[i].stamp = gen;
+        for (i=0; i<arr.length; i++) 
+        {
+            if (arr[i].stamp === gen) 
+                result.push(arr[i]);
+        }
+        return result;
+    };
+    // Only hints that change their state are touched
+    var p_setVisible = function (arr) 
+    {
+        var i, e;
+        var gen = ++globals.generation;
+        for (i=0; i<arr.length; i++) 
+        {
+            e = arr[i];
+            e.stamp = gen;
+            if (!e.visible) 
+            {
+                e.hint.style.visibility = "";
+                e.visible = true;
+            }
+        }
+        for (i=0; i<globals.activeArr.length; i++) 
+        {
+            e = globals.activeArr[i];
+            if (e.stamp !== gen && e.visible) 
+            {
+                e.hint.style.visibility = "hidden";
+                e.visible = false;
+            }
+        }
+    };
+    // Splits the input into the text that is matched against the content
+    // of the elements and the label that is matched against the hints
+    var p_parseInput = function (input) 
+    {
+        var m;
+        var text = "", label = "", rest = null;
+        if (globals.matchHint != -1) 
+        {
+            rest = input.substring(globals.matchHint);
+            input = input.substring(0, globals.matchHint - 1);
+        }
+        if (globals.style == "number") 
+        {
+            text = (input.match(/[^0-9]+/g) || []).join("");
+            // number hints are relabelled after the text has changed, so
+            // only digits after the last text character refer to a label
+            m = input.match(/[0-9]+$/);
+            label = rest === null && m ? m[0] : "";
+        }
+        else if (globals.style == "letter") 
+        {
+            var lowerSeq = globals.letterSeq.toLowerCase();
+            text = (input.match(new RegExp("[^" + lowerSeq + "]", "g")) || []).join("");
+            label = (input.match(new RegExp("[" + lowerSeq + "]", "g")) || []).join("");
+        }
+        if (rest) 
+            text = text ? text + " " + rest : rest;
+
+        return { text : text, label : label };
     };
 
+
     var p_mouseEvent = function (e, ev) 
     {
         if (e.ownerDocument != document) 
@@ -409,20 +513,31 @@ Object.freeze((function () {
             var doc = win.document;
             var res = doc.body.querySelectorAll(globals.hintTypes[type]); 
             var e, r;
+            var visible = [], frames = [];
+            var vp = p_getViewport(win);
             p_createStyleSheet(doc);
             var hints = doc.createDocumentFragment();
             var oe = p_getOffsets(doc);
+            // Only read layout in this pass, most elements are culled by
+            // their geometry before any style has to be computed
             for (i=0;i < res.length; i++) 
             {
                 e = res[i];
-                if ((r = p_getVisibility(e, win)) === null) {
+                if ((r = p_getVisibility(e, win, vp)) === null) {
                     continue;
                 }
                 if ( (e instanceof HTMLFrameElement || e instanceof HTMLIFrameElement)) {
-                    p_createHints(e.contentWindow, varructor, type);
-                    continue;
+                    frames.push(e);
                 }
-                else if (e instanceof HTMLImageElement 
+                else {
+                    visible.push(e, r);
+                }
+            }
+            for (i=0; i<visible.length; i+=2) 
+            {
+                e = visible[i];
+                r = visible[i+1];
+                if (e instanceof HTMLImageElement 
                          && type != HintTypes.HINT_T_SELECTOR 
                          && type != HintTypes.HINT_T_IMAGES) {
                     if (e.hasAttribute("usemap")) 
@@ -433,6 +548,8 @@ Object.freeze((function () {
                 }
             }
             doc.body.appendChild(hints);
+            for (i=0; i<frames.length; i++) 
+                p_createHints(frames[i].contentWindow, varructor, type);
         }
         catch(exc) 
         {
@@ -478,26 +595,21 @@ Object.freeze((function () {
 
         p_getTextHints(globals.elements);
         globals.activeArr = globals.elements;
+        globals.labelled = globals.elements;
         p_setActive(globals.elements[0]);
         return null;
     };
     var p_updateHints = function(input, type) 
     {
-        var i;
-        var array = [];
-        var matchHint = false;
+        var array, parsed, textArr;
         if (!globals.activeArr.length) 
         {
             p_clear();
             p_showHints(type, globals.newTab);
         }
-        if (globals.lastInput && (globals.lastInput.length > input.length)) 
-        {
-            p_clear();
-            globals.lastInput = input;
-            p_showHints(type, globals.newTab);
-            return p_updateHints(input, type);
-        }
+        if (globals.matchHint != -1 && input.length < globals.matchHint) 
+            globals.matchHint = -1;
+
         globals.lastInput = input;
         if (input) 
         {
@@ -506,43 +618,31 @@ Object.freeze((function () {
                 globals.matchHint = input.indexOf(globals.escapeChar) + 1;
                 return null;
             }
-            if (globals.matchHint != -1)
-            {
-                input = input.substring(globals.matchHint);
-            }
-            else if (globals.style == "number") 
-            {
-                if (input[input.length-1].isInt()) 
-                {
-                    input = input.match(/[0-9]+/g).join("");
-                    matchHint = true;
-                }
-                else 
-                    input = input.match(/[^0-9]+/g).join("");
-            }
-            else if (globals.style == "letter") 
-            {
-                var lowerSeq = globals.letterSeq.toLowerCase();
-                if (input[input.length-1].isLower()) 
-                {
-                    if (lowerSeq.indexOf(input.charAt(input.length-1)) == -1) 
-                        return "_dwb_no_hints_";
-
-                    input = input.match(new RegExp("[" + lowerSeq + "]", "g")).join("");
-                    matchHint = true;
-                }
-                else  
-                    input = input.match(new RegExp("[^" + lowerSeq + "]", "g")).join("");
-            }
+            if (globals.matchHint == -1 && globals.style == "letter" && input[input.length-1].isLower() && 
+                    globals.letterSeq.toLowerCase().indexOf(input.charAt(input.length-1)) == -1)
+                return "_dwb_no_hints_";
         }
-        for (i=0; i<globals.activeArr.length; i++) 
+        parsed = p_parseInput(input);
+        textArr = p_filterText(parsed.text);
+        if (globals.style == "number" && globals.labelled !== textArr) 
+        {
+            p_getTextHints(textArr);
+            globals.labelled = textArr;
+            globals.labelTrie = null;
+        }
+        if (parsed.label) 
         {
-            var e = globals.activeArr[i];
-            if (e.matchText(input, matchHint)) 
-                array.push(e);
-            else
-                e.hint.style.visibility = 'hidden';
+            if (globals.labelTrie === null) 
+                globals.labelTrie = p_buildLabelTrie(globals.labelled);
+
+            array = p_lookupLabel(globals.labelTrie, parsed.label);
+            if (globals.labelled !== textArr) 
+                array = p_intersect(array, textArr);
         }
+        else 
+            array = textArr;
+
+        p_setVisible(array);
         globals.activeArr = array;
         if (array.length === 0) 
         {
@@ -555,23 +655,34 @@ Object.freeze((function () {
         }
         else 
         {
-            globals.lastPosition = array[0].betterMatch(input);
+            globals.lastPosition = array[0].betterMatch(parsed.label || parsed.text);
             p_setActive(array[globals.lastPosition]);
         }
         return null;
     };
-    var p_getVisibility = function (e, win) 
+    var p_getViewport = function (win) 
     {
-        var style = win.getComputedStyle(e, null);
-        if ((style.getPropertyValue("visibility") == "hidden" || style.getPropertyValue("display") == "none" ) ) 
+        return {
+            height : win.innerHeight || document.body.offsetHeight, 
+            width : win.innerWidth || document.body.offsetWidth
+        };
+    };
+    var p_getVisibility = function (e, win, vp) 
+    {
+        // Elements without a box or outside of the viewport are rejected
+        // without computing their style
+        var r = e.getClientRects()[0];
+        if (!r) 
             return null;
 
-        var r = e.getClientRects()[0] || e.getBoundingClientRect();
+        if (!vp) 
+            vp = p_getViewport(win);
 
-        var height = win.innerHeight || document.body.offsetHeight;
-        var width = win.innerWidth || document.body.offsetWidth;
+        if (r.top > vp.height || r.bottom < 0 || r.left > vp.width ||  r.right < 0) 
+            return null;
 
-        if (!r || r.top > height || r.bottom < 0 || r.left > width ||  r.right < 0 || !e.getClientRects()[0]) 
+        var style = win.getComputedStyle(e, null);
+        if ((style.getPropertyValue("visibility") == "hidden" || style.getPropertyValue("display") == "none" ) ) 
             return null;
 
         return r;
@@ -605,6 +716,9 @@ Object.freeze((function () {
         globals.active = null;
         globals.lastPosition = 0;
         globals.lastInput = null;
+        globals.labelled = null;
+        globals.labelTrie = null;
+        globals.textCache = {};
         globals.positions = [];
         globals.matchHint = -1;
         globals.actionElement = null;
@@ -540,7 +540,7 @@ adblock_load_status_cb(WebKitWebView *wv, GParamSpec *p, GList *gl)
 
 gboolean
 adblock_running() {
-  return s_init && GET_BOOL("adblocker");
+  return s_init && GET_BOOL(SETTINGS_ADBLOCKER);
 }
 
 /* adblock_disconnect(GList *) {{{*/
@@ -635,7 +635,7 @@ adblock_rule_parse(char *filterlist)
     char warning[256];
     int n_css_rules = 0;
     GString *css_rule = g_string_new(NULL);
-    gboolean eh_enabled = GET_BOOL("adblocker-element-hider");
+    gboolean eh_enabled = GET_BOOL(SETTINGS_ADBLOCKER_ELEMENT_HIDER);
 
     for (int i=0; lines[i] != NULL; i++) 
     {
@@ -968,10 +968,10 @@ adblock_init()
 {
     if (s_init)
         return true;
-    if (!GET_BOOL("adblocker"))
+    if (!GET_BOOL(SETTINGS_ADBLOCKER))
         return false;
 
-    char *filterlist = GET_CHAR("adblocker-filterlist");
+    char *filterlist = GET_CHAR(SETTINGS_ADBLOCKER_FILTERLIST);
     if (filterlist == NULL)
         return false;
 
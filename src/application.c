@@ -233,7 +233,7 @@ dwb_application_local_command_line(GApplication *app, gchar ***argv, gint *exit_
     dwb_init_files();
     dwb_init_settings();
 
-    single_instance = GET_BOOL("single-instance");
+    single_instance = GET_BOOL(SETTINGS_SINGLE_INSTANCE);
     if (!s_opt_fallback) {
         if (s_opt_single || !single_instance) 
             g_application_set_flags(app, G_APPLICATION_NON_UNIQUE);
@@ -343,7 +343,7 @@ dwb_application_local_command_line(GApplication *app, gchar ***argv, gint *exit_
             }
         }
     }
-    if (GET_BOOL("save-session") && !remote && !s_opt_single)
+    if (GET_BOOL(SETTINGS_SAVE_SESSION) && !remote && !s_opt_single)
         s_opt_force = true;
 
     application_start(app, *argv);
@@ -411,7 +411,7 @@ application_start(GApplication *app, char **argv)
     gtk_init(NULL, NULL);
     dwb_init();
 
-    dwb_pack(GET_CHAR("widget-packing"), false);
+    dwb_pack(GET_CHAR(SETTINGS_WIDGET_PACKING), false);
     scripts_init(s_opt_enable_scripts);
 
     if (s_opt_force) 
@@ -420,7 +420,7 @@ application_start(GApplication *app, char **argv)
     /* restore session */ 
     if (! s_opt_override_restore) 
     {
-        if (GET_BOOL("save-session") || s_opt_restore != NULL) 
+        if (GET_BOOL(SETTINGS_SAVE_SESSION) || s_opt_restore != NULL) 
             restored = session_restore(s_opt_restore, session_flags);
     }
     else 
@@ -21,6 +21,7 @@
 #include "completion.h"
 #include "commands.h"
 #include "entry.h"
+#include "js.h"
 #include "scripts.h"
 #include "util.h"
 #include "visual.h"
@@ -180,11 +181,12 @@ callback_key_press(GtkWidget *w, GdkEventKey *e)
          *      dwb from handling the signal.
          *
          * */
-        char *json = util_create_json(5, UINTEGER, "state", e->state, 
-                UINTEGER, "keyVal", e->keyval, UINTEGER, "keyCode", e->hardware_keycode,
-                BOOLEAN, "isModifier", e->is_modifier, CHAR, "name", gdk_keyval_name(e->keyval));
-        ScriptSignal signal = { SCRIPTS_WV(dwb.state.fview), SCRIPTS_SIG_META(json, KEY_PRESS, 0) };
-        SCRIPTS_EMIT_RETURN(signal, json, true);
+        JSObjectRef payload = scripts_create_payload(5, UINTEGER, JS_PROP_STATE, e->state, 
+                UINTEGER, JS_PROP_KEY_VAL, e->keyval, UINTEGER, JS_PROP_KEY_CODE, e->hardware_keycode,
+                BOOLEAN, JS_PROP_IS_MODIFIER, e->is_modifier, CHAR, JS_PROP_NAME, gdk_keyval_name(e->keyval));
+        ScriptSignal signal = { SCRIPTS_WV(dwb.state.fview), SCRIPTS_SIG_PAYLOAD(payload, KEY_PRESS, 0) };
+        if (scripts_emit(&signal))
+            return true;
     }
 
     if (entry_snooping())
@@ -278,11 +280,12 @@ callback_key_release(GtkWidget *w, GdkEventKey *e)
          *      dwb from handling the signal.
          *
          * */
-        char *json = util_create_json(5, UINTEGER, "state", e->state, 
-                UINTEGER, "keyVal", e->keyval, UINTEGER, "keyCode", e->hardware_keycode,
-                BOOLEAN, "isModifier", e->is_modifier, CHAR, "name", gdk_keyval_name(e->keyval));
-        ScriptSignal signal = { SCRIPTS_WV(dwb.state.fview), SCRIPTS_SIG_META(json, KEY_RELEASE, 0) };
-        SCRIPTS_EMIT_RETURN(signal, json, true);
+        JSObjectRef payload = scripts_create_payload(5, UINTEGER, JS_PROP_STATE, e->state, 
+                UINTEGER, JS_PROP_KEY_VAL, e->keyval, UINTEGER, JS_PROP_KEY_CODE, e->hardware_keycode,
+                BOOLEAN, JS_PROP_IS_MODIFIER, e->is_modifier, CHAR, JS_PROP_NAME, gdk_keyval_name(e->keyval));
+        ScriptSignal signal = { SCRIPTS_WV(dwb.state.fview), SCRIPTS_SIG_PAYLOAD(payload, KEY_RELEASE, 0) };
+        if (scripts_emit(&signal))
+            return true;
     }
     if (DWB_TAB_KEY(e)) 
         return true;
@@ -32,6 +32,7 @@
 #include "scripts.h"
 #include "editor.h"
 #include "dom.h"
+#include "domain.h"
 #include "application.h"
 #include "ipc.h"
 
@@ -75,13 +76,14 @@ commands_simple_command(KeyMap *km)
      * */
     if (EMIT_SCRIPT(EXECUTE_COMMAND))
     {
-        char *json = util_create_json(3,
-                CHAR, "command", km->map->n.first, 
-                CHAR, "argument", arg->p, 
-                INTEGER, "nummod", dwb.state.nummod);
-
-        ScriptSignal sig = { .jsobj = NULL, SCRIPTS_SIG_META(json, EXECUTE_COMMAND, 0) };
-        SCRIPTS_EMIT_RETURN(sig, json, STATUS_OK);
+        JSObjectRef payload = scripts_create_payload(3,
+                CHAR, JS_PROP_COMMAND, km->map->n.first, 
+                CHAR, JS_PROP_ARGUMENT, arg->p, 
+                INTEGER, JS_PROP_NUMMOD, dwb.state.nummod);
+
+        ScriptSignal sig = { .jsobj = NULL, SCRIPTS_SIG_PAYLOAD(payload, EXECUTE_COMMAND, 0) };
+        if (scripts_emit(&sig))
+            return STATUS_OK;
     }
     // Save last command for repeat
     if (km->map->func != (Func) commands_repeat && km != dwb.state.last_command.shortcut)
@@ -128,16 +130,16 @@ commands_simple_command(KeyMap *km)
 static WebKitWebView * 
 commands_get_webview_with_nummod() 
 {
-    if (dwb.state.nummod > 0 && dwb.state.nummod <= (gint)g_list_length(dwb.state.views)) 
-        return WEBVIEW(g_list_nth(dwb.state.views, NUMMOD - 1));
+    if (dwb.state.nummod > 0 && dwb.state.nummod <= (gint)dwb_tab_count()) 
+        return WEBVIEW(dwb_tab_nth(NUMMOD - 1));
     else 
         return CURRENT_WEBVIEW();
 }
 static GList * 
 commands_get_view_from_nummod() 
 {
-    if (dwb.state.nummod > 0 && dwb.state.nummod <= (gint)g_list_length(dwb.state.views)) 
-        return g_list_nth(dwb.state.views, NUMMOD - 1);
+    if (dwb.state.nummod > 0 && dwb.state.nummod <= (gint)dwb_tab_count()) 
+        return dwb_tab_nth(NUMMOD - 1);
     return dwb.state.fview;
 }
 
@@ -208,7 +210,7 @@ commands_add_search_field(KeyMap *km, Arg *a)
 DwbStatus
 commands_toggle_proxy(KeyMap *km, Arg *a) 
 {
-    WebSettings *s = g_hash_table_lookup(dwb.settings, "proxy");
+    WebSettings *s = dwb.settings_table[SETTINGS_PROXY];
     s->arg_local.b = !s->arg_local.b;
 
     dwb_set_proxy(NULL, s);
@@ -271,9 +273,9 @@ commands_allow_cookie(KeyMap *km, Arg *arg)
     switch (arg->n) 
     {
         case COOKIE_ALLOW_PERSISTENT: 
-            return dwb_soup_allow_cookie(&dwb.fc.cookies_allow, dwb.files[FILES_COOKIES_ALLOW], arg->n);
+            return dwb_soup_allow_cookie(dwb.fc.cookies_allow, dwb.files[FILES_COOKIES_ALLOW], arg->n);
         case COOKIE_ALLOW_SESSION:
-            return dwb_soup_allow_cookie(&dwb.fc.cookies_session_allow, dwb.files[FILES_COOKIES_SESSION_ALLOW], arg->n);
+            return dwb_soup_allow_cookie(dwb.fc.cookies_session_allow, dwb.files[FILES_COOKIES_SESSION_ALLOW], arg->n);
         case COOKIE_ALLOW_SESSION_TMP:
             dwb_soup_allow_cookie_tmp();
             break;
@@ -313,8 +315,8 @@ commands_quickmark(KeyMap *km, Arg *arg)
 DwbStatus
 commands_reload(KeyMap *km, Arg *arg) 
 {
-    GList *gl = dwb.state.nummod > 0 && dwb.state.nummod <= (gint)g_list_length(dwb.state.views)
-        ? g_list_nth(dwb.state.views, dwb.state.nummod-1) 
+    GList *gl = dwb.state.nummod > 0 && dwb.state.nummod <= (gint)dwb_tab_count()
+        ? dwb_tab_nth(dwb.state.nummod-1) 
         : dwb.state.fview;
     dwb_reload(gl);
     return STATUS_OK;
@@ -355,7 +357,7 @@ commands_zoom(KeyMap *km, Arg *arg)
     View *v = dwb.state.fview->data;
     WebKitWebView *web = WEBKIT_WEB_VIEW(v->web);
 
-    gfloat zoomlevel = MAX(webkit_web_view_get_zoom_level(web) + arg->i * NUMMOD * GET_DOUBLE("zoom-step"), 0);
+    gfloat zoomlevel = MAX(webkit_web_view_get_zoom_level(web) + arg->i * NUMMOD * GET_DOUBLE(SETTINGS_ZOOM_STEP), 0);
     webkit_web_view_set_zoom_level(web, zoomlevel);
     dwb_set_normal_message(dwb.state.fview, true, "Zoomlevel: %d%%", (int)(zoomlevel * 100));
     return STATUS_OK;
@@ -432,8 +434,8 @@ commands_focus(KeyMap *km, Arg *arg)
 {
     if (dwb.state.views->next) 
     {
-        int pos = util_modulo(g_list_position(dwb.state.views, dwb.state.fview) + NUMMOD * arg->n, g_list_length(dwb.state.views));
-        GList *g = g_list_nth(dwb.state.views, pos);
+        int pos = util_modulo(dwb_tab_index(dwb.state.fview) + NUMMOD * arg->n, dwb_tab_count());
+        GList *g = dwb_tab_nth(pos);
         dwb_focus_view(g, km->map->n.first);
         return STATUS_OK;
     }
@@ -452,7 +454,7 @@ commands_focus_nth_view(KeyMap *km, Arg *arg)
     {
         case 0  : l = g_list_last(dwb.state.views); break;
         case -1 : l = g_list_first(dwb.state.views); break;
-        default : l = g_list_nth(dwb.state.views, dwb.state.nummod - 1); 
+        default : l = dwb_tab_nth(dwb.state.nummod - 1); 
     }
 
     if (l == NULL) 
@@ -659,7 +661,7 @@ commands_complete_type(KeyMap *km, Arg *arg)
 }/*}}}*/
 
 void
-commands_toggle(Arg *arg, const char *filename, GList **tmp, GList **pers, const char *message) 
+commands_toggle(Arg *arg, const char *filename, DomainIndex *index, const char *message) 
 {
     char *host = NULL;
     const char *block = NULL;
@@ -678,23 +680,21 @@ commands_toggle(Arg *arg, const char *filename, GList **tmp, GList **pers, const
     {
         if (arg->n & ALLOW_TMP) 
         {
-            GList *l;
-            if ( (l = g_list_find_custom(*tmp, block, (GCompareFunc)g_strcmp0)) ) 
+            if (domain_index_lookup(index, block) & DOMAIN_INDEX_TEMPORARY) 
             {
-                g_free(l->data);
-                *tmp = g_list_delete_link(*tmp, l);
+                domain_index_remove(index, block, DOMAIN_INDEX_TEMPORARY);
                 allowed = false;
             }
             else 
             {
-                *tmp = g_list_prepend(*tmp, g_strdup(block));
+                domain_index_add(index, block, DOMAIN_INDEX_TEMPORARY);
                 allowed = true;
             }
             dwb_set_normal_message(dwb.state.fview, true, "%s temporarily %s for %s", message, allowed ? "allowed" : "blocked", block);
         }
         else 
         {
-            allowed = dwb_toggle_allowed(filename, block, pers);
+            allowed = dwb_toggle_allowed(filename, block, index);
             dwb_set_normal_message(dwb.state.fview, true, "%s %s for %s", message, allowed ? "allowed" : "blocked", block);
         }
     }
@@ -705,7 +705,7 @@ commands_toggle(Arg *arg, const char *filename, GList **tmp, GList **pers, const
 DwbStatus 
 commands_toggle_plugin_blocker(KeyMap *km, Arg *arg) 
 {
-    commands_toggle(arg, dwb.files[FILES_PLUGINS_ALLOW], &dwb.fc.tmp_plugins, &dwb.fc.pers_plugins, "Plugins");
+    commands_toggle(arg, dwb.files[FILES_PLUGINS_ALLOW], dwb.fc.plugins_allow, "Plugins");
     return STATUS_OK;
 }
 
@@ -713,7 +713,7 @@ commands_toggle_plugin_blocker(KeyMap *km, Arg *arg)
 DwbStatus 
 commands_toggle_scripts(KeyMap *km, Arg *arg) 
 {
-    commands_toggle(arg, dwb.files[FILES_SCRIPTS_ALLOW], &dwb.fc.tmp_scripts,  &dwb.fc.pers_scripts, "Scripts");
+    commands_toggle(arg, dwb.files[FILES_SCRIPTS_ALLOW], dwb.fc.scripts_allow, "Scripts");
     return STATUS_OK;
 }/*}}}*/
 
@@ -775,7 +775,7 @@ commands_print(KeyMap *km, Arg *arg)
     WebKitWebFrame *frame = webkit_web_view_get_focused_frame(wv);
     if (frame) 
     {
-        char *print_command = GET_CHAR("print-previewer");
+        char *print_command = GET_CHAR(SETTINGS_PRINT_PREVIEWER);
         if (print_command) 
             g_object_set(gtk_settings_get_default(), "gtk-print-preview-command", print_command, NULL);
 
@@ -792,7 +792,7 @@ commands_print_preview(KeyMap *km, Arg *arg)
     WebKitWebFrame *frame = webkit_web_view_get_focused_frame(wv);
     if (frame) 
     {
-        char *print_command = GET_CHAR("print-previewer");
+        char *print_command = GET_CHAR(SETTINGS_PRINT_PREVIEWER);
         if (print_command) 
             g_object_set(gtk_settings_get_default(), "gtk-print-preview-command", print_command, NULL);
 
@@ -809,7 +809,7 @@ commands_print_preview(KeyMap *km, Arg *arg)
 DwbStatus
 commands_web_inspector(KeyMap *km, Arg *arg) 
 {
-    if (GET_BOOL("enable-developer-extras")) 
+    if (GET_BOOL(SETTINGS_ENABLE_DEVELOPER_EXTRAS)) 
     {
         WebKitWebView *wv = commands_get_webview_with_nummod();
         webkit_web_inspector_show(webkit_web_view_get_inspector(wv));
@@ -908,7 +908,7 @@ commands_only(KeyMap *km, Arg *arg)
 static void 
 commands_set_bars(int status) 
 {
-    gtk_widget_set_visible(dwb.gui.tabbox, (status & BAR_VIS_TOP) && (GET_BOOL("show-single-tab") || dwb.state.views->next));
+    gtk_widget_set_visible(dwb.gui.tabbox, (status & BAR_VIS_TOP) && (GET_BOOL(SETTINGS_SHOW_SINGLE_TAB) || dwb.state.views->next));
     gtk_widget_set_visible(dwb.gui.bottombox, status & BAR_VIS_STATUS);
 }
 /* commands_toggle_bars {{{*/
@@ -947,7 +947,7 @@ commands_presentation_mode(KeyMap *km, Arg *arg)
 DwbStatus
 commands_toggle_lock_protect(KeyMap *km, Arg *arg) 
 {
-  GList *gl = dwb.state.nummod < 0 ? dwb.state.fview : g_list_nth(dwb.state.views, dwb.state.nummod-1);
+  GList *gl = dwb.state.nummod < 0 ? dwb.state.fview : dwb_tab_nth(dwb.state.nummod-1);
   if (gl == NULL)
     return STATUS_ERROR;
 
@@ -1002,13 +1002,13 @@ commands_tab_move(KeyMap *km, Arg *arg)
 {
     GList *sibling;
     int newpos;
-    int l = g_list_length(dwb.state.views);
+    int l = dwb_tab_count();
     if (dwb.state.views->next == NULL) 
         return STATUS_ERROR;
     switch (arg->n) 
     {
-        case TAB_MOVE_LEFT   : newpos = MAX(MIN(l-1, g_list_position(dwb.state.views, dwb.state.fview)-NUMMOD), 0); break;
-        case TAB_MOVE_RIGHT  : newpos = MAX(MIN(l-1, g_list_position(dwb.state.views, dwb.state.fview)+NUMMOD), 0); break;
+        case TAB_MOVE_LEFT   : newpos = MAX(MIN(l-1, dwb_tab_index(dwb.state.fview)-NUMMOD), 0); break;
+        case TAB_MOVE_RIGHT  : newpos = MAX(MIN(l-1, dwb_tab_index(dwb.state.fview)+NUMMOD), 0); break;
         default :  newpos = MAX(MIN(l, NUMMOD)-1, 0); break;
     }
 #if _HAS_GTK3
@@ -1042,6 +1042,7 @@ commands_tab_move(KeyMap *km, Arg *arg)
         sibling->prev = dwb.state.fview;
         dwb.state.fview->next = sibling;
     }
+    dwb_tabs_reindex();
     dwb_focus(dwb.state.fview);
     dwb_update_layout();
     return STATUS_OK;
@@ -1083,11 +1084,7 @@ commands_sanitize(KeyMap *km, Arg *arg)
         return STATUS_ERROR;
 
     if (s & SANITIZE_HISTORY) 
-    {
-        dwb_free_list(dwb.fc.history, (void_func)dwb_navigation_free);
-        dwb.fc.history = NULL;
-        remove(dwb.files[FILES_HISTORY]);
-    }
+        dwb_clear_history();
     if (s & (SANITIZE_HISTORY | SANITIZE_CACHE)) 
     {
         for (GList *gl = dwb.state.views; gl; gl=gl->next) 
@@ -1106,7 +1103,7 @@ commands_sanitize(KeyMap *km, Arg *arg)
         session_clear_session();
 
     if (s & (SANITIZE_ALLSESSIONS)) 
-        remove(dwb.files[FILES_SESSION]);
+        session_clear_all();
 
     dwb_set_normal_message(dwb.state.fview, true, "Sanitized %s", arg->p ? arg->p : "all");
     return STATUS_OK;
@@ -1137,7 +1134,7 @@ commands_download(KeyMap *km, Arg *arg)
 DwbStatus 
 commands_toggle_tab(KeyMap *km, Arg *arg) 
 {
-    GList *last = g_list_nth(dwb.state.views, dwb.state.last_tab);
+    GList *last = dwb_tab_nth(dwb.state.last_tab);
     if (last) 
     {
         dwb_focus_view(last, km->map->n.first);
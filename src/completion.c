@@ -87,7 +87,7 @@ completion_get_completion_item(const char  *left, const char *right, const char
 
     completion_modify_completion_item(c, &dwb.color.normal_c_fg, &dwb.color.normal_c_bg, dwb.font.fd_inactive);
 
-    int padding = GET_INT("bars-padding");
+    int padding = GET_INT(SETTINGS_BARS_PADDING);
     GtkWidget *alignment = gtk_alignment_new(0.5, 0.5, 1, 1);
     gtk_alignment_set_padding(GTK_ALIGNMENT(alignment), padding, padding, padding, padding);
     gtk_container_add(GTK_CONTAINER(alignment), hbox);
@@ -314,7 +314,7 @@ completion_show_completion(int back)
     if (back) 
     {
         dwb.comps.active_comp = g_list_last(dwb.comps.completions);
-        for (GList *l = dwb.comps.active_comp; l && i<GET_INT("max-visible-completions"); l=l->prev, i++) 
+        for (GList *l = dwb.comps.active_comp; l && i<GET_INT(SETTINGS_MAX_VISIBLE_COMPLETIONS); l=l->prev, i++) 
         {
             gtk_widget_show_all(((Completion*)l->data)->event);
         }
@@ -322,7 +322,7 @@ completion_show_completion(int back)
     else 
     {
         dwb.comps.active_comp = g_list_first(dwb.comps.completions);
-        for (GList *l = dwb.comps.active_comp; l && i<GET_INT("max-visible-completions"); l=l->next, i++) 
+        for (GList *l = dwb.comps.active_comp; l && i<GET_INT(SETTINGS_MAX_VISIBLE_COMPLETIONS); l=l->next, i++) 
         {
             gtk_widget_show_all(((Completion*)l->data)->event);
         }
@@ -344,14 +344,14 @@ completion_get_normal_completion()
 
     if (!(dwb.state.mode & COMMAND_MODE) ) 
     {
-        if (GET_BOOL("complete-userscripts")) 
+        if (GET_BOOL(SETTINGS_COMPLETE_USERSCRIPTS)) 
             list = completion_init_completion(list, dwb.misc.userscripts, false, NULL, "Userscript");
-        if (GET_BOOL("complete-searchengines")) 
+        if (GET_BOOL(SETTINGS_COMPLETE_SEARCHENGINES)) 
             list = completion_init_completion(list, dwb.fc.se_completion, false, NULL, "Searchengine");
     }
-    if (GET_BOOL("complete-bookmarks")) 
+    if (GET_BOOL(SETTINGS_COMPLETE_BOOKMARKS)) 
         list = completion_init_completion(list, dwb.fc.bookmarks, false, NULL, "Bookmark");
-    if (GET_BOOL("complete-history")) 
+    if (GET_BOOL(SETTINGS_COMPLETE_HISTORY)) 
         list = completion_init_completion(list, dwb.fc.history, false, NULL, "History");
 
     return  list;
@@ -427,6 +427,7 @@ completion_get_key_completion(gboolean entry)
     const char *input = GET_TEXT();
 
     dwb.keymap = g_list_sort(dwb.keymap, (GCompareFunc)util_keymap_sort_first);
+    dwb_keymap_changed();
     input = dwb_parse_nummod(input);
 
     /* check for aliases first */
@@ -519,11 +520,11 @@ completion_buffer_key_press(GdkEventKey *e)
         completion_complete(COMP_BUFFER, e->state & GDK_SHIFT_MASK);
     else if (DIGIT(e)) {
         int value = e->keyval - GDK_KEY_0;
-        int length = g_list_length(dwb.state.views);
+        int length = dwb_tab_count();
         if (length < 10) 
         {
             if (value != 0 && value <= length) 
-                completion_buffer_exec(g_list_nth(dwb.state.views, value-1));
+                completion_buffer_exec(dwb_tab_nth(value-1));
         }
         else 
         {
@@ -535,7 +536,7 @@ completion_buffer_key_press(GdkEventKey *e)
             }
             if (s_last_buf != 0) {
                 if ((s_last_buf < 10 && s_leading0 == true) || s_last_buf >= 10) 
-                    completion_buffer_exec(g_list_nth(dwb.state.views, s_last_buf-1));
+                    completion_buffer_exec(dwb_tab_nth(s_last_buf-1));
             }
             else 
                 s_leading0 = true;
@@ -561,7 +562,7 @@ completion_complete_buffer()
     Completion *c; 
     WebKitWebView *wv;
 
-    format = g_list_length(dwb.state.views) > 10 ? "%02d : %s" : "%d : %s";
+    format = dwb_tab_count() > 10 ? "%02d : %s" : "%d : %s";
     for (GList *l = dwb.state.views;l; l=l->next) 
     {
         if (VIEW(l)->status->deferred) 
@@ -693,7 +694,7 @@ completion_complete(CompletionType type, int back)
         dwb.comps.view = dwb.state.fview;
     }
     else if (dwb.comps.completions && dwb.comps.active_comp) 
-        dwb.comps.active_comp = completion_update_completion(dwb.gui.compbox, dwb.comps.completions, dwb.comps.active_comp, GET_INT("max-visible-completions"), back);
+        dwb.comps.active_comp = completion_update_completion(dwb.gui.compbox, dwb.comps.completions, dwb.comps.active_comp, GET_INT(SETTINGS_MAX_VISIBLE_COMPLETIONS), back);
 
     return ret;
 }/*}}}*/
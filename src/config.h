@@ -896,361 +896,366 @@ static FunctionMap FMAP [] = {
 
 /* SETTINGS_ARRAY {{{*/
   /* { name,    description, builtin, global, type,  argument,  set-function */
+  /* Every setting needs an index in enum SettingsId, see dwb.h */
 static WebSettings DWB_SETTINGS[] = {
-  { { "auto-load-images",			                   "Load images automatically", },                                         
+  [SETTINGS_AUTO_LOAD_IMAGES] = { { "auto-load-images",			                   "Load images automatically", },                                         
     SETTING_BUILTIN,  BOOLEAN, { .b = true              }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "auto-resize-window",			                 "Autoresize window", },                                       
+  [SETTINGS_AUTO_RESIZE_WINDOW] = { { "auto-resize-window",			                 "Autoresize window", },                                       
     SETTING_BUILTIN,  BOOLEAN, { .b = false             }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "auto-shrink-images",			                 "Automatically shrink standalone images to fit", },                                       
+  [SETTINGS_AUTO_SHRINK_IMAGES] = { { "auto-shrink-images",			                 "Automatically shrink standalone images to fit", },                                       
     SETTING_BUILTIN,  BOOLEAN, { .b = true              }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "cursive-font-family",			               "Cursive font family used to display text", },                                     
+  [SETTINGS_CURSIVE_FONT_FAMILY] = { { "cursive-font-family",			               "Cursive font family used to display text", },                                     
     SETTING_BUILTIN,  CHAR,    { .p = "serif"           }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "default-encoding",			                   "Default encoding used to display text", },                                        
+  [SETTINGS_DEFAULT_ENCODING] = { { "default-encoding",			                   "Default encoding used to display text", },                                        
     SETTING_BUILTIN,  CHAR,    { .p = NULL      }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "default-font-family",			               "Default font family used to display text", },                                     
+  [SETTINGS_DEFAULT_FONT_FAMILY] = { { "default-font-family",			               "Default font family used to display text", },                                     
     SETTING_BUILTIN,  CHAR,    { .p = "sans-serif"      }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "default-font-size",			                 "Default font size used to display text", },                                       
+  [SETTINGS_DEFAULT_FONT_SIZE] = { { "default-font-size",			                 "Default font size used to display text", },                                       
     SETTING_BUILTIN,  INTEGER, { .i = 12                }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "default-monospace-font-size",			       "Default monospace font size used to display text", },                             
+  [SETTINGS_DEFAULT_MONOSPACE_FONT_SIZE] = { { "default-monospace-font-size",			       "Default monospace font size used to display text", },                             
     SETTING_BUILTIN,  INTEGER, { .i = 10                }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "enable-caret-browsing",			             "Whether to enable caret browsing", },                                          
+  [SETTINGS_ENABLE_CARET_BROWSING] = { { "enable-caret-browsing",			             "Whether to enable caret browsing", },                                          
     SETTING_BUILTIN,  BOOLEAN, { .b = false             }, (S_Func) dwb_webkit_setting,  { 0 }, },
   //{ { "enable-accelerated-compositing",			       "Whether to enable gpu accelerated compositing", },                             
   //  SETTING_BUILTIN,  BOOLEAN, { .b = false              }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "enable-default-context-menu",			       "Whether to enable the right click context menu", },                             
+  [SETTINGS_ENABLE_DEFAULT_CONTEXT_MENU] = { { "enable-default-context-menu",			       "Whether to enable the right click context menu", },                             
     SETTING_BUILTIN,  BOOLEAN, { .b = true              }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "enable-developer-extras",			           "Whether developer extensions should be enabled",    },                              
+  [SETTINGS_ENABLE_DEVELOPER_EXTRAS] = { { "enable-developer-extras",			           "Whether developer extensions should be enabled",    },                              
     SETTING_BUILTIN,  BOOLEAN, { .b = false             }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "enable-dns-prefetching",			           "Whether webkit prefetches domain names",    },                              
+  [SETTINGS_ENABLE_DNS_PREFETCHING] = { { "enable-dns-prefetching",			           "Whether webkit prefetches domain names",    },                              
     SETTING_BUILTIN,  BOOLEAN, { .b = true             }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "enable-dom-paste",			                   "Whether to enable DOM paste", },                                        
+  [SETTINGS_ENABLE_DOM_PASTE] = { { "enable-dom-paste",			                   "Whether to enable DOM paste", },                                        
     SETTING_BUILTIN,  BOOLEAN, { .b = false             }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "enable-frame-flattening",			           "Whether to enable Frame Flattening", },                                        
+  [SETTINGS_ENABLE_FRAME_FLATTENING] = { { "enable-frame-flattening",			           "Whether to enable Frame Flattening", },                                        
     SETTING_BUILTIN,  BOOLEAN, { .b = false             }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "enable-file-access-from-file-uris",			 "Whether file access from file uris is allowed", },                              
+  [SETTINGS_ENABLE_FILE_ACCESS_FROM_FILE_URIS] = { { "enable-file-access-from-file-uris",			 "Whether file access from file uris is allowed", },                              
     SETTING_BUILTIN,  BOOLEAN, { .b = true              }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "enable-html5-database",			             "Enable HTML5 client side SQL-database support" },                                    
+  [SETTINGS_ENABLE_HTML5_DATABASE] = { { "enable-html5-database",			             "Enable HTML5 client side SQL-database support" },                                    
     SETTING_BUILTIN,  BOOLEAN, { .b = true              }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "enable-html5-local-storage",			         "Enable HTML5 local storage", },                              
+  [SETTINGS_ENABLE_HTML5_LOCAL_STORAGE] = { { "enable-html5-local-storage",			         "Enable HTML5 local storage", },                              
     SETTING_BUILTIN,  BOOLEAN, { .b = true              }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "enable-java-applet",			                 "Whether to enable java applets", },                                            
+  [SETTINGS_ENABLE_JAVA_APPLET] = { { "enable-java-applet",			                 "Whether to enable java applets", },                                            
     SETTING_BUILTIN,  BOOLEAN, { .b = true              }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "enable-offline-web-application-cache",		 "Enable HTML5 offline web application cache", },                           
+  [SETTINGS_ENABLE_OFFLINE_WEB_APPLICATION_CACHE] = { { "enable-offline-web-application-cache",		 "Enable HTML5 offline web application cache", },                           
     SETTING_BUILTIN,  BOOLEAN, { .b = true              }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "enable-page-cache",			                 "Whether to enable page cache", },                                              
+  [SETTINGS_ENABLE_PAGE_CACHE] = { { "enable-page-cache",			                 "Whether to enable page cache", },                                              
     SETTING_BUILTIN,  BOOLEAN, { .b = false             }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "enable-plugins",			                     "Whether to enable plugins", },                                                 
+  [SETTINGS_ENABLE_PLUGINS] = { { "enable-plugins",			                     "Whether to enable plugins", },                                                 
     SETTING_BUILTIN,  BOOLEAN, { .b = true              }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "enable-private-browsing",			           "Whether to enable private browsing mode", },                                        
+  [SETTINGS_ENABLE_PRIVATE_BROWSING] = { { "enable-private-browsing",			           "Whether to enable private browsing mode", },                                        
     SETTING_BUILTIN | SETTING_ONINIT,  BOOLEAN, { .b = false             }, (S_Func) dwb_set_private_browsing,  { 0 }, },
-  { { "enable-scripts",			                     "Enable embedded scripting languages", },                                                  
+  [SETTINGS_ENABLE_SCRIPTS] = { { "enable-scripts",			                     "Enable embedded scripting languages", },                                                  
     SETTING_PER_VIEW,  BOOLEAN, { .b = true              }, (S_Func) dwb_set_scripts,  { 0 }, },
-  { { "enable-site-specific-quirks",			       "Enable site-specific compatibility workarounds", },                                    
+  [SETTINGS_ENABLE_SITE_SPECIFIC_QUIRKS] = { { "enable-site-specific-quirks",			       "Enable site-specific compatibility workarounds", },                                    
     SETTING_BUILTIN,  BOOLEAN, { .b = false             }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "enable-spatial-navigation",			         "Spatial navigation", },                                      
+  [SETTINGS_ENABLE_SPATIAL_NAVIGATION] = { { "enable-spatial-navigation",			         "Spatial navigation", },                                      
     SETTING_BUILTIN,  BOOLEAN, { .b = false             }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "enable-spell-checking",			             "Whether to enable spell checking", },                                          
+  [SETTINGS_ENABLE_SPELL_CHECKING] = { { "enable-spell-checking",			             "Whether to enable spell checking", },                                          
     SETTING_BUILTIN,  BOOLEAN, { .b = false             }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "enable-universal-access-from-file-uris",	 "Whether to allow files loaded through file:", },                        
+  [SETTINGS_ENABLE_UNIVERSAL_ACCESS_FROM_FILE_URIS] = { { "enable-universal-access-from-file-uris",	 "Whether to allow files loaded through file:", },                        
     SETTING_BUILTIN,  BOOLEAN, { .b = true              }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "enable-webgl",			                 "Enable or disable support for webgl on pages", },                                             
+  [SETTINGS_ENABLE_WEBGL] = { { "enable-webgl",			                 "Enable or disable support for webgl on pages", },                                             
     SETTING_BUILTIN,  BOOLEAN, { .b = false              }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "enable-xss-auditor",			                 "Whether to enable the XSS auditor", },                                             
+  [SETTINGS_ENABLE_XSS_AUDITOR] = { { "enable-xss-auditor",			                 "Whether to enable the XSS auditor", },                                             
     SETTING_BUILTIN,  BOOLEAN, { .b = true              }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "enforce-96-dpi",			                     "Enforce a resolution of 96 dpi", },                                          
+  [SETTINGS_ENFORCE_96_DPI] = { { "enforce-96-dpi",			                     "Enforce a resolution of 96 dpi", },                                          
     SETTING_BUILTIN,  BOOLEAN, { .b = false             }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "fantasy-font-family",			               "Default fantasy font family used to display text", },                                     
+  [SETTINGS_FANTASY_FONT_FAMILY] = { { "fantasy-font-family",			               "Default fantasy font family used to display text", },                                     
     SETTING_BUILTIN,  CHAR,    { .p = "serif"           }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "javascript-can-access-clipboard",			   "Whether javascript can access clipboard", },                         
+  [SETTINGS_JAVASCRIPT_CAN_ACCESS_CLIPBOARD] = { { "javascript-can-access-clipboard",			   "Whether javascript can access clipboard", },                         
     SETTING_BUILTIN,  BOOLEAN, { .b = false             }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "javascript-can-open-windows-automatically", "Whether javascript can open windows", },             
+  [SETTINGS_JAVASCRIPT_CAN_OPEN_WINDOWS_AUTOMATICALLY] = { { "javascript-can-open-windows-automatically", "Whether javascript can open windows", },             
     SETTING_BUILTIN,  BOOLEAN, { .b = false             }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "minimum-font-size",			                 "Minimum font size to display text", },                                       
+  [SETTINGS_MINIMUM_FONT_SIZE] = { { "minimum-font-size",			                 "Minimum font size to display text", },                                       
     SETTING_BUILTIN,  INTEGER, { .i = 5                 }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "minimum-logical-font-size",			         "Minimum logical font size used to display text", },                               
+  [SETTINGS_MINIMUM_LOGICAL_FONT_SIZE] = { { "minimum-logical-font-size",			         "Minimum logical font size used to display text", },                               
     SETTING_BUILTIN,  INTEGER, { .i = 5                 }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "monospace-font-family",			             "Monospace font family used to display text", },                                   
+  [SETTINGS_MONOSPACE_FONT_FAMILY] = { { "monospace-font-family",			             "Monospace font family used to display text", },                                   
     SETTING_BUILTIN,  CHAR,    { .p = "monospace"       }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "print-backgrounds",			                 "Whether background images should be printed", },                                       
+  [SETTINGS_PRINT_BACKGROUNDS] = { { "print-backgrounds",			                 "Whether background images should be printed", },                                       
     SETTING_BUILTIN,  BOOLEAN, { .b = true              }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "resizable-text-areas",			               "Whether text areas are resizable", },                                    
+  [SETTINGS_RESIZABLE_TEXT_AREAS] = { { "resizable-text-areas",			               "Whether text areas are resizable", },                                    
     SETTING_BUILTIN,  BOOLEAN, { .b = true              }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "sans-serif-font-family",			             "Sans serif font family used to display text", },                                  
+  [SETTINGS_SANS_SERIF_FONT_FAMILY] = { { "sans-serif-font-family",			             "Sans serif font family used to display text", },                                  
     SETTING_BUILTIN,  CHAR,    { .p = "sans-serif"      }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "serif-font-family",			                 "Serif font family used to display text", },                                       
+  [SETTINGS_SERIF_FONT_FAMILY] = { { "serif-font-family",			                 "Serif font family used to display text", },                                       
     SETTING_BUILTIN,  CHAR,    { .p = "serif"           }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "spell-checking-languages",			           "Language used for spellchecking sperated by commas", },                                
+  [SETTINGS_SPELL_CHECKING_LANGUAGES] = { { "spell-checking-languages",			           "Language used for spellchecking sperated by commas", },                                
     SETTING_BUILTIN,  CHAR,    { .p = NULL              }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "tab-key-cycles-through-elements",			   "Tab cycles through elements in insert mode", },              
+  [SETTINGS_TAB_KEY_CYCLES_THROUGH_ELEMENTS] = { { "tab-key-cycles-through-elements",			   "Tab cycles through elements in insert mode", },              
     SETTING_BUILTIN,  BOOLEAN, { .b = true              }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "user-agent",			                         "The user agent string", },                                              
+  [SETTINGS_USER_AGENT] = { { "user-agent",			                         "The user agent string", },                                              
     SETTING_PER_VIEW,                CHAR,    { .p = NULL              }, (S_Func) dwb_set_user_agent,  { 0 }, },
-  { { "user-stylesheet-uri",			               "The uri of a stylsheet applied to every page", },                                     
+  [SETTINGS_USER_STYLESHEET_URI] = { { "user-stylesheet-uri",			               "The uri of a stylsheet applied to every page", },                                     
     SETTING_BUILTIN,  CHAR,    { .p = NULL              }, (S_Func) dwb_set_user_stylesheet,  { 0 }, },
-  { { "zoom-step",			                         "The zoom step", },                                               
+  [SETTINGS_ZOOM_STEP] = { { "zoom-step",			                         "The zoom step", },                                               
     SETTING_BUILTIN,  DOUBLE,  { .d = 0.1               }, (S_Func) dwb_webkit_setting,  { 0 }, },
-  { { "custom-encoding",                         "The custom encoding of the tab", },                                         
+  [SETTINGS_CUSTOM_ENCODING] = { { "custom-encoding",                         "The custom encoding of the tab", },                                         
     SETTING_PER_VIEW,                CHAR,    { .p = NULL           }, (S_Func) dwb_webview_property,  { 0 }, },
-  { { "editable",                                "Whether content can be modified", },                                        
+  [SETTINGS_EDITABLE] = { { "editable",                                "Whether content can be modified", },                                        
     SETTING_PER_VIEW,                BOOLEAN, { .b = false             }, (S_Func) dwb_webview_property,  { 0 }, },
-  { { "full-content-zoom",                       "Whether the full content is scaled when zooming", },                                       
+  [SETTINGS_FULL_CONTENT_ZOOM] = { { "full-content-zoom",                       "Whether the full content is scaled when zooming", },                                       
     SETTING_PER_VIEW,                BOOLEAN, { .b = false             }, (S_Func) dwb_webview_property,  { 0 }, },
-  { { "zoom-level",                              "The default zoom level", },
+  [SETTINGS_ZOOM_LEVEL] = { { "zoom-level",                              "The default zoom level", },
     SETTING_PER_VIEW,                DOUBLE,  { .d = 1.0               }, (S_Func) dwb_webview_property,  { 0 }, },
-  { { "proxy",                                   "Whether to use a HTTP-proxy", },                                              
+  [SETTINGS_PROXY] = { { "proxy",                                   "Whether to use a HTTP-proxy", },                                              
     SETTING_GLOBAL,      BOOLEAN, { .b = false              },  (S_Func) dwb_set_proxy,  { 0 }, },
-  { { "proxy-url",                               "The HTTP-proxy url", },                                          
+  [SETTINGS_PROXY_URL] = { { "proxy-url",                               "The HTTP-proxy url", },                                          
     SETTING_GLOBAL,      CHAR,    { .p = NULL              },   (S_Func) dwb_soup_init_proxy,  { 0 }, },
-  { { "ssl-strict",                               "Whether to allow only safe certificates", },                                          
+  [SETTINGS_SSL_STRICT] = { { "ssl-strict",                               "Whether to allow only safe certificates", },                                          
     SETTING_GLOBAL,      BOOLEAN,    { .b = true            },   (S_Func) dwb_soup_init_session_features,  { 0 }, },
 #ifdef WITH_LIBSOUP_2_38
-  { { "ssl-use-system-ca-file",                               "Whether to use the system certification file", },                                          
+  [SETTINGS_SSL_USE_SYSTEM_CA_FILE] = { { "ssl-use-system-ca-file",                               "Whether to use the system certification file", },                                          
     SETTING_GLOBAL,      BOOLEAN,    { .b = true            },   (S_Func) dwb_soup_init_session_features,  { 0 }, },
 #else
-  { { "ssl-ca-cert",                               "Path to ssl-certificate", },                                          
+  [SETTINGS_SSL_CA_CERT] = { { "ssl-ca-cert",                               "Path to ssl-certificate", },                                          
     SETTING_GLOBAL,      CHAR,    { .p = NULL            },   (S_Func) dwb_soup_init_session_features,  { 0 }, },
 #endif
-  { { "cookies-store-policy",                                  "Whether to store cookies", },                                     
+  [SETTINGS_COOKIES_STORE_POLICY] = { { "cookies-store-policy",                                  "Whether to store cookies", },                                     
     SETTING_GLOBAL | SETTING_ONINIT,      CHAR, { .p = "session"             }, (S_Func) dwb_set_cookies,  { 0 }, },
-  { { "cookies-accept-policy",                     "Cookies to accept, always never or nothirdparty", },                                     
+  [SETTINGS_COOKIES_ACCEPT_POLICY] = { { "cookies-accept-policy",                     "Cookies to accept, always never or nothirdparty", },                                     
     SETTING_GLOBAL,      CHAR, { .p = "always"          }, (S_Func) dwb_set_cookie_accept_policy,  { 0 }, },
-  { { "background-tabs",			                     "Whether to open tabs in background", },                                 
+  [SETTINGS_BACKGROUND_TABS] = { { "background-tabs",			                     "Whether to open tabs in background", },                                 
     SETTING_GLOBAL | SETTING_ONINIT,      BOOLEAN,    { .b = false         }, (S_Func) dwb_set_background_tab,  { 0 }, },
-  { { "scroll-step",			                     "Whether to open tabs in background", },                                 
+  [SETTINGS_SCROLL_STEP] = { { "scroll-step",			                     "Whether to open tabs in background", },                                 
     SETTING_GLOBAL | SETTING_ONINIT,      DOUBLE,    { .d = 0         }, (S_Func) dwb_set_scroll_step,  { 0 }, },
 
-  { { "do-not-track",			                     "Whether to add do not track flag to request headers", },                                 
+  [SETTINGS_DO_NOT_TRACK] = { { "do-not-track",			                     "Whether to add do not track flag to request headers", },                                 
     SETTING_GLOBAL | SETTING_ONINIT,      BOOLEAN,    { .b = true         }, (S_Func) dwb_set_do_not_track,  { 0 }, },
 
-  { { "foreground-color",                         "Foreground color of the active tab", },                              
+  [SETTINGS_FOREGROUND_COLOR] = { { "foreground-color",                         "Foreground color of the active tab", },                              
     SETTING_GLOBAL,  COLOR_CHAR, { .p = "#ffffff"         },    (S_Func) dwb_reload_layout,   { 0 }, },
-  { { "background-color",                         "Background color of the active tab", },                              
+  [SETTINGS_BACKGROUND_COLOR] = { { "background-color",                         "Background color of the active tab", },                              
     SETTING_GLOBAL,  COLOR_CHAR, { .p = "#000000"         },    (S_Func) dwb_reload_layout,  { 0 }, },
-  { { "private-color",                         "Statusbar background color in private browsing mode", },                              
+  [SETTINGS_PRIVATE_COLOR] = { { "private-color",                         "Statusbar background color in private browsing mode", },                              
     SETTING_GLOBAL,  COLOR_CHAR, { .p = "#505050"         },    (S_Func) dwb_reload_layout,  { 0 }, },
 
-  { { "tab-active-fg-color",                     "Foreground color of the active tab", },                           
+  [SETTINGS_TAB_ACTIVE_FG_COLOR] = { { "tab-active-fg-color",                     "Foreground color of the active tab", },                           
     SETTING_GLOBAL,  COLOR_CHAR, { .p = "#ffffff"         },    (S_Func) dwb_reload_layout,  { 0 }, },
-  { { "tab-active-bg-color",                     "Background color of the active tab", },                           
+  [SETTINGS_TAB_ACTIVE_BG_COLOR] = { { "tab-active-bg-color",                     "Background color of the active tab", },                           
     SETTING_GLOBAL,  COLOR_CHAR, { .p = "#000000"         },    (S_Func) dwb_reload_layout,  { 0 }, },
-  { { "tab-normal-fg-color-1",                     "Foreground color of inactive tabs", },                         
+  [SETTINGS_TAB_NORMAL_FG_COLOR_1] = { { "tab-normal-fg-color-1",                     "Foreground color of inactive tabs", },                         
     SETTING_GLOBAL,  COLOR_CHAR, { .p = "#cccccc"         },    (S_Func) dwb_reload_layout,  { 0 }, },
-  { { "tab-normal-bg-color-1",                     "Background color of inactive tabs", },                         
+  [SETTINGS_TAB_NORMAL_BG_COLOR_1] = { { "tab-normal-bg-color-1",                     "Background color of inactive tabs", },                         
     SETTING_GLOBAL,  COLOR_CHAR, { .p = "#505050"         },    (S_Func) dwb_reload_layout,  { 0 }, },
-  { { "tab-normal-fg-color-2",                     "Foreground color of inactive tabs", },                         
+  [SETTINGS_TAB_NORMAL_FG_COLOR_2] = { { "tab-normal-fg-color-2",                     "Foreground color of inactive tabs", },                         
     SETTING_GLOBAL,  COLOR_CHAR, { .p = "#dddddd"         },    (S_Func) dwb_reload_layout,  { 0 }, },
-  { { "tab-normal-bg-color-2",                     "Background color of inactive tabs", },                         
+  [SETTINGS_TAB_NORMAL_BG_COLOR_2] = { { "tab-normal-bg-color-2",                     "Background color of inactive tabs", },                         
     SETTING_GLOBAL,  COLOR_CHAR, { .p = "#707070"         },    (S_Func) dwb_reload_layout,  { 0 }, },
-  { { "tab-number-color",                        "Color of the number in the tab", },                      
+  [SETTINGS_TAB_NUMBER_COLOR] = { { "tab-number-color",                        "Color of the number in the tab", },                      
     SETTING_GLOBAL,  COLOR_CHAR, { .p = "#7ac5cd"         },    (S_Func) dwb_reload_layout,  { 0 }, },
-  { { "tab-protected-color",                        "Color of the number in the tab", },                      
+  [SETTINGS_TAB_PROTECTED_COLOR] = { { "tab-protected-color",                        "Color of the number in the tab", },                      
     SETTING_GLOBAL,  COLOR_CHAR, { .p = "#ff0000"         },    (S_Func) dwb_reload_layout,  { 0 }, },
-  { { "tabbed-browsing",                         "Whether to enable tabbed browsing", },                                  
+  [SETTINGS_TABBED_BROWSING] = { { "tabbed-browsing",                         "Whether to enable tabbed browsing", },                                  
     SETTING_GLOBAL,  BOOLEAN,      { .b = true         },      NULL,  { 0 }, },
-  { { "enable-favicon",                         "Whether to show favicons", },                                  
+  [SETTINGS_ENABLE_FAVICON] = { { "enable-favicon",                         "Whether to show favicons", },                                  
     SETTING_GLOBAL,  BOOLEAN,      { .b = true         },      (S_Func)dwb_set_favicon,  { 0 }, },
-  { { "favicon-size",                         "Size of the favicon", },
+  [SETTINGS_FAVICON_SIZE] = { { "favicon-size",                         "Size of the favicon", },
     SETTING_GLOBAL|SETTING_ONINIT,  INTEGER,      { .i = 0         },      (S_Func)dwb_set_favicon_size,  { 0 }, },
-  { { "tabbar-height",                         "Height of the tabbar", },
+  [SETTINGS_TABBAR_HEIGHT] = { { "tabbar-height",                         "Height of the tabbar", },
     SETTING_GLOBAL|SETTING_ONINIT,  INTEGER,      { .i = 0         },      (S_Func)dwb_set_tabbar_height,  { 0 }, },
-  { { "statusbar-height",                         "Height of the statusbar", },
+  [SETTINGS_STATUSBAR_HEIGHT] = { { "statusbar-height",                         "Height of the statusbar", },
     SETTING_GLOBAL|SETTING_ONINIT,  INTEGER,      { .i = 0         },      (S_Func)dwb_set_statusbar_height,  { 0 }, },
-  { { "file-sync-interval",                            "Interval to save files to hdd or 0 to directly write to hdd", },                                  
+  [SETTINGS_FILE_SYNC_INTERVAL] = { { "file-sync-interval",                            "Interval to save files to hdd or 0 to directly write to hdd", },                                  
     SETTING_GLOBAL|SETTING_ONINIT,  INTEGER,      { .i = 120         },      (S_Func) dwb_set_sync_interval,  { 0 }, },
-  { { "sync-files",                            "Files to sync", },                                  
+  [SETTINGS_SYNC_FILES] = { { "sync-files",                            "Files to sync", },                                  
     SETTING_GLOBAL|SETTING_ONINIT,  CHAR,      { .p = "all"         },      (S_Func) dwb_set_sync_files,  { 0 }, },
+  [SETTINGS_SHARED_FILES] = { { "shared-files",                          "Share history and cookies with other instances", },                                  
+    SETTING_GLOBAL,  BOOLEAN,      { .b = false         },      (S_Func) dwb_set_shared_files,  { 0 }, },
 
-  { { "active-completion-fg-color",                    "Foreground color of the active tabcompletion item", },                        
+  [SETTINGS_ACTIVE_COMPLETION_FG_COLOR] = { { "active-completion-fg-color",                    "Foreground color of the active tabcompletion item", },                        
     SETTING_GLOBAL,  COLOR_CHAR, { .p = "#53868b"         }, (S_Func) dwb_init_style,  { 0 }, },
-  { { "active-completion-bg-color",                    "Background color of the active tabcompletion item", },                        
+  [SETTINGS_ACTIVE_COMPLETION_BG_COLOR] = { { "active-completion-bg-color",                    "Background color of the active tabcompletion item", },                        
     SETTING_GLOBAL,  COLOR_CHAR, { .p = "#000000"         }, (S_Func) dwb_init_style,  { 0 }, },
-  { { "normal-completion-fg-color",                    "Foreground color of an inactive tabcompletion item", },                      
+  [SETTINGS_NORMAL_COMPLETION_FG_COLOR] = { { "normal-completion-fg-color",                    "Foreground color of an inactive tabcompletion item", },                      
     SETTING_GLOBAL,  COLOR_CHAR, { .p = "#eeeeee"         }, (S_Func) dwb_init_style,  { 0 }, },
-  { { "normal-completion-bg-color",                    "Background color of an inactive tabcompletion item", },                      
+  [SETTINGS_NORMAL_COMPLETION_BG_COLOR] = { { "normal-completion-bg-color",                    "Background color of an inactive tabcompletion item", },                      
     SETTING_GLOBAL,  COLOR_CHAR, { .p = "#151515"         }, (S_Func) dwb_init_style,  { 0 }, },
 
-  { { "ssl-trusted-color",                         "Color for ssl-encrypted sites, trusted certificate", },                 
+  [SETTINGS_SSL_TRUSTED_COLOR] = { { "ssl-trusted-color",                         "Color for ssl-encrypted sites, trusted certificate", },                 
     SETTING_GLOBAL,  COLOR_CHAR, { .p = "#00ff00"         }, (S_Func) dwb_init_style,  { 0 }, },
-  { { "ssl-untrusted-color",                       "Color for ssl-encrypted sites, untrusted certificate", },                 
+  [SETTINGS_SSL_UNTRUSTED_COLOR] = { { "ssl-untrusted-color",                       "Color for ssl-encrypted sites, untrusted certificate", },                 
     SETTING_GLOBAL,  COLOR_CHAR, { .p = "#ff0000"         }, (S_Func) dwb_init_style,  { 0 }, },
-  { { "error-color",                             "Color for error messages", },                                         
+  [SETTINGS_ERROR_COLOR] = { { "error-color",                             "Color for error messages", },                                         
     SETTING_GLOBAL,  COLOR_CHAR, { .p = "#ff0000"         }, (S_Func) dwb_init_style,  { 0 }, },
-  { { "prompt-color",                             "Color for prompt messages", },                                         
+  [SETTINGS_PROMPT_COLOR] = { { "prompt-color",                             "Color for prompt messages", },                                         
     SETTING_GLOBAL,  COLOR_CHAR, { .p = "#00ff00"         }, (S_Func) dwb_init_style,  { 0 }, },
-  { { "status-allowed-color",                        "Color of allowed elements in the statusbar", },           
+  [SETTINGS_STATUS_ALLOWED_COLOR] = { { "status-allowed-color",                        "Color of allowed elements in the statusbar", },           
     SETTING_GLOBAL,  COLOR_CHAR, { .p = "#00ff00"       },    (S_Func) dwb_reload_layout,  { 0 }, },
-  { { "status-blocked-color",                        "Color of blocked elements in the statusbar", },           
+  [SETTINGS_STATUS_BLOCKED_COLOR] = { { "status-blocked-color",                        "Color of blocked elements in the statusbar", },           
     SETTING_GLOBAL,  COLOR_CHAR, { .p = "#ffffff"       },    (S_Func) dwb_reload_layout,  { 0 }, },
-  { { "download-bg-color",                            "Background color of the download label", },           
+  [SETTINGS_DOWNLOAD_BG_COLOR] = { { "download-bg-color",                            "Background color of the download label", },           
     SETTING_GLOBAL,  COLOR_CHAR, { .p = "#000000"       },    (S_Func) dwb_reload_layout,  { 0 }, },
-  { { "download-fg-color",                            "Background color of the download label", },           
+  [SETTINGS_DOWNLOAD_FG_COLOR] = { { "download-fg-color",                            "Background color of the download label", },           
     SETTING_GLOBAL,  COLOR_CHAR, { .p = "#ffffff"       },    (S_Func) dwb_reload_layout,  { 0 }, },
-  { { "download-gradient-start",                        "Download start gradient color", },           
+  [SETTINGS_DOWNLOAD_GRADIENT_START] = { { "download-gradient-start",                        "Download start gradient color", },           
     SETTING_GLOBAL,  COLOR_CHAR, { .p = "#0000aa"       },    (S_Func) dwb_reload_layout,  { 0 }, },
-  { { "download-gradient-end",                        "Download end gradient color", },           
+  [SETTINGS_DOWNLOAD_GRADIENT_END] = { { "download-gradient-end",                        "Download end gradient color", },           
     SETTING_GLOBAL,  COLOR_CHAR, { .p = "#00aa00"       },    (S_Func) dwb_reload_layout,  { 0 }, },
-  { { "progress-bar-full-color",                        "Color of the full part of the progress bar", },           
+  [SETTINGS_PROGRESS_BAR_FULL_COLOR] = { { "progress-bar-full-color",                        "Color of the full part of the progress bar", },           
     SETTING_GLOBAL,  COLOR_CHAR, { .p = "#ffffff"       },    (S_Func) dwb_reload_layout,  { 0 }, },
-  { { "progress-bar-empty-color",                        "Color of the empty part of the progress bar", },           
+  [SETTINGS_PROGRESS_BAR_EMPTY_COLOR] = { { "progress-bar-empty-color",                        "Color of the empty part of the progress bar", },           
     SETTING_GLOBAL,  COLOR_CHAR, { .p = "#ffffff"       },    (S_Func) dwb_reload_layout,  { 0 }, },
 
-  { { "font",                                    "Default font used for the ui", },                                       
+  [SETTINGS_FONT] = { { "font",                                    "Default font used for the ui", },                                       
     SETTING_GLOBAL,  CHAR, { .p = "monospace 8"          },   (S_Func) dwb_reload_layout,  { 0 }, },
-  { { "font-entry",                              "Font of the addressbar", },                            
+  [SETTINGS_FONT_ENTRY] = { { "font-entry",                              "Font of the addressbar", },                            
     SETTING_GLOBAL,  CHAR, { .p = NULL                   },   (S_Func) dwb_reload_layout,  { 0 }, },
-  { { "font-completion",                         "Font for tab-completion", },                            
+  [SETTINGS_FONT_COMPLETION] = { { "font-completion",                         "Font for tab-completion", },                            
     SETTING_GLOBAL,  CHAR, { .p = NULL                   },   (S_Func) dwb_reload_layout,  { 0 }, },
-  { { "font-nofocus",                           "Font of tabs/completion items without focus", },                  
+  [SETTINGS_FONT_NOFOCUS] = { { "font-nofocus",                           "Font of tabs/completion items without focus", },                  
     SETTING_GLOBAL,  CHAR, { .p = NULL                   },   (S_Func) dwb_reload_layout,  { 0 }, },
-  { { "font-hidden-statusbar",                           "Font for status elements if statusbar is hidden", },                  
+  [SETTINGS_FONT_HIDDEN_STATUSBAR] = { { "font-hidden-statusbar",                           "Font for status elements if statusbar is hidden", },                  
     SETTING_GLOBAL,  CHAR, { .p = "normal 10px helvetica"              },   (S_Func) NULL,  { 0 }, }, 
    
-  { { "hint-style",                              "Whether to use 'letter' or 'number' hints", },                     
+  [SETTINGS_HINT_STYLE] = { { "hint-style",                              "Whether to use 'letter' or 'number' hints", },                     
     SETTING_GLOBAL,  CHAR, { .p = "letter"            },     (S_Func) dwb_init_hints,  { 0 }, },
-  { { "hint-letter-seq",                       "Letter sequence for letter hints", },             
+  [SETTINGS_HINT_LETTER_SEQ] = { { "hint-letter-seq",                       "Letter sequence for letter hints", },             
     SETTING_GLOBAL,  CHAR, { .p = "FDSARTGBVECWXQYIOPMNHZULKJ"  }, (S_Func) dwb_init_hints,  { 0 }, },
-  { { "hint-highlight-links",                  "Whether to highlight links in hintmode", },             
+  [SETTINGS_HINT_HIGHLIGHT_LINKS] = { { "hint-highlight-links",                  "Whether to highlight links in hintmode", },             
     SETTING_GLOBAL,  BOOLEAN, { .b = false  }, (S_Func) dwb_init_hints, { 0 }, },
-  { { "hint-font",                          "Font size of hints", },                                        
+  [SETTINGS_HINT_FONT] = { { "hint-font",                          "Font size of hints", },                                        
     SETTING_GLOBAL,  CHAR, { .p = "bold 10px monospace"             },     (S_Func) dwb_init_hints, { 0 }, },
-  { { "hint-fg-color",                           "Foreground color of hints", },                                 
+  [SETTINGS_HINT_FG_COLOR] = { { "hint-fg-color",                           "Foreground color of hints", },                                 
     SETTING_GLOBAL,  CHAR, { .p = "#000000"      },     (S_Func) dwb_init_hints, { 0 }, },
-  { { "hint-bg-color",                           "Background color of hints", },                                 
+  [SETTINGS_HINT_BG_COLOR] = { { "hint-bg-color",                           "Background color of hints", },                                 
     SETTING_GLOBAL,  CHAR, { .p = "#ffffff"      },     (S_Func) dwb_init_hints, { 0 }, },
-  { { "hint-active-color",                       "Color of the active link in hintmode", },                                
+  [SETTINGS_HINT_ACTIVE_COLOR] = { { "hint-active-color",                       "Color of the active link in hintmode", },                                
     SETTING_GLOBAL,  CHAR, { .p = "#00ff00"      },     (S_Func) dwb_init_hints, { 0 }, },
-  { { "hint-normal-color",                       "Color of inactive links in hintmode", },                              
+  [SETTINGS_HINT_NORMAL_COLOR] = { { "hint-normal-color",                       "Color of inactive links in hintmode", },                              
     SETTING_GLOBAL,  CHAR, { .p = "#ffff99"      },     (S_Func) dwb_init_hints,  { 0 }, },
-  { { "hint-border",                             "Border used for hints", },                                      
+  [SETTINGS_HINT_BORDER] = { { "hint-border",                             "Border used for hints", },                                      
     SETTING_GLOBAL,  CHAR, { .p = "1px solid #000000"    }, (S_Func) dwb_init_hints, { 0 }, },
-  { { "hint-opacity",                            "The opacity of hints", },                                     
+  [SETTINGS_HINT_OPACITY] = { { "hint-opacity",                            "The opacity of hints", },                                     
     SETTING_GLOBAL,  DOUBLE, { .d = 0.8         },          (S_Func) dwb_init_hints, { 0 }, },
-  { { "hint-offset-top",                            "Top offset of hints", },                                     
+  [SETTINGS_HINT_OFFSET_TOP] = { { "hint-offset-top",                            "Top offset of hints", },                                     
     SETTING_GLOBAL,  INTEGER, { .i = 0         },          (S_Func) dwb_init_hints, { 0 }, },
-  { { "hint-offset-left",                            "Left offset of hints", },                                     
+  [SETTINGS_HINT_OFFSET_LEFT] = { { "hint-offset-left",                            "Left offset of hints", },                                     
     SETTING_GLOBAL,  INTEGER, { .i = 0         },          (S_Func) dwb_init_hints, { 0 }, },
-  { { "hint-autofollow",                            "Whether to follow hints automatically if one hint matches", },                                     
+  [SETTINGS_HINT_AUTOFOLLOW] = { { "hint-autofollow",                            "Whether to follow hints automatically if one hint matches", },                                     
     SETTING_GLOBAL,  BOOLEAN, { .b = true         },          (S_Func) dwb_init_hints,  { 0 }, },
 
-  { { "auto-completion",                         "Show possible shortcuts", },                                
+  [SETTINGS_AUTO_COMPLETION] = { { "auto-completion",                         "Show possible shortcuts", },                                
     SETTING_GLOBAL | SETTING_ONINIT,  BOOLEAN, { .b = false         },     (S_Func)completion_set_autcompletion,  { 0 }, },
-  { { "startpage",                               "The default homepage", },                                        
+  [SETTINGS_STARTPAGE] = { { "startpage",                               "The default homepage", },                                        
     SETTING_GLOBAL | SETTING_ONINIT,  CHAR,    { .p = "dwb:bookmarks" },        (S_Func)dwb_set_startpage,  { 0 }, }, 
-  { { "update-search-delay",                               "The delay when searching between every keypress", },                                        
+  [SETTINGS_UPDATE_SEARCH_DELAY] = { { "update-search-delay",                               "The delay when searching between every keypress", },                                        
     SETTING_GLOBAL | SETTING_ONINIT,  INTEGER,    { .i = 200 },        (S_Func)dwb_set_find_delay,  { 0 }, }, 
-  { { "single-instance",                         "Whether to have only on instance", },                                         
+  [SETTINGS_SINGLE_INSTANCE] = { { "single-instance",                         "Whether to have only on instance", },                                         
     SETTING_GLOBAL,  BOOLEAN,    { .b = true },          NULL,  { 0 }, }, 
-  { { "save-session",                            "Whether to automatically save sessions", },                                       
+  [SETTINGS_SAVE_SESSION] = { { "save-session",                            "Whether to automatically save sessions", },                                       
     SETTING_GLOBAL,  BOOLEAN,    { .b = true },          NULL,  { 0 }, }, 
-  { { "widget-packing",                            "Packing of the main widgets", },                                       
+  [SETTINGS_WIDGET_PACKING] = { { "widget-packing",                            "Packing of the main widgets", },                                       
     SETTING_GLOBAL,  CHAR,    { .p = "dtws" },           (S_Func)dwb_set_widget_packing,  { 0 }, }, 
-  { { "progress-bar-style",                        "Style of the progress bar", },                   
+  [SETTINGS_PROGRESS_BAR_STYLE] = { { "progress-bar-style",                        "Style of the progress bar", },                   
     SETTING_GLOBAL | SETTING_ONINIT,  CHAR, { .p = "default" }, (S_Func)dwb_set_progress_bar_style,   { 0 }, },
-  { { "cache-model",                            "Packing of the main widgets", },                                       
+  [SETTINGS_CACHE_MODEL] = { { "cache-model",                            "Packing of the main widgets", },                                       
     SETTING_GLOBAL,  CHAR,    { .p = "webbrowser" },           NULL,  { 0 }, }, 
-  { { "javascript-schemes",                    "Whether to allow loading urls with 'javascript' scheme", },                                       
+  [SETTINGS_JAVASCRIPT_SCHEMES] = { { "javascript-schemes",                    "Whether to allow loading urls with 'javascript' scheme", },                                       
     SETTING_GLOBAL,  BOOLEAN,    { .b = true },           NULL,  { 0 }, }, 
   
 
   /* downloads */
-  { { "download-external-command",                        "External program used for downloads", },                               
+  [SETTINGS_DOWNLOAD_EXTERNAL_COMMAND] = { { "download-external-command",                        "External program used for downloads", },                               
     SETTING_GLOBAL,  CHAR, { .p = "xterm -e wget dwb_uri -O dwb_output --load-cookies dwb_cookies"   },     NULL,  { 0 }, },
-  { { "download-no-confirm",                        "Whether to confirm download directory", },
+  [SETTINGS_DOWNLOAD_NO_CONFIRM] = { { "download-no-confirm",                        "Whether to confirm download directory", },
     SETTING_GLOBAL,  BOOLEAN, { .b = false   },     NULL,  { 0 }, },
-  { { "download-directory",                        "Default download directory", },                               
+  [SETTINGS_DOWNLOAD_DIRECTORY] = { { "download-directory",                        "Default download directory", },                               
     SETTING_GLOBAL,  CHAR, { .p = NULL   },     NULL,  { 0 }, },
-  { { "download-use-external-program",           "Whether to use an external download program", },                           
+  [SETTINGS_DOWNLOAD_USE_EXTERNAL_PROGRAM] = { { "download-use-external-program",           "Whether to use an external download program", },                           
     SETTING_GLOBAL,  BOOLEAN, { .b = false         },    NULL,  { 0 }, },
 
-  { { "complete-history",                        "Whether to complete browsing history with tab", },                              
+  [SETTINGS_COMPLETE_HISTORY] = { { "complete-history",                        "Whether to complete browsing history with tab", },                              
     SETTING_GLOBAL,  BOOLEAN, { .b = true         },     NULL,  { 0 }, },
-  { { "complete-bookmarks",                        "Whether to complete bookmarks with tab", },                                     
+  [SETTINGS_COMPLETE_BOOKMARKS] = { { "complete-bookmarks",                        "Whether to complete bookmarks with tab", },                                     
     SETTING_GLOBAL,  BOOLEAN, { .b = true         },     NULL,  { 0 }, },
-  { { "complete-searchengines",                   "Whether to complete searchengines with tab", },                                     
+  [SETTINGS_COMPLETE_SEARCHENGINES] = { { "complete-searchengines",                   "Whether to complete searchengines with tab", },                                     
     SETTING_GLOBAL,  BOOLEAN, { .b = false         },     NULL,  { 0 }, },
-  { { "complete-userscripts",                        "Whether to complete userscripts", },                                     
+  [SETTINGS_COMPLETE_USERSCRIPTS] = { { "complete-userscripts",                        "Whether to complete userscripts", },                                     
     SETTING_GLOBAL,  BOOLEAN, { .b = false         },     NULL,  { 0 }, },
 
-  { { "default-width",                           "Default width of the window", },                                           
+  [SETTINGS_DEFAULT_WIDTH] = { { "default-width",                           "Default width of the window", },                                           
     SETTING_GLOBAL,  INTEGER, { .i = 800          }, NULL,  { 0 }, },
-  { { "default-height",                          "Default height of the window", },                                           
+  [SETTINGS_DEFAULT_HEIGHT] = { { "default-height",                          "Default height of the window", },                                           
     SETTING_GLOBAL,  INTEGER, { .i = 600          }, NULL,  { 0 }, },
-  { { "message-delay",                           "Time in seconds, messages are shown", },                                           
+  [SETTINGS_MESSAGE_DELAY] = { { "message-delay",                           "Time in seconds, messages are shown", },                                           
     SETTING_GLOBAL | SETTING_ONINIT,  INTEGER, { .i = 2          }, (S_Func) dwb_set_message_delay,  { 0 }, },
-  { { "history-length",                          "Length of the browsing history", },                                          
+  [SETTINGS_HISTORY_LENGTH] = { { "history-length",                          "Length of the browsing history", },                                          
     SETTING_GLOBAL | SETTING_ONINIT,  INTEGER, { .i = 500          }, (S_Func) dwb_set_history_length,  { 0 }, },
-  { { "navigation-history-max",                          "Length of the navigation history", },                                          
+  [SETTINGS_NAVIGATION_HISTORY_MAX] = { { "navigation-history-max",                          "Length of the navigation history", },                                          
     SETTING_GLOBAL,  INTEGER, { .i = 500          }, (S_Func) NULL,  { 0 }, },
-  { { "scrollbars",                                  "Whether scrollbars should be enabled", },     
+  [SETTINGS_SCROLLBARS] = { { "scrollbars",                                  "Whether scrollbars should be enabled", },     
     SETTING_GLOBAL,  BOOLEAN, { .b = false },  NULL,  { 0 }, },
-  { { "scheme-handler",                            "Handler script for unsupported schemes", },                                            
+  [SETTINGS_SCHEME_HANDLER] = { { "scheme-handler",                            "Handler script for unsupported schemes", },                                            
     SETTING_GLOBAL,  CHAR, { .p = NULL }, NULL,  { 0 }, }, 
-  { { "editor",                            "External editor", },                                            
+  [SETTINGS_EDITOR] = { { "editor",                            "External editor", },                                            
     SETTING_GLOBAL,  CHAR, { .p = "xterm -e vim dwb_uri" }, NULL,   { 0 }, }, 
-  { { "adblocker",                               "Whether to block advertisements via a filterlist", },                   
+  [SETTINGS_ADBLOCKER] = { { "adblocker",                               "Whether to block advertisements via a filterlist", },                   
     SETTING_GLOBAL,  BOOLEAN, { .b = false }, (S_Func)dwb_set_adblock,   { 0 }, }, 
-  { { "adblocker-filterlist",                    "Path to a filterlist", },                   
+  [SETTINGS_ADBLOCKER_FILTERLIST] = { { "adblocker-filterlist",                    "Path to a filterlist", },                   
     SETTING_GLOBAL,  CHAR, { .p = NULL }, NULL,   { 0 }, }, 
-  { { "adblocker-element-hider",            "Whether to enable element hider rules for the adblocker", },                                            
+  [SETTINGS_ADBLOCKER_ELEMENT_HIDER] = { { "adblocker-element-hider",            "Whether to enable element hider rules for the adblocker", },                                            
     SETTING_GLOBAL,  BOOLEAN, { .b = true }, NULL,   { 0 }, }, 
 #ifndef DISABLE_HSTS
-  { { "hsts",                                    "Whether HSTS support should be enabled",},
+  [SETTINGS_HSTS] = { { "hsts",                                    "Whether HSTS support should be enabled",},
     SETTING_GLOBAL,  BOOLEAN, { .b = false }, (S_Func)dwb_set_hsts,       { 0 }, },
 #endif
 #ifdef WITH_LIBSOUP_2_38 
-  { { "addressbar-dns-lookup",                               "Whether to perform a dns check for text typed into the address bar", },                   
+  [SETTINGS_ADDRESSBAR_DNS_LOOKUP] = { { "addressbar-dns-lookup",                               "Whether to perform a dns check for text typed into the address bar", },                   
     SETTING_GLOBAL | SETTING_ONINIT,  BOOLEAN, { .b = false }, (S_Func)dwb_set_dns_lookup,   { 0 }, }, 
 #endif
-  { { "plugin-blocker",                         "Whether to block flash plugins and replace them with a clickable element", },                   
+  [SETTINGS_PLUGIN_BLOCKER] = { { "plugin-blocker",                         "Whether to block flash plugins and replace them with a clickable element", },                   
     SETTING_PER_VIEW,  BOOLEAN, { .b = true }, (S_Func)dwb_set_plugin_blocker,   { 0 }, }, 
-  { { "plugin-blocker",                         "Whether to block flash plugins and replace them with a clickable element", },                   
-    SETTING_PER_VIEW,  BOOLEAN, { .b = true }, (S_Func)dwb_set_plugin_blocker,   { 0 }, }, 
-  { { "auto-insert-mode",                         "Whether go automatically in insert mode if input or textarea has focus", },                   
+  [SETTINGS_AUTO_INSERT_MODE] = { { "auto-insert-mode",                         "Whether go automatically in insert mode if input or textarea has focus", },                   
     SETTING_GLOBAL | SETTING_ONINIT,  BOOLEAN, { .b = false }, (S_Func)dwb_set_auto_insert_mode,   { 0 }, }, 
-  { { "tabbar-visible",                         "Number of seconds the tabbar is shown when switching tabs", },                   
+  [SETTINGS_TABBAR_VISIBLE] = { { "tabbar-visible",                         "Number of seconds the tabbar is shown when switching tabs", },                   
     SETTING_GLOBAL | SETTING_ONINIT,  DOUBLE, { .d = 2 }, (S_Func)dwb_set_tabbar_delay,   { 0 }, }, 
-  { { "new-tab-position-policy",                         "Number of seconds the tabbar is shown when switching tabs", },                   
+  [SETTINGS_NEW_TAB_POSITION_POLICY] = { { "new-tab-position-policy",                         "Number of seconds the tabbar is shown when switching tabs", },                   
     SETTING_GLOBAL | SETTING_ONINIT,  CHAR, { .p = "right", .n = CLOSE_TAB_POSITION_MASK, .i = 0 }, (S_Func)dwb_set_new_tab_position_policy,   { 0 }, }, 
-  { { "close-tab-focus-policy",                         "Number of seconds the tabbar is shown when switching tabs", },                   
+  [SETTINGS_CLOSE_TAB_FOCUS_POLICY] = { { "close-tab-focus-policy",                         "Number of seconds the tabbar is shown when switching tabs", },                   
     SETTING_GLOBAL | SETTING_ONINIT,  CHAR, { .p = "left" }, (S_Func)dwb_set_close_tab_position_policy,   { 0 }, }, 
-  { { "close-last-tab-policy",                         "Behaviour when the last tab is closed", },                   
+  [SETTINGS_CLOSE_LAST_TAB_POLICY] = { { "close-last-tab-policy",                         "Behaviour when the last tab is closed", },                   
     SETTING_GLOBAL | SETTING_ONINIT,  CHAR, { .p = "ignore" }, (S_Func)dwb_set_close_last_tab_policy,   { 0 }, },
-  { { "bars-padding",                         "Padding of the status, download, completion and tab bars", },                   
+  [SETTINGS_BARS_PADDING] = { { "bars-padding",                         "Padding of the status, download, completion and tab bars", },                   
     SETTING_GLOBAL,  INTEGER, { .i = 0 }, NULL,   { 0 }, },
-  { { "searchengine-submit-pattern",                            "The pattern which will be replaced with the search terms", },                                            
+  [SETTINGS_SEARCHENGINE_SUBMIT_PATTERN] = { { "searchengine-submit-pattern",                            "The pattern which will be replaced with the search terms", },                                            
     SETTING_GLOBAL,  CHAR, { .p = NULL }, NULL,   { 0 }, }, 
-  { { "show-single-tab",                            "Whether to show tabbar if only on tab is opened", },                                            
+  [SETTINGS_SHOW_SINGLE_TAB] = { { "show-single-tab",                            "Whether to show tabbar if only on tab is opened", },                                            
     SETTING_GLOBAL | SETTING_ONINIT,  BOOLEAN, { .b = true }, (S_Func)dwb_set_show_single_tab,   { 0 }, }, 
-  { { "hints-key-lock",                            "Timeout keypresses are ignored after following a hint", },                                            
+  [SETTINGS_HINTS_KEY_LOCK] = { { "hints-key-lock",                            "Timeout keypresses are ignored after following a hint", },                                            
     SETTING_GLOBAL,  INTEGER, { .i = 250 }, NULL,   { 0 }, }, 
-  { { "load-on-focus",                            "Load uris at the earliest when a tab gets focus", },                                            
+  [SETTINGS_LOAD_ON_FOCUS] = { { "load-on-focus",                            "Load uris at the earliest when a tab gets focus", },                                            
     SETTING_GLOBAL,  BOOLEAN, { .b = false }, NULL,   { 0 }, }, 
-  { { "print-previewer",                            "Command used for the printing preview", },                                            
+  [SETTINGS_HIBERNATE_TIMEOUT] = { { "hibernate-timeout",                            "Seconds a background tab must be idle before its page is unloaded or 0 to disable", },                                            
+    SETTING_GLOBAL|SETTING_ONINIT,  INTEGER, { .i = 0 }, (S_Func) dwb_set_hibernate_timeout,   { 0 }, }, 
+  [SETTINGS_HIBERNATE_MAX_TABS] = { { "hibernate-max-tabs",                            "Maximum number of loaded tabs before idle background tabs are unloaded or 0 to disable", },                                            
+    SETTING_GLOBAL|SETTING_ONINIT,  INTEGER, { .i = 0 }, (S_Func) dwb_set_hibernate_max_tabs,   { 0 }, }, 
+  [SETTINGS_PRINT_PREVIEWER] = { { "print-previewer",                            "Command used for the printing preview", },                                            
     SETTING_GLOBAL,  CHAR, { .p = NULL }, NULL,   { 0 }, }, 
-  { { "accept-language",                            "If set will be used for 'Accept-Language' header in all requests", },                                            
+  [SETTINGS_ACCEPT_LANGUAGE] = { { "accept-language",                            "If set will be used for 'Accept-Language' header in all requests", },                                            
     SETTING_GLOBAL | SETTING_ONINIT,  CHAR, { .p = NULL }, (S_Func)dwb_set_accept_language,   { 0 }, }, 
-  { { "max-visible-completions",                            "Maximum number of visible completions", },                                            
+  [SETTINGS_MAX_VISIBLE_COMPLETIONS] = { { "max-visible-completions",                            "Maximum number of visible completions", },                                            
     SETTING_GLOBAL,  INTEGER, { .i = 11 }, NULL,   { 0 }, }, 
-  { { "cookie-expiration",                            "Cookie expiration time", },                                            
+  [SETTINGS_COOKIE_EXPIRATION] = { { "cookie-expiration",                            "Cookie expiration time", },                                            
     SETTING_GLOBAL | SETTING_ONINIT,  CHAR, { .p = "0" }, (S_Func)dwb_set_cookie_expiration,   { 0 }, }, 
-  { { "passthrough-keys",                            "Whether to enable webkit builtin shortcuts", },                                            
+  [SETTINGS_PASSTHROUGH_KEYS] = { { "passthrough-keys",                            "Whether to enable webkit builtin shortcuts", },                                            
     SETTING_GLOBAL | SETTING_ONINIT,  CHAR, { .p = "webkit" }, (S_Func)dwb_set_passthrough,   { 0 }, }, 
 #if !_HAS_GTK3
-  { { "tab-orientation",                            "Whether to enable webkit builtin shortcuts", },                                            
+  [SETTINGS_TAB_ORIENTATION] = { { "tab-orientation",                            "Whether to enable webkit builtin shortcuts", },                                            
     SETTING_GLOBAL | SETTING_ONINIT,  CHAR, { .p = "horizontal" }, (S_Func)dwb_set_tab_orientation,   { 0 }, }, 
-  { { "tab-width",                            "Tab width for vertical tabs", },                                            
+  [SETTINGS_TAB_WIDTH] = { { "tab-width",                            "Tab width for vertical tabs", },                                            
     SETTING_GLOBAL,                   INTEGER, { .i = 100 }, (S_Func)dwb_set_tab_width,   { 0 }, }, 
 #endif
-  { { "mouse-cycles-through-tabs",            "Whether mouse scroll wheel cycles through tabs", },                                            
+  [SETTINGS_MOUSE_CYCLES_THROUGH_TABS] = { { "mouse-cycles-through-tabs",            "Whether mouse scroll wheel cycles through tabs", },                                            
     SETTING_GLOBAL,  BOOLEAN, { .b = true }, NULL,   { 0 }, }, 
-  { { "maximum-tabs",            "Maximum number of tabs", },                                            
+  [SETTINGS_MAXIMUM_TABS] = { { "maximum-tabs",            "Maximum number of tabs", },                                            
     SETTING_GLOBAL | SETTING_ONINIT,  INTEGER, { .i = 0 }, (S_Func)dwb_set_max_tabs,   { 0 }, }, 
-  { { "javascript-api",            "Whether to enable the javascript api", },                                            
+  [SETTINGS_JAVASCRIPT_API] = { { "javascript-api",            "Whether to enable the javascript api", },                                            
     SETTING_GLOBAL | SETTING_ONINIT,  CHAR, { .p = "automatic" }, (S_Func)dwb_set_javascript_api,   { 0 }, }, 
-  { { "block-insecure-content",            "Whether to block http-requests on https-sites", },                                            
+  [SETTINGS_BLOCK_INSECURE_CONTENT] = { { "block-insecure-content",            "Whether to block http-requests on https-sites", },                                            
     SETTING_GLOBAL | SETTING_ONINIT,  BOOLEAN, { .b = false }, (S_Func)dwb_set_block_insecure_content,   { 0 }, }, 
 
-  { { "enable-ipc",            "Whether to enable inter process communication, required for dwbremote", },                                            
+  [SETTINGS_ENABLE_IPC] = { { "enable-ipc",            "Whether to enable inter process communication, required for dwbremote", },                                            
     SETTING_GLOBAL,  BOOLEAN, { .b = true }, (S_Func)dwb_set_enable_ipc,   { 0 }, }, 
 
   //{ { "javascript-debugging",                            "If set will be used for 'Accept-Language' header in all requests", },                                            
@@ -221,6 +221,343 @@ domain_get_base_for_host(const char *host)
     return base;
 }
 
+/* Domain index {{{*/
+/*
+ * The domain index stores hostnames in a tree of reversed labels, i.e.
+ * www.example.com is stored as com -> example -> www, so that a host and all
+ * of its parent domains are found in a single walk from the root. Entries that
+ * are not hostnames, e.g. uris, are stored in a plain hash table. 
+ *
+ * Every entry carries a set of flags, e.g. DOMAIN_INDEX_PERSISTENT and
+ * DOMAIN_INDEX_TEMPORARY, so one index can hold several whitelists for the same
+ * purpose.
+ */
+typedef struct _DomainIndexNode DomainIndexNode;
+struct _DomainIndexNode {
+    /* label -> DomainIndexNode, created on demand */
+    GHashTable *children;
+    /* flags of the entry label.parent */
+    guint flags;
+    /* flags of the entry .label.parent (cookie domain notation) */
+    guint dot_flags;
+    /* number of entries in this subtree, including this node */
+    guint entries;
+};
+struct _DomainIndex {
+    DomainIndexNode *root;
+    GHashTable *exact;
+};
+
+static DomainIndexNode *
+domain_index_node_new()
+{
+    DomainIndexNode *node = dwb_malloc(sizeof(DomainIndexNode));
+    node->children = NULL;
+    node->flags = 0;
+    node->dot_flags = 0;
+    node->entries = 0;
+    return node;
+}
+static void
+domain_index_node_free(DomainIndexNode *node)
+{
+    if (node == NULL)
+        return;
+    if (node->children != NULL)
+        g_hash_table_unref(node->children);
+    g_free(node);
+}
+static DomainIndexNode *
+domain_index_node_child(DomainIndexNode *node, const char *label)
+{
+    if (node->children == NULL)
+        return NULL;
+    return g_hash_table_lookup(node->children, label);
+}
+
+/* Splits an entry into its labels, top-level label first. The labels point
+ * into buffer which must be at least DOMAIN_INDEX_MAX_LENGTH bytes long.
+ * Returns the number of labels or -1 if entry is not a hostname */
+static int
+domain_index_split(const char *entry, char *buffer, const char **labels, gboolean *dot)
+{
+    size_t length;
+    int n = 0;
+
+    if (entry == NULL)
+        return -1;
+
+    *dot = *entry == '.';
+    if (*dot)
+        entry++;
+
+    length = strlen(entry);
+    if (length == 0 || length >= DOMAIN_INDEX_MAX_LENGTH || strpbrk(entry, "/: \t") != NULL)
+        return -1;
+
+    for (size_t i=0; i<length; i++)
+        buffer[i] = g_ascii_tolower(entry[i]);
+    buffer[length] = '\0';
+
+    if (buffer[length-1] == '.')
+        buffer[--length] = '\0';
+    if (length == 0)
+        return -1;
+
+    for (int i=length-1; i>=-1; i--) 
+    {
+        if (i == -1 || buffer[i] == '.') 
+        {
+            labels[n++] = buffer + i + 1;
+            if (i >= 0)
+                buffer[i] = '\0';
+        }
+    }
+    return n;
+}
+
+DomainIndex *
+domain_index_new()
+{
+    DomainIndex *index = dwb_malloc(sizeof(DomainIndex));
+    index->root = domain_index_node_new();
+    index->exact = g_hash_table_new_full((GHashFunc)g_str_hash, (GEqualFunc)g_str_equal, g_free, NULL);
+    return index;
+}
+void
+domain_index_free(DomainIndex *index)
+{
+    if (index == NULL)
+        return;
+    domain_index_node_free(index->root);
+    g_hash_table_unref(index->exact);
+    g_free(index);
+}
+
+/* Adds flags to an entry, returns true if the entry didn't have all flags
+ * before */
+gboolean
+domain_index_add(DomainIndex *index, const char *entry, guint flags)
+{
+    g_return_val_if_fail(index != NULL, false);
+
+    char buffer[DOMAIN_INDEX_MAX_LENGTH];
+    const char *labels[DOMAIN_INDEX_MAX_LENGTH];
+    DomainIndexNode *path[DOMAIN_INDEX_MAX_LENGTH + 1];
+    DomainIndexNode *node, *child;
+    gboolean dot;
+    guint old, *slot;
+    int n = domain_index_split(entry, buffer, labels, &dot);
+
+    if (n == -1) 
+    {
+        if (entry == NULL || *entry == '\0')
+            return false;
+        old = GPOINTER_TO_UINT(g_hash_table_lookup(index->exact, entry));
+        g_hash_table_insert(index->exact, g_strdup(entry), GUINT_TO_POINTER(old | flags));
+        return (old & flags) != flags;
+    }
+
+    node = path[0] = index->root;
+    for (int i=0; i<n; i++) 
+    {
+        child = domain_index_node_child(node, labels[i]);
+        if (child == NULL) 
+        {
+            if (node->children == NULL)
+                node->children = g_hash_table_new_full((GHashFunc)g_str_hash, (GEqualFunc)g_str_equal, 
+                        g_free, (GDestroyNotify)domain_index_node_free);
+            child = domain_index_node_new();
+            g_hash_table_insert(node->children, g_strdup(labels[i]), child);
+        }
+        node = path[i+1] = child;
+    }
+
+    slot = dot ? &node->dot_flags : &node->flags;
+    old = *slot;
+    *slot |= flags;
+    if (old == 0 && *slot != 0) 
+    {
+        for (int i=0; i<=n; i++)
+            path[i]->entries++;
+    }
+    return (old & flags) != flags;
+}
+
+/* Removes flags from an entry, the entry is removed completely if it has no
+ * flags left. Returns true if the entry had any of the flags */
+gboolean
+domain_index_remove(DomainIndex *index, const char *entry, guint flags)
+{
+    g_return_val_if_fail(index != NULL, false);
+
+    char buffer[DOMAIN_INDEX_MAX_LENGTH];
+    const char *labels[DOMAIN_INDEX_MAX_LENGTH];
+    DomainIndexNode *path[DOMAIN_INDEX_MAX_LENGTH + 1];
+    DomainIndexNode *node;
+    gboolean dot;
+    guint old, *slot;
+    int n = domain_index_split(entry, buffer, labels, &dot);
+
+    if (n == -1) 
+    {
+        if (entry == NULL)
+            return false;
+        old = GPOINTER_TO_UINT(g_hash_table_lookup(index->exact, entry));
+        if (old & ~flags)
+            g_hash_table_insert(index->exact, g_strdup(entry), GUINT_TO_POINTER(old & ~flags));
+        else if (old != 0)
+            g_hash_table_remove(index->exact, entry);
+        return (old & flags) != 0;
+    }
+
+    node = path[0] = index->root;
+    for (int i=0; i<n; i++) 
+    {
+        if ((node = domain_index_node_child(node, labels[i])) == NULL)
+            return false;
+        path[i+1] = node;
+    }
+
+    slot = dot ? &node->dot_flags : &node->flags;
+    old = *slot;
+    *slot &= ~flags;
+    if (old != 0 && *slot == 0) 
+    {
+        for (int i=0; i<=n; i++)
+            path[i]->entries--;
+        /* prune the topmost empty subtree */
+        for (int i=1; i<=n; i++) 
+        {
+            if (path[i]->entries == 0) 
+            {
+                g_hash_table_remove(path[i-1]->children, labels[i-1]);
+                break;
+            }
+        }
+    }
+    return (old & flags) != 0;
+}
+
+static guint
+domain_index_node_clear(DomainIndexNode *node, guint flags)
+{
+    GHashTableIter iter;
+    DomainIndexNode *child;
+
+    node->flags &= ~flags;
+    node->dot_flags &= ~flags;
+    node->entries = (node->flags != 0) + (node->dot_flags != 0);
+
+    if (node->children != NULL) 
+    {
+        g_hash_table_iter_init(&iter, node->children);
+        while (g_hash_table_iter_next(&iter, NULL, (gpointer*)&child)) 
+        {
+            if (domain_index_node_clear(child, flags) == 0)
+                g_hash_table_iter_remove(&iter);
+            else 
+                node->entries += child->entries;
+        }
+    }
+    return node->entries;
+}
+/* Removes flags from all entries */
+void
+domain_index_clear(DomainIndex *index, guint flags)
+{
+    g_return_if_fail(index != NULL);
+
+    GHashTableIter iter;
+    gpointer value;
+
+    domain_index_node_clear(index->root, flags);
+
+    g_hash_table_iter_init(&iter, index->exact);
+    while (g_hash_table_iter_next(&iter, NULL, &value)) 
+    {
+        if ((GPOINTER_TO_UINT(value) & ~flags) == 0)
+            g_hash_table_iter_remove(&iter);
+        else 
+            g_hash_table_iter_replace(&iter, GUINT_TO_POINTER(GPOINTER_TO_UINT(value) & ~flags));
+    }
+}
+
+/* Returns the flags of exactly this entry */
+guint
+domain_index_lookup(DomainIndex *index, const char *entry)
+{
+    g_return_val_if_fail(index != NULL, 0);
+
+    char buffer[DOMAIN_INDEX_MAX_LENGTH];
+    const char *labels[DOMAIN_INDEX_MAX_LENGTH];
+    DomainIndexNode *node = index->root;
+    gboolean dot;
+    int n = domain_index_split(entry, buffer, labels, &dot);
+
+    if (n == -1) 
+        return entry == NULL ? 0 : GPOINTER_TO_UINT(g_hash_table_lookup(index->exact, entry));
+
+    for (int i=0; i<n && node != NULL; i++) 
+        node = domain_index_node_child(node, labels[i]);
+
+    if (node == NULL)
+        return 0;
+    return dot ? node->dot_flags : node->flags;
+}
+
+/* Returns the flags of host and all of its parent domains, e.g. for
+ * www.example.com the flags of example.com, .example.com, www.example.com and
+ * .www.example.com are combined */
+guint
+domain_index_match_host(DomainIndex *index, const char *host)
+{
+    g_return_val_if_fail(index != NULL, 0);
+
+    char buffer[DOMAIN_INDEX_MAX_LENGTH];
+    const char *labels[DOMAIN_INDEX_MAX_LENGTH];
+    DomainIndexNode *node = index->root;
+    gboolean dot;
+    guint flags = 0;
+    int n = domain_index_split(host, buffer, labels, &dot);
+
+    if (n == -1) 
+        return host == NULL ? 0 : GPOINTER_TO_UINT(g_hash_table_lookup(index->exact, host));
+
+    for (int i=0; i<n; i++) 
+    {
+        if ((node = domain_index_node_child(node, labels[i])) == NULL)
+            break;
+        flags |= node->flags | node->dot_flags;
+    }
+    return flags;
+}
+
+/* Checks if a cookie domain matches any entry, using the same rules as
+ * soup_cookie_domain_matches: a domain with a leading dot matches all entries
+ * in its subtree, a domain without a leading dot only matches itself */
+gboolean
+domain_index_match_cookie_domain(DomainIndex *index, const char *domain)
+{
+    g_return_val_if_fail(index != NULL, false);
+
+    char buffer[DOMAIN_INDEX_MAX_LENGTH];
+    const char *labels[DOMAIN_INDEX_MAX_LENGTH];
+    DomainIndexNode *node = index->root;
+    gboolean dot;
+    int n = domain_index_split(domain, buffer, labels, &dot);
+
+    if (n == -1) 
+        return domain != NULL && g_hash_table_lookup(index->exact, domain) != NULL;
+
+    for (int i=0; i<n && node != NULL; i++) 
+        node = domain_index_node_child(node, labels[i]);
+
+    if (node == NULL)
+        return false;
+    return dot ? node->entries > 0 : node->flags != 0;
+}/*}}}*/
+
 void
 domain_end() 
 {
@@ -22,6 +22,12 @@
 #define __DWB_DOMAIN_H__
 
 #define SUBDOMAIN_MAX 32
+#define DOMAIN_INDEX_MAX_LENGTH 256
+
+enum {
+    DOMAIN_INDEX_PERSISTENT = 1<<0,
+    DOMAIN_INDEX_TEMPORARY  = 1<<1,
+};
 
 void domain_init(void);
 void domain_end(void);
@@ -30,4 +36,13 @@ GSList * domain_get_cookie_domains(WebKitWebView *wv);
 gboolean domain_match(char **, const char *, const char *);
 const char * domain_get_base_for_host(const char *host);
 const char * domain_get_tld(const char *domain);
+
+DomainIndex * domain_index_new(void);
+void domain_index_free(DomainIndex *);
+gboolean domain_index_add(DomainIndex *, const char *, guint);
+gboolean domain_index_remove(DomainIndex *, const char *, guint);
+void domain_index_clear(DomainIndex *, guint);
+guint domain_index_lookup(DomainIndex *, const char *);
+guint domain_index_match_host(DomainIndex *, const char *);
+gboolean domain_index_match_cookie_domain(DomainIndex *, const char *);
 #endif
@@ -82,13 +82,13 @@ download_spawn_external(const char *uri, const char *filename, WebKitDownload *d
     GError *error = NULL;
     char *newcommand = NULL;
 
-    char *command = g_strdup(GET_CHAR("download-external-command"));
+    char *command = g_strdup(GET_CHAR(SETTINGS_DOWNLOAD_EXTERNAL_COMMAND));
     WebKitNetworkRequest *request = webkit_download_get_network_request(download);
     const char *referer = soup_get_header_from_request(request, "Referer");
     const char *user_agent = soup_get_header_from_request(request, "User-Agent");
 
-    char *proxy = GET_CHAR("proxy-url");
-    gboolean has_proxy = GET_BOOL("proxy");
+    char *proxy = GET_CHAR(SETTINGS_PROXY_URL);
+    gboolean has_proxy = GET_BOOL(SETTINGS_PROXY);
 
     char **envp = g_get_environ();
     envp = g_environ_setenv(envp, "DWB_URI", uri, true);
@@ -421,7 +421,7 @@ download_add_progress_label(GList *gl, const char *filename, gint length)
     gtk_box_pack_start(GTK_BOX(hbox), l->rlabel, false, false, 1);
 
     GtkWidget *alignment = gtk_alignment_new(0.5, 0.5, 1, 1);
-    int padding = GET_INT("bars-padding");
+    int padding = GET_INT(SETTINGS_BARS_PADDING);
     gtk_alignment_set_padding(GTK_ALIGNMENT(alignment), padding, padding, padding, padding);
     gtk_container_add(GTK_CONTAINER(alignment), hbox);
     gtk_container_add(GTK_CONTAINER(l->event), alignment);
@@ -527,7 +527,7 @@ download_start(const char *path)
     char *tmppath = NULL;
     const char *last_slash;
     char path_buffer[PATH_MAX];
-    gboolean external = GET_BOOL("download-use-external-program");
+    gboolean external = GET_BOOL(SETTINGS_DOWNLOAD_USE_EXTERNAL_PROGRAM);
 
     char buffer[PATH_MAX];
     path = util_expand_home(buffer, path, sizeof(buffer));
@@ -652,7 +652,7 @@ static void
 download_entry_set_directory() 
 {
     dwb_set_normal_message(dwb.state.fview, false, "Downloadpath:");
-    char *default_dir = GET_CHAR("download-directory");
+    char *default_dir = GET_CHAR(SETTINGS_DOWNLOAD_DIRECTORY);
     char *current_dir = NULL, *new_dir = NULL;
     if (default_dir != NULL) 
     {
@@ -703,8 +703,8 @@ download_get_path(GList *gl, WebKitDownload *d)
         return;
     }
     dwb.state.download = d;
-    path = GET_CHAR("download-directory");
-    if (path != NULL && g_file_test(path, G_FILE_TEST_IS_DIR) && GET_BOOL("download-no-confirm")) 
+    path = GET_CHAR(SETTINGS_DOWNLOAD_DIRECTORY);
+    if (path != NULL && g_file_test(path, G_FILE_TEST_IS_DIR) && GET_BOOL(SETTINGS_DOWNLOAD_NO_CONFIRM)) 
         download_start(path);
     else 
     {
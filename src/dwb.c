@@ -55,6 +55,8 @@
 #include "ipc.h"
 #include "plugindb.h"
 #include "secret.h"
+#include "journal.h"
+#include "requestpolicy.h"
 
 #ifndef DISABLE_HSTS
 #include "hsts.h"
@@ -73,6 +75,9 @@ static DwbStatus dwb_set_history_length(GList *, WebSettings *);
 static DwbStatus dwb_set_plugin_blocker(GList *, WebSettings *);
 static DwbStatus dwb_set_sync_interval(GList *, WebSettings *);
 static DwbStatus dwb_set_sync_files(GList *, WebSettings *);
+static DwbStatus dwb_set_shared_files(GList *, WebSettings *);
+static DwbStatus dwb_set_hibernate_timeout(GList *, WebSettings *);
+static DwbStatus dwb_set_hibernate_max_tabs(GList *, WebSettings *);
 static DwbStatus dwb_set_scroll_step(GList *, WebSettings *);
 static DwbStatus dwb_set_private_browsing(GList *, WebSettings *);
 static DwbStatus dwb_set_new_tab_position_policy(GList *, WebSettings *);
@@ -158,6 +163,24 @@ static int signals[] = { SIGFPE, SIGILL, SIGINT, SIGQUIT, SIGTERM, SIGALRM, SIGS
 #ifndef _HAS_GTK3
 static int s_tab_allocate_id;
 #endif
+static Journal *s_history_journal;
+static guint s_status_update_id;
+/* Color of the uri label, NULL if it is unknown */
+static DwbColor *s_uri_color;
+static GPtrArray *s_tabs;
+
+/* Keymaps and custom commands indexed by modifier and key sequence, every node
+ * holds all bindings that start with the path to the node */
+typedef struct _KeyTrie KeyTrie;
+struct _KeyTrie {
+    char c;
+    KeyTrie *child;
+    KeyTrie *next;
+    GSList *maps;
+    GSList *commands;
+};
+static GHashTable *s_key_tries;
+static GHashTable *s_override_tries;
 /*}}}*/
 
 #include "config.h"
@@ -280,7 +303,7 @@ dwb_set_tab_orientation(GList *gl, WebSettings *s)
         return STATUS_ERROR;
     if (! (s->apply & SETTING_INITIALIZE))
     {
-        dwb_pack(GET_CHAR("widget-packing"), true);
+        dwb_pack(GET_CHAR(SETTINGS_WIDGET_PACKING), true);
     }
 
     return STATUS_OK;
@@ -288,7 +311,7 @@ dwb_set_tab_orientation(GList *gl, WebSettings *s)
 static DwbStatus
 dwb_set_tab_width(GList *gl, WebSettings *s) 
 {
-    return dwb_pack(GET_CHAR("widget-packing"), true);
+    return dwb_pack(GET_CHAR(SETTINGS_WIDGET_PACKING), true);
 }
 #endif
 static DwbStatus
@@ -521,6 +544,60 @@ dwb_set_sync_files(GList *gl, WebSettings *s)
     return ret;
 }/*}}}*/
 
+/* dwb_set_shared_files{{{*/
+static DwbStatus
+dwb_set_shared_files(GList *gl, WebSettings *s) 
+{
+    dwb_share_files(s->arg_local.b);
+    return STATUS_OK;
+}/*}}}*/
+
+/* dwb_hibernate_tabs {{{*/
+static gboolean
+dwb_hibernate_tabs(gpointer data)
+{
+    view_hibernate_idle(dwb.misc.hibernate_timeout, dwb.misc.hibernate_max_tabs);
+    return true;
+}/*}}}*/
+
+/* dwb_update_hibernate_timer {{{*/
+static void
+dwb_update_hibernate_timer()
+{
+    if (dwb.misc.hibernate_timeout > 0 || dwb.misc.hibernate_max_tabs > 0)
+    {
+        if (dwb.misc.hibernatetimer == 0)
+            dwb.misc.hibernatetimer = g_timeout_add_seconds(HIBERNATE_INTERVAL, dwb_hibernate_tabs, NULL);
+    }
+    else if (dwb.misc.hibernatetimer > 0)
+    {
+        g_source_remove(dwb.misc.hibernatetimer);
+        dwb.misc.hibernatetimer = 0;
+    }
+}/*}}}*/
+
+/* dwb_set_hibernate_timeout{{{*/
+static DwbStatus
+dwb_set_hibernate_timeout(GList *gl, WebSettings *s) 
+{
+    if (s->arg_local.i < 0)
+        return STATUS_ERROR;
+    dwb.misc.hibernate_timeout = s->arg_local.i;
+    dwb_update_hibernate_timer();
+    return STATUS_OK;
+}/*}}}*/
+
+/* dwb_set_hibernate_max_tabs{{{*/
+static DwbStatus
+dwb_set_hibernate_max_tabs(GList *gl, WebSettings *s) 
+{
+    if (s->arg_local.i < 0)
+        return STATUS_ERROR;
+    dwb.misc.hibernate_max_tabs = s->arg_local.i;
+    dwb_update_hibernate_timer();
+    return STATUS_OK;
+}/*}}}*/
+
 /* dwb_set_scroll_step {{{*/
 static DwbStatus
 dwb_set_scroll_step(GList *gl, WebSettings *s) 
@@ -602,14 +679,22 @@ dwb_set_favicon(GList *l, WebSettings *s)
     {
         for (GList *l = dwb.state.views; l; l=l->next) 
         {
-            g_signal_handler_disconnect(WEBVIEW(l), VIEW(l)->status->signals[SIG_ICON_LOADED]);
+            if (VIEW(l)->status->signals[SIG_ICON_LOADED] > 0) 
+            {
+                g_signal_handler_disconnect(WEBVIEW(l), VIEW(l)->status->signals[SIG_ICON_LOADED]);
+                VIEW(l)->status->signals[SIG_ICON_LOADED] = 0;
+            }
             view_set_favicon(l, false);
         }
     }
     else 
     {
+        /* Hibernated tabs connect when they are woken up */
         for (GList *l = dwb.state.views; l; l=l->next) 
-            VIEW(l)->status->signals[SIG_ICON_LOADED] = g_signal_connect(VIEW(l)->web, "icon-loaded", G_CALLBACK(view_icon_loaded), l);
+        {
+            if (VIEW(l)->status->hibernation == NULL && VIEW(l)->status->signals[SIG_ICON_LOADED] == 0)
+                VIEW(l)->status->signals[SIG_ICON_LOADED] = g_signal_connect(VIEW(l)->web, "icon-loaded", G_CALLBACK(view_icon_loaded), l);
+        }
     }
     return STATUS_OK;
 }/*}}}*/
@@ -831,7 +916,9 @@ dwb_emit_status_signal(GList *gl, const char *type)
     if (EMIT_SCRIPT(STATUS_BAR)) 
     {
         /** 
-         * Emitted before the status bar is updated.          
+         * Emitted before the status bar is updated. Updates caused by
+         * scrolling, progress or title changes are coalesced, so the signal
+         * is emitted at most once per frame for these.
          * @event statusBarChange
          * @memberOf signals
          * @param {signals~onStatusBarChange} callback
@@ -874,37 +961,55 @@ dwb_emit_status_signal(GList *gl, const char *type)
         const char *uri = webkit_web_view_get_uri(WEBVIEW(gl));
         gboolean has_quickmark = g_list_find_custom(dwb.fc.quickmarks, uri, (GCompareFunc)util_quickmark_compare_uri) != NULL;
         gboolean has_bookmark = g_list_find_custom(dwb.fc.bookmarks, uri, (GCompareFunc)util_navigation_compare_uri) != NULL;
-        char *json = util_create_json(8, 
-                CHAR, "ssl", v->status->ssl == SSL_TRUSTED 
+        JSObjectRef payload = scripts_create_payload(8, 
+                CHAR, JS_PROP_SSL, v->status->ssl == SSL_TRUSTED 
                 ? "trusted" : v->status->ssl == SSL_UNTRUSTED 
                 ? "untrusted" : "none",
-                BOOLEAN, "canGoBack", back,
-                BOOLEAN, "canGoForward", forward, 
-                BOOLEAN, "isBookmarked", has_bookmark, 
-                BOOLEAN, "isQuickmarked", has_quickmark, 
-                CHAR, "type", type, 
-                BOOLEAN, "scriptsBlocked", (v->status->scripts & SCRIPTS_BLOCKED) != 0, 
-                BOOLEAN, "pluginBlocked", (v->plugins->status & PLUGIN_STATUS_ENABLED) != 0 && 
+                BOOLEAN, JS_PROP_CAN_GO_BACK, back,
+                BOOLEAN, JS_PROP_CAN_GO_FORWARD, forward, 
+                BOOLEAN, JS_PROP_IS_BOOKMARKED, has_bookmark, 
+                BOOLEAN, JS_PROP_IS_QUICKMARKED, has_quickmark, 
+                CHAR, JS_PROP_TYPE, type, 
+                BOOLEAN, JS_PROP_SCRIPTS_BLOCKED, (v->status->scripts & SCRIPTS_BLOCKED) != 0, 
+                BOOLEAN, JS_PROP_PLUGIN_BLOCKED, (v->plugins->status & PLUGIN_STATUS_ENABLED) != 0 && 
                 (v->plugins->status & PLUGIN_STATUS_HAS_PLUGIN) != 0);
-        ScriptSignal signal = { SCRIPTS_WV(gl), SCRIPTS_SIG_META(json, STATUS_BAR, 0) };
+        ScriptSignal signal = { SCRIPTS_WV(gl), SCRIPTS_SIG_PAYLOAD(payload, STATUS_BAR, 0) };
         ret = scripts_emit(&signal);
-        g_free(json);
     }
     return ret;
 }
+/* dwb_set_uri_label(const char *text, DwbColor *color) {{{*/
+/*
+ * Sets the uri label, the label is only changed if text or color differ
+ * */
+void 
+dwb_set_uri_label(const char *text, DwbColor *color) 
+{
+    if (color != s_uri_color || g_strcmp0(gtk_label_get_label(GTK_LABEL(dwb.gui.urilabel)), text)) 
+    {
+        dwb_set_status_bar_text(dwb.gui.urilabel, text, color, NULL, false);
+        s_uri_color = color;
+    }
+}/*}}}*/
+
 void 
 dwb_update_uri(GList *gl, gboolean emit_signal) 
 {
     if (gl != dwb.state.fview)
         return;
 
-    if (emit_signal && dwb_emit_status_signal(gl, "uri"))
+    if (emit_signal && dwb_emit_status_signal(gl, "uri")) 
+    {
+        // the label may have been changed by a script
+        s_uri_color = NULL;
         return;
+    }
 
     View *v = VIEW(gl);
 
     const char *uri = webkit_web_view_get_uri(CURRENT_WEBVIEW());
     char *decoded = g_uri_unescape_string(uri, "\n\r\f");
+    const char *text = decoded ? decoded : uri;
 
     DwbColor *uricolor;
     switch(v->status->ssl) 
@@ -916,7 +1021,7 @@ dwb_update_uri(GList *gl, gboolean emit_signal)
         default:            uricolor = &dwb.color.active_fg; 
                             break;
     }
-    dwb_set_status_bar_text(dwb.gui.urilabel, decoded ? decoded : uri, uricolor, NULL, false);
+    dwb_set_uri_label(text, uricolor);
     g_free(decoded);
 }
 
@@ -924,6 +1029,8 @@ dwb_update_uri(GList *gl, gboolean emit_signal)
 void 
 dwb_update_status_text(GList *gl, GtkAdjustment *a) 
 {
+    VIEW(gl)->status->pending_update &= ~STATUS_UPDATE_TEXT;
+
     if (gl != dwb.state.fview)
         return;
 
@@ -945,7 +1052,7 @@ dwb_update_status_text(GList *gl, GtkAdjustment *a)
     const char *bof = back && forward ? " [-+]" : back ? " [-]" : forward  ? " [+]" : " ";
     g_string_append(string, bof);
 
-    g_string_append_printf(string, "[%d/%d]", g_list_position(dwb.state.views, dwb.state.fview) + 1, g_list_length(dwb.state.views));
+    g_string_append_printf(string, "[%d/%d]", dwb_tab_index(dwb.state.fview) + 1, dwb_tab_count());
 
     if (a) 
     {
@@ -1021,7 +1128,7 @@ dwb_update_status_text(GList *gl, GtkAdjustment *a)
 
         g_string_append_printf(string, "%lc<span foreground='%s'>%ls</span><span foreground='%s'>%ls</span>%lc", bar_blocks[0], dwb.color.progress_full, buffer, dwb.color.progress_empty, cbuffer, bar_blocks[3]);
     }
-    if (string->len > 0) 
+    if (string->len > 0 && g_strcmp0(gtk_label_get_label(GTK_LABEL(dwb.gui.rstatus)), string->str)) 
         dwb_set_status_bar_text(dwb.gui.rstatus, string->str, NULL, NULL, true);
 
     g_string_free(string, true);
@@ -1052,7 +1159,7 @@ dwb_scheme_handler(GList *gl, WebKitNetworkRequest *request)
     GError *error = NULL;
     DwbStatus ret = STATUS_OK;
 
-    const char *handler = GET_CHAR("scheme-handler");
+    const char *handler = GET_CHAR(SETTINGS_SCHEME_HANDLER);
     if (handler == NULL) 
     {
         dwb_set_error_message(gl, "No scheme handler defined");
@@ -1089,7 +1196,7 @@ dwb_scheme_handler(GList *gl, WebKitNetworkRequest *request)
     const char *user_agent = soup_get_header_from_request(request, "User-Agent");
     if (user_agent)
         envp = g_environ_setenv(envp, "DWB_USER_AGENT", user_agent, true);
-    const char *proxy = GET_CHAR("proxy-url");
+    const char *proxy = GET_CHAR(SETTINGS_PROXY_URL);
     if (proxy)
         envp = g_environ_setenv(envp, "DWB_PROXY", proxy, true);
 
@@ -1409,7 +1516,15 @@ dwb_remove_download(const char *line)
 void
 dwb_remove_history(const char *line) 
 {
-    dwb_remove_navigation_item(&dwb.fc.history, line, dwb.misc.synctimer <= 0 ? dwb.files[FILES_HISTORY] : NULL);
+    if (s_history_journal != NULL) 
+    {
+        Navigation *n = dwb_navigation_new_from_line(line);
+        if (dwb_remove_navigation_item(&dwb.fc.history, line, NULL) && n != NULL)
+            journal_append(s_history_journal, JOURNAL_REMOVE, n->first);
+        dwb_navigation_free(n);
+    }
+    else 
+        dwb_remove_navigation_item(&dwb.fc.history, line, dwb.misc.synctimer <= 0 ? dwb.files[FILES_HISTORY] : NULL);
 }
 void
 dwb_remove_search_engine(const char *line) 
@@ -1446,33 +1561,130 @@ dwb_remove_quickmark(const char *line)
 }/*}}}*/
 
 static void
-dwb_sync_history()
+dwb_write_history(gpointer data)
+{
+    GString *buffer = g_string_new(NULL);
+    int i=0;
+    for (GList *gl = dwb.fc.history; gl && (dwb.misc.history_length < 0 || i < dwb.misc.history_length); gl=gl->next, i++) 
+    {
+        Navigation *n = gl->data;
+        g_string_append_printf(buffer, "%s %s\n", n->first, n->second);
+    }
+    g_file_set_contents(dwb.files[FILES_HISTORY], buffer->str, -1, NULL);
+    g_string_free(buffer, true);
+}
+/* If the history is shared it is only rewritten if force is true or the
+ * journal has grown too large */
+static void
+dwb_sync_history(gboolean force)
 {
     if (dwb.misc.sync_files & SYNC_HISTORY) 
     {
-        GString *buffer = g_string_new(NULL);
-        int i=0;
-        for (GList *gl = dwb.fc.history; gl && (dwb.misc.history_length < 0 || i < dwb.misc.history_length); gl=gl->next, i++) 
-        {
-            Navigation *n = gl->data;
-            g_string_append_printf(buffer, "%s %s\n", n->first, n->second);
-        }
-        g_file_set_contents(dwb.files[FILES_HISTORY], buffer->str, -1, NULL);
-        g_string_free(buffer, true);
+        if (s_history_journal != NULL)
+            journal_compact(s_history_journal, dwb_write_history, force);
+        else 
+            dwb_write_history(NULL);
+    }
+}
+/* dwb_history_add_item(Navigation *) {{{*/
+void
+dwb_history_add_item(Navigation *n) 
+{
+    if (s_history_journal != NULL) 
+    {
+        char *line = g_strdup_printf("%s %s", n->first, n->second != NULL ? n->second : "");
+        journal_append(s_history_journal, JOURNAL_ADD, line);
+        g_free(line);
+    }
+    else if (dwb.misc.sync_interval <= 0) 
+        util_file_add_navigation(dwb.files[FILES_HISTORY], n, false, dwb.misc.history_length);
+}/*}}}*/
+/* dwb_clear_history() {{{*/
+void
+dwb_clear_history() 
+{
+    dwb_free_list(dwb.fc.history, (void_func)dwb_navigation_free);
+    dwb.fc.history = NULL;
+    remove(dwb.files[FILES_HISTORY]);
+    if (s_history_journal != NULL)
+        journal_append(s_history_journal, JOURNAL_CLEAR, NULL);
+}/*}}}*/
+static void
+dwb_history_journal_apply(char op, const char *data, gpointer user_data) 
+{
+    Navigation *n;
+    switch (op) 
+    {
+        case JOURNAL_ADD: 
+            if ((n = dwb_navigation_new_from_line(data)) != NULL) 
+            {
+                dwb_prepend_navigation_with_argument(&dwb.fc.history, n->first, n->second);
+                dwb_navigation_free(n);
+            }
+            break;
+        case JOURNAL_REMOVE: 
+            for (GList *l = dwb.fc.history; l; l=l->next) 
+            {
+                if (!g_strcmp0(NAVIGATION(l)->first, data)) 
+                {
+                    dwb_navigation_free(l->data);
+                    dwb.fc.history = g_list_delete_link(dwb.fc.history, l);
+                    break;
+                }
+            }
+            break;
+        case JOURNAL_CLEAR: 
+            dwb_free_list(dwb.fc.history, (void_func)dwb_navigation_free);
+            dwb.fc.history = NULL;
+            break;
+        case JOURNAL_READ: 
+            /* Replayed items are prepended, the oldest items exceeding
+             * history-length are dropped */
+            if (dwb.misc.history_length >= 0) 
+            {
+                GList *last = g_list_nth(dwb.fc.history, dwb.misc.history_length);
+                if (last != NULL) 
+                {
+                    if (last->prev != NULL)
+                        last->prev->next = NULL;
+                    else 
+                        dwb.fc.history = NULL;
+                    last->prev = NULL;
+                    dwb_free_list(last, (void_func)dwb_navigation_free);
+                }
+            }
+            break;
+        default: 
+            break;
     }
 }
+/* dwb_share_files(gboolean share) {{{*/
+/* Shares history and cookies with other instances */
+void
+dwb_share_files(gboolean share) 
+{
+    if (share && s_history_journal == NULL) 
+        s_history_journal = journal_new(dwb.files[FILES_HISTORY], dwb_history_journal_apply, NULL);
+    else if (!share && s_history_journal != NULL) 
+    {
+        journal_compact(s_history_journal, dwb_write_history, true);
+        journal_free(s_history_journal);
+        s_history_journal = NULL;
+    }
+    dwb_soup_share_cookies(share);
+}/*}}}*/
 static void 
 dwb_sync_cookies()
 {
     if (dwb.misc.sync_files & SYNC_COOKIES) 
     {
-        dwb_soup_sync_cookies();
+        dwb_soup_sync_cookies(false);
     }
 }
 static void
 dwb_sync_session()
 {
-    if ((dwb.misc.sync_files & SYNC_SESSION) && GET_BOOL("save-session")) 
+    if ((dwb.misc.sync_files & SYNC_SESSION) && GET_BOOL(SETTINGS_SAVE_SESSION)) 
     {
         session_save(NULL, SESSION_SYNC | SESSION_FORCE);
     }
@@ -1481,7 +1693,7 @@ dwb_sync_session()
 static gboolean
 dwb_sync_files(gpointer data) 
 {
-    dwb_sync_history();
+    dwb_sync_history(false);
     dwb_sync_cookies();
     dwb_sync_session();
     return true;
@@ -1701,14 +1913,14 @@ dwb_limit_tabs(gint max)
     int length, n, i = 0;
     int m, median;
 
-    length = g_list_length(dwb.state.views);
+    length = dwb_tab_count();
 
     if (length == 1)
         return;
 
     m = max/2+1;
     median = max % 2 == 0 ? max/2 : m;
-    n = g_list_position(dwb.state.views, dwb.state.fview);
+    n = dwb_tab_index(dwb.state.fview);
     for (GList *l = dwb.state.views; l; l=l->next, i++)
     {
         if ((n < median && i<max) || 
@@ -1733,7 +1945,7 @@ dwb_focus_view(GList *gl, const char *event)
     static int running;
     if (gl != dwb.state.fview) 
     {
-        IPC_SEND_HOOK(focus_tab, "%d", g_list_position(dwb.state.views, gl) + 1);
+        IPC_SEND_HOOK(focus_tab, "%d", dwb_tab_index(gl) + 1);
         if (EMIT_SCRIPT(TAB_FOCUS)) 
         {
             /**
@@ -1794,65 +2006,74 @@ dwb_focus_view(GList *gl, const char *event)
     return true;
 }/*}}}*/
 
-/* dwb_toggle_allowed(const char *filename, const char *data) {{{*/
+/* dwb_domain_entry(char *line) {{{*/
+/* Returns the whitelist entry of a line or NULL for blank lines and comments,
+ * the line is stripped in place */
+static const char *
+dwb_domain_entry(char *line) 
+{
+    line = g_strstrip(line);
+    if (*line == '\0' || *line == '#')
+        return NULL;
+    return line;
+}/*}}}*/
+
+/* dwb_toggle_allowed(const char *filename, const char *data, DomainIndex *) {{{*/
 gboolean 
-dwb_toggle_allowed(const char *filename, const char *data, GList **pers) 
+dwb_toggle_allowed(const char *filename, const char *data, DomainIndex *index) 
 {
     if (!data)
         return false;
 
-    char *content = util_get_file_content(filename, NULL);
-    char **lines = NULL;
+    char **lines = util_get_lines(filename);
+    char *line;
+    const char *entry;
     gboolean allowed = false;
-    GString *buffer;
+    GString *buffer = g_string_new(NULL);
 
-    if (content != NULL) 
+    if (lines != NULL)  
     {
-        lines = util_get_lines(filename);
-        if (lines != NULL)  
+        for (int i=0; lines[i] != NULL; i++) 
         {
-            for (int i=0; lines[i] != NULL; i++) 
-            {
-                if (!g_strcmp0(lines[i], data)) 
-                {
-                    allowed = true;
-                    break;
-                }
-            } 
-        }
-    }
-    buffer = g_string_new(NULL);
-    if (!allowed) 
-    {
-        if (content) 
-            g_string_append(buffer, content);
-
-        g_string_append_printf(buffer, "%s\n", data);
-        *pers = g_list_prepend(*pers, g_strdup(data));
-        g_strfreev(lines);
+            line = g_strdup(lines[i]);
+            allowed = !g_strcmp0(dwb_domain_entry(line), data);
+            g_free(line);
+            if (allowed)
+                break;
+        } 
     }
-    else if (content) 
+    /* The file may have been changed by another instance, so the persistent
+     * entries are rebuilt from its current content, comments and blank lines
+     * are kept in place */
+    domain_index_clear(index, DOMAIN_INDEX_PERSISTENT);
+    if (lines != NULL) 
     {
-        if (pers != NULL) 
+        for (int i=0; lines[i] != NULL; i++) 
         {
-            dwb_free_list(*pers, (void_func)g_free);
-            *pers = NULL;
-            if (lines != NULL) 
+            /* the content after the last newline */
+            if (lines[i+1] == NULL && *lines[i] == '\0')
+                break;
+            line = g_strdup(lines[i]);
+            entry = dwb_domain_entry(line);
+            if (entry != NULL && allowed && !g_strcmp0(entry, data)) 
             {
-                for (int i=0; lines[i] != NULL; i++) 
-                {
-                    if (strlen(lines[i]) && g_strcmp0(lines[i], data)) 
-                    {
-                        g_string_append_printf(buffer, "%s\n", lines[i]);
-                        *pers = g_list_prepend(*pers, lines[i]);
-                    }
-                }
+                g_free(line);
+                continue;
             }
+            if (entry != NULL)
+                domain_index_add(index, entry, DOMAIN_INDEX_PERSISTENT);
+            g_string_append_printf(buffer, "%s\n", lines[i]);
+            g_free(line);
         }
     }
+    if (!allowed) 
+    {
+        g_string_append_printf(buffer, "%s\n", data);
+        domain_index_add(index, data, DOMAIN_INDEX_PERSISTENT);
+    }
     g_file_set_contents(filename, buffer->str, -1, NULL);
 
-    g_free(content);
+    g_strfreev(lines);
     g_string_free(buffer, true);
 
     return !allowed;
@@ -1962,6 +2183,7 @@ dwb_clean_load_begin(GList *gl)
 
     CLEAR_MARKS(VIEW(gl));
     view_set_favicon(gl, false);
+    request_policy_reset(gl);
 }/*}}}*/
 
 /* dwb_navigation_from_webkit_history_item(WebKitWebHistoryItem *)   return: (alloc) Navigation* {{{*/
@@ -1986,7 +2208,8 @@ void
 dwb_unfocus() 
 {
     if (dwb.state.fview) {
-        dwb.state.last_tab = g_list_position(dwb.state.views, dwb.state.fview);
+        dwb.state.last_tab = dwb_tab_index(dwb.state.fview);
+        CURRENT_VIEW()->status->last_focus = g_get_monotonic_time();
         view_set_normal_style(dwb.state.fview);
         dwb_source_remove();
         CLEAR_COMMAND_TEXT();
@@ -2012,7 +2235,7 @@ dwb_focus_scroll(GList *gl)
 
 /* dwb_handle_mail(const char *uri)        return: true if it is a mail-address{{{*/
 gboolean 
-dwb_spawn(GList *gl, const char *prop, const char *uri) 
+dwb_spawn(GList *gl, int prop, const char *uri) 
 {
     const char *program;
     char *command;
@@ -2049,6 +2272,8 @@ dwb_reload_layout(GList *gl, WebSettings *s)
     dwb_init_style();
     dwb_update_tabs();
     dwb_apply_style();
+    if (dwb.state.fview != NULL)
+        dwb_update_uri(dwb.state.fview, false);
     return STATUS_OK;
 }/*}}}*/
 
@@ -2060,7 +2285,7 @@ dwb_get_search_engine_uri(const char *uri, const char *text)
     GRegex *regex;
     if (uri != NULL && text != NULL) 
     {
-        hint_search_submit = GET_CHAR("searchengine-submit-pattern");
+        hint_search_submit = GET_CHAR(SETTINGS_SEARCHENGINE_SUBMIT_PATTERN);
         if (hint_search_submit == NULL) 
             hint_search_submit = HINT_SEARCH_SUBMIT;
 
@@ -2120,7 +2345,7 @@ dwb_submit_searchengine(void)
 {
     char buffer[64];
     char *value;
-    char *hint_search_submit = GET_CHAR("searchengine-submit-pattern");
+    char *hint_search_submit = GET_CHAR(SETTINGS_SEARCHENGINE_SUBMIT_PATTERN);
     if (hint_search_submit == NULL) 
         hint_search_submit = HINT_SEARCH_SUBMIT;
     snprintf(buffer, sizeof(buffer), "{ \"searchString\" : \"%s\" }", hint_search_submit);
@@ -2254,7 +2479,7 @@ dwb_evaluate_hints(const char *buffer)
     }
     else if  (!g_strcmp0(event, "_dwb_click_") && HINT_NOT_RAPID ) 
     {
-        int timeout = GET_INT("hints-key-lock");
+        int timeout = GET_INT(SETTINGS_HINTS_KEY_LOCK);
         if (timeout > 0) 
         {
             dwb.state.scriptlock = 1;
@@ -2696,22 +2921,28 @@ dwb_tab_label_set_text(GList *gl, const char *text)
     char progress[11] = { 0 };
     char *escaped;
 
-    if (text == NULL) 
-        title = webkit_web_view_get_title(WEBVIEW(gl));
-    else 
+    if (text != NULL) 
         title = text;
+    else if (v->status->hibernation != NULL) 
+    {
+        Navigation *n = v->status->hibernation->current;
+        title = n->second != NULL && *n->second != '\0' ? n->second : n->first;
+    }
+    else 
+        title = webkit_web_view_get_title(WEBVIEW(gl));
 
     if (v->status->progress != 0) 
         snprintf(progress, sizeof(progress), "[%2d%%] ", v->status->progress);
 
     escaped = g_markup_printf_escaped("<span foreground='%s'>%d%s</span> %s%s%s", 
             LP_PROTECTED(v) ? dwb.color.tab_protected_color : dwb.color.tab_number_color,
-            g_list_position(dwb.state.views, gl) + 1, 
+            dwb_tab_index(gl) + 1, 
             LP_VISIBLE(v) ? "*" : "",
             progress,
             v->status->deferred ? "*" : "",
             title ? title : "---");
-    gtk_label_set_markup(GTK_LABEL(v->tablabel), escaped);
+    if (g_strcmp0(gtk_label_get_label(GTK_LABEL(v->tablabel)), escaped))
+        gtk_label_set_markup(GTK_LABEL(v->tablabel), escaped);
 
     g_free(escaped);
 }/*}}}*/
@@ -2721,8 +2952,11 @@ void
 dwb_update_status(GList *gl, const char *title) 
 {
     View *v = gl->data;
-    char *filename = NULL, *text;
+    char *filename = NULL, *text = NULL;
     WebKitWebView *w = WEBKIT_WEB_VIEW(v->web);
+
+    v->status->pending_update = 0;
+
     if (title == NULL)
         title = webkit_web_view_get_title(w);
     if (!title) 
@@ -2731,13 +2965,11 @@ dwb_update_status(GList *gl, const char *title)
     if (gl == dwb.state.fview) 
     {
         if (v->status->progress != 0) 
-        {
             text = g_strdup_printf("[%d%%] %s", v->status->progress, title);
-            gtk_window_set_title(GTK_WINDOW(dwb.gui.window), text);
-            g_free(text);
-        }
-        else 
-            gtk_window_set_title(GTK_WINDOW(dwb.gui.window), title);
+
+        if (g_strcmp0(gtk_window_get_title(GTK_WINDOW(dwb.gui.window)), text ? text : title))
+            gtk_window_set_title(GTK_WINDOW(dwb.gui.window), text ? text : title);
+        g_free(text);
 
         dwb_update_status_text(gl, NULL);
     }
@@ -2746,6 +2978,76 @@ dwb_update_status(GList *gl, const char *title)
     g_free(filename);
 }/*}}}*/
 
+static gboolean
+dwb_flush_status_updates(gpointer unused) 
+{
+    s_status_update_id = 0;
+    for (GList *gl = dwb.state.views; gl; gl=gl->next) 
+    {
+        unsigned int pending = VIEW(gl)->status->pending_update;
+        if (pending & STATUS_UPDATE_ALL) 
+            dwb_update_status(gl, NULL);
+        else if (pending & STATUS_UPDATE_TEXT) 
+            dwb_update_status_text(gl, NULL);
+    }
+    return false;
+}
+/* dwb_queue_status_update(GList *gl, StatusUpdate update) {{{*/
+/* Marks the status of a view as dirty, all dirty views are updated once the
+ * interval has passed so that scrolling or progress changes don't update
+ * the statusbar more than once per frame. */
+void 
+dwb_queue_status_update(GList *gl, StatusUpdate update) 
+{
+    VIEW(gl)->status->pending_update |= update;
+    if (s_status_update_id == 0) 
+        s_status_update_id = g_timeout_add(STATUS_UPDATE_INTERVAL, dwb_flush_status_updates, NULL);
+}/*}}}*/
+
+/* TABS {{{*/
+/* dwb_tabs_reindex() {{{*/
+/* Must be called whenever a view is inserted, removed or moved in
+ * dwb.state.views, so that positions and nth-lookups don't have to walk the
+ * list */
+void 
+dwb_tabs_reindex() 
+{
+    int i = 0;
+    if (s_tabs == NULL) 
+        s_tabs = g_ptr_array_new();
+
+    g_ptr_array_set_size(s_tabs, 0);
+    for (GList *gl = dwb.state.views; gl; gl=gl->next, i++) 
+    {
+        VIEW(gl)->index = i;
+        g_ptr_array_add(s_tabs, gl);
+    }
+}/*}}}*/
+
+/* dwb_tab_index(GList *gl)     return: position of the tab or -1 {{{*/
+int 
+dwb_tab_index(GList *gl) 
+{
+    return gl != NULL ? VIEW(gl)->index : -1;
+}/*}}}*/
+
+/* dwb_tab_nth(int n)           return: GList* or NULL {{{*/
+GList * 
+dwb_tab_nth(int n) 
+{
+    if (s_tabs == NULL || n < 0 || (guint)n >= s_tabs->len)
+        return NULL;
+    return g_ptr_array_index(s_tabs, n);
+}/*}}}*/
+
+/* dwb_tab_count()              return: number of tabs {{{*/
+guint 
+dwb_tab_count() 
+{
+    return s_tabs != NULL ? s_tabs->len : 0;
+}/*}}}*/
+/*}}}*/
+
 /* dwb_update_layout(GList *gl) {{{*/
 void 
 dwb_update_layout() 
@@ -2766,9 +3068,12 @@ void
 dwb_focus(GList *gl) 
 {
     dwb.state.fview = gl;
+    VIEW(gl)->status->last_focus = g_get_monotonic_time();
     view_set_active_style(gl);
     dwb_focus_scroll(gl);
-    if (!VIEW(gl)->status->deferred)
+    if (VIEW(gl)->status->hibernation != NULL)
+        view_wake(gl);
+    else if (!VIEW(gl)->status->deferred)
         dwb_update_status(gl, NULL);
     else if (VIEW(gl)->status->deferred_uri) 
         webkit_web_view_load_uri(WEBVIEW(gl), VIEW(gl)->status->deferred_uri);
@@ -2830,6 +3135,9 @@ dwb_load_uri(GList *gl, const char *arg)
 
     g_return_if_fail(gl != NULL);
 
+    if (VIEW(gl)->status->hibernation != NULL)
+        view_wake(gl);
+
     WebKitWebView *web = WEBVIEW(gl);
 
     if (!g_strcmp0(tmpuri, "$URI"))
@@ -2862,7 +3170,7 @@ dwb_load_uri(GList *gl, const char *arg)
     /* Check if uri is a javascript snippet */
     if (g_str_has_prefix(tmpuri, "javascript:")) 
     {
-        if (GET_BOOL("javascript-schemes"))
+        if (GET_BOOL(SETTINGS_JAVASCRIPT_SCHEMES))
         {
             char *unescaped = g_uri_unescape_string(tmpuri, NULL);
             dwb_execute_script(webkit_web_view_get_main_frame(web), unescaped, false);
@@ -3066,6 +3374,123 @@ dwb_entry_activate(GdkEventKey *e)
     return true;
 }/*}}}*/
 
+/* KEY_TRIE {{{*/
+static void
+dwb_key_trie_free(KeyTrie *node)
+{
+    KeyTrie *next;
+    while (node != NULL) 
+    {
+        next = node->next;
+        dwb_key_trie_free(node->child);
+        g_slist_free(node->maps);
+        g_slist_free(node->commands);
+        g_slice_free(KeyTrie, node);
+        node = next;
+    }
+}
+static void
+dwb_key_trie_insert(GHashTable *roots, guint mod, const char *key, KeyMap *map, CustomCommand *command)
+{
+    KeyTrie *node, *child;
+    if ((node = g_hash_table_lookup(roots, GUINT_TO_POINTER(mod))) == NULL) 
+    {
+        node = g_slice_new0(KeyTrie);
+        g_hash_table_insert(roots, GUINT_TO_POINTER(mod), node);
+    }
+    for (; *key; key++) 
+    {
+        for (child = node->child; child != NULL && child->c != *key; child = child->next)
+            ;
+        if (child == NULL) 
+        {
+            child = g_slice_new0(KeyTrie);
+            child->c = *key;
+            child->next = node->child;
+            node->child = child;
+        }
+        node = child;
+        if (map != NULL)
+            node->maps = g_slist_prepend(node->maps, map);
+        else 
+            node->commands = g_slist_prepend(node->commands, command);
+    }
+}
+/* Bindings are prepended while inserting, restores the order of dwb.keymap */
+static void
+dwb_key_trie_reverse(KeyTrie *node)
+{
+    for (; node != NULL; node = node->next) 
+    {
+        node->maps = g_slist_reverse(node->maps);
+        node->commands = g_slist_reverse(node->commands);
+        dwb_key_trie_reverse(node->child);
+    }
+}
+static void
+dwb_key_trie_reverse_root(gpointer key, KeyTrie *root, gpointer data)
+{
+    dwb_key_trie_reverse(root->child);
+}
+static void
+dwb_key_trie_build()
+{
+    s_key_tries = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, (GDestroyNotify)dwb_key_trie_free);
+    s_override_tries = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, (GDestroyNotify)dwb_key_trie_free);
+
+    for (GSList *l = dwb.custom_commands; l; l=l->next) 
+    {
+        CustomCommand *c = l->data;
+        if (c->key->str != NULL && *c->key->str) 
+            dwb_key_trie_insert(s_key_tries, c->key->mod, c->key->str, NULL, c);
+    }
+    for (GList *l = dwb.keymap; l; l=l->next) 
+    {
+        KeyMap *km = l->data;
+        if (km->map->prop & CP_OVERRIDE_ENTRY || km->key == NULL || !*km->key) 
+            continue;
+        dwb_key_trie_insert(s_key_tries, km->mod, km->key, km, NULL);
+    }
+    for (GList *l = dwb.override_keys; l; l=l->next) 
+    {
+        KeyMap *km = l->data;
+        if (km->key != NULL && *km->key) 
+            dwb_key_trie_insert(s_override_tries, km->mod, km->key, km, NULL);
+    }
+    g_hash_table_foreach(s_key_tries, (GHFunc)dwb_key_trie_reverse_root, NULL);
+    g_hash_table_foreach(s_override_tries, (GHFunc)dwb_key_trie_reverse_root, NULL);
+}
+static KeyTrie *
+dwb_key_trie_lookup(gboolean override, guint mod, const char *key)
+{
+    KeyTrie *node;
+    if (s_key_tries == NULL) 
+        dwb_key_trie_build();
+
+    node = g_hash_table_lookup(override ? s_override_tries : s_key_tries, GUINT_TO_POINTER(mod));
+    for (; node != NULL && *key; key++) 
+    {
+        for (node = node->child; node != NULL && node->c != *key; node = node->next)
+            ;
+    }
+    return node;
+}
+/* dwb_keymap_changed() {{{*/
+/* Must be called whenever dwb.keymap, dwb.override_keys or
+ * dwb.custom_commands is modified, the tries are rebuilt on the next key
+ * press */
+void
+dwb_keymap_changed()
+{
+    if (s_key_tries != NULL) 
+    {
+        g_hash_table_unref(s_key_tries);
+        g_hash_table_unref(s_override_tries);
+        s_key_tries = s_override_tries = NULL;
+    }
+}/*}}}*/
+/*}}}*/
+
 /* dwb_get_key(GdkEventKey *e, unsigned gint *mod_mask, gboolean *isprint) {{{*/
 char *
 dwb_get_key(GdkEventKey *e, unsigned int *mod_mask, gboolean *isprint) 
@@ -3112,6 +3537,7 @@ dwb_eval_key(GdkEventKey *e)
     const char *buf;
     guint longest;
     KeyMap *tmp = NULL;
+    KeyTrie *node;
     GList *coms = NULL;
 
     if (dwb.state.scriptlock) 
@@ -3190,39 +3616,33 @@ dwb_eval_key(GdkEventKey *e)
     buf = dwb.state.buffer->str;
     longest = 0;
 
-    for (GSList *l = dwb.custom_commands; l; l=l->next) 
+    scripts_clear_keymap();
+
+    if ((node = dwb_key_trie_lookup(false, mod_mask, buf)) != NULL) 
     {
-        CustomCommand *c = l->data;
-        if (c->key->num == dwb.state.nummod  && c->key->mod == mod_mask) 
+        for (GSList *l = node->commands; l; l=l->next) 
         {
-            if (!g_strcmp0(c->key->str, buf)) 
+            CustomCommand *c = l->data;
+            if (c->key->num == dwb.state.nummod) 
             {
-                for (int i=0; c->commands[i]; i++) 
+                if (c->key->str[dwb.state.buffer->len] == '\0') 
                 {
-                    if (dwb_parse_command_line(c->commands[i]) == STATUS_END) 
-                        return true;
+                    for (int i=0; c->commands[i]; i++) 
+                    {
+                        if (dwb_parse_command_line(c->commands[i]) == STATUS_END) 
+                            return true;
+                    }
+                    return true;
                 }
-                return true;
+                else 
+                    longest = 1;
             }
-            else if (g_str_has_prefix(c->key->str, buf)) 
-                longest = 1;
         }
-    }
-
-    scripts_clear_keymap();
-
-    for (GList *l = dwb.keymap; l; l=l->next) 
-    {
-        KeyMap *km = l->data;
-        if (km->map->prop & CP_OVERRIDE_ENTRY || km->key == NULL) 
-            continue;
-
-        gsize kl = strlen(km->key);
-        if (!km->key || !kl ) 
-            continue;
-
-        if (g_str_has_prefix(km->key, buf) && (mod_mask == km->mod) ) 
+        for (GSList *l = node->maps; l; l=l->next) 
         {
+            KeyMap *km = l->data;
+            gsize kl = strlen(km->key);
+
             if  (!longest || kl > longest) 
             {
                 longest = kl;
@@ -3230,9 +3650,10 @@ dwb_eval_key(GdkEventKey *e)
             }
             if (dwb.comps.autocompletion) 
             {
-                coms = g_list_append(coms, km);
+                coms = g_list_prepend(coms, km);
             }
         }
+        coms = g_list_reverse(coms);
     }
 
     /* autocompletion */
@@ -3267,17 +3688,19 @@ dwb_eval_override_key(GdkEventKey *e, CommandProperty prop)
     unsigned int mod; 
     gboolean isprint;
     gboolean ret = false;
+    KeyTrie *node;
 
     if (gtk_widget_has_focus(dwb.gui.entry) && e->keyval == GDK_KEY_BackSpace)
         entry_clear_history();
 
 #define IS_NUMMOD(X)  (((X) & DWB_NUMMOD_MASK) && ((X) & ~DWB_NUMMOD_MASK) == mod)
-    if ((key = dwb_get_key(e, &mod, &isprint)) != NULL)  
+    if ((key = dwb_get_key(e, &mod, &isprint)) != NULL && (node = dwb_key_trie_lookup(true, mod, key)) != NULL)  
     {
-        for (GList *l = dwb.override_keys; l; l=l->next) 
+        gsize length = strlen(key);
+        for (GSList *l = node->maps; l; l=l->next) 
         {
             KeyMap *m = l->data;
-            if ((m->map->prop & prop && !g_strcmp0(m->key, key) && m->mod == mod))
+            if (m->map->prop & prop && m->key[length] == '\0')
             {
                 m->map->func(m, &m->map->arg);
                 ret = true; 
@@ -3567,7 +3990,7 @@ dwb_execute_user_script(KeyMap *km, Arg *a)
     if (user_agent != NULL)
         envp = g_environ_setenv(envp, "DWB_USER_AGENT", user_agent, true);
 
-    const char *proxy = GET_CHAR("proxy-url");
+    const char *proxy = GET_CHAR(SETTINGS_PROXY_URL);
     if (proxy)
         envp = g_environ_setenv(envp, "DWB_PROXY", proxy, true);
 
@@ -3776,6 +4199,7 @@ dwb_reload_userscripts(void)
     
     g_slist_free(delete);
     dwb.keymap = g_list_concat(dwb.keymap, dwb_get_scripts());
+    dwb_keymap_changed();
     scripts_reapply();
     dwb_set_normal_message(dwb.state.fview, true, "Userscripts reloaded");
 }/*}}}*/
@@ -3822,6 +4246,7 @@ dwb_free_custom_keys()
     }
     g_slist_free(dwb.custom_commands);
     dwb.custom_commands = NULL;
+    dwb_keymap_changed();
 }
 
 /* dwb_clean_up() {{{*/
@@ -3832,6 +4257,7 @@ dwb_clean_up()
         view_clean(gl);
     g_list_free(dwb.state.views);
     dwb.state.views = NULL;
+    dwb_tabs_reindex();
     scripts_end(true);
     
 #ifndef DISABLE_HSTS
@@ -3853,6 +4279,7 @@ dwb_clean_up()
     g_list_free(dwb.keymap);
     g_list_free(dwb.override_keys);
     dwb.keymap = NULL;
+    dwb_keymap_changed();
     g_hash_table_remove_all(dwb.settings);
     g_string_free(dwb.state.buffer, true);
     g_free(dwb.misc.hints);
@@ -3860,24 +4287,27 @@ dwb_clean_up()
     dwb_clear_last_command();
 
     dwb_free_list(dwb.fc.bookmarks, (void_func)dwb_navigation_free);
+    journal_free(s_history_journal);
+    s_history_journal = NULL;
     /*  TODO sqlite */
     dwb_free_list(dwb.fc.history, (void_func)dwb_navigation_free);
     dwb_free_list(dwb.fc.searchengines, (void_func)dwb_navigation_free);
     dwb_free_list(dwb.fc.se_completion, (void_func)dwb_navigation_free);
     dwb_free_list(dwb.fc.mimetypes, (void_func)dwb_navigation_free);
     dwb_free_list(dwb.fc.quickmarks, (void_func)dwb_quickmark_free);
-    dwb_free_list(dwb.fc.cookies_allow, (void_func)g_free);
-    dwb_free_list(dwb.fc.cookies_session_allow, (void_func)g_free);
+    domain_index_free(dwb.fc.cookies_allow);
+    domain_index_free(dwb.fc.cookies_session_allow);
     dwb_free_list(dwb.fc.navigations, (void_func)g_free);
     dwb_free_list(dwb.fc.searches, (void_func)g_free);
     dwb_free_list(dwb.fc.commands, (void_func)g_free);
     dwb_free_list(dwb.misc.userscripts, (void_func)dwb_navigation_free);
-    dwb_free_list(dwb.fc.pers_plugins, (void_func)g_free);
-    dwb_free_list(dwb.fc.pers_scripts, (void_func)g_free);
+    domain_index_free(dwb.fc.plugins_allow);
+    domain_index_free(dwb.fc.scripts_allow);
     dwb_free_custom_keys();
 
     dwb_soup_end();
     adblock_end();
+    request_policy_end();
     domain_end();
 
     util_rmdir(dwb.files[FILES_CACHEDIR], true, true);
@@ -4017,17 +4447,17 @@ dwb_save_files(gboolean end_session, gint session_flags)
 {
     dwb_save_keys();
     dwb_save_settings();
-    dwb_sync_history();
-    dwb_soup_sync_cookies();
+    dwb_sync_history(true);
+    dwb_soup_sync_cookies(true);
     /* Save command history */
     if (! dwb.misc.private_browsing) 
     {
-        dwb_save_list(dwb.fc.navigations, dwb.files[FILES_NAVIGATION_HISTORY], GET_INT("navigation-history-max"));
-        dwb_save_list(dwb.fc.commands, dwb.files[FILES_COMMAND_HISTORY], GET_INT("navigation-history-max"));
-        dwb_save_list(dwb.fc.searches, dwb.files[FILES_SEARCH_HISTORY], GET_INT("navigation-history-max"));
+        dwb_save_list(dwb.fc.navigations, dwb.files[FILES_NAVIGATION_HISTORY], GET_INT(SETTINGS_NAVIGATION_HISTORY_MAX));
+        dwb_save_list(dwb.fc.commands, dwb.files[FILES_COMMAND_HISTORY], GET_INT(SETTINGS_NAVIGATION_HISTORY_MAX));
+        dwb_save_list(dwb.fc.searches, dwb.files[FILES_SEARCH_HISTORY], GET_INT(SETTINGS_NAVIGATION_HISTORY_MAX));
     }
     /* save session */
-    if ((end_session && GET_BOOL("save-session")) || (session_flags & SESSION_FORCE)) 
+    if ((end_session && GET_BOOL(SETTINGS_SAVE_SESSION)) || (session_flags & SESSION_FORCE)) 
         session_save(NULL, session_flags);
     
     return true;
@@ -4173,6 +4603,7 @@ dwb_keymap_delete(GList *gl, KeyValue key)
         }
     }
     gl = g_list_sort(gl, (GCompareFunc)util_keymap_sort_second);
+    dwb_keymap_changed();
     return gl;
 }/*}}}*/
 
@@ -4224,6 +4655,7 @@ dwb_add_key(char *keystring, char *name, char *description, Func callback, int o
     map->map = fmap;
 
     dwb.keymap = g_list_prepend(dwb.keymap, map);
+    dwb_keymap_changed();
     return map;
 }
 
@@ -4269,6 +4701,7 @@ dwb_init_key_map()
 
     dwb.keymap = g_list_concat(dwb.keymap, dwb_get_scripts());
     dwb.keymap = g_list_sort(dwb.keymap, (GCompareFunc)util_keymap_sort_second);
+    dwb_keymap_changed();
 
     g_key_file_free(keyfile);
 }/*}}}*/
@@ -4372,6 +4805,7 @@ dwb_init_settings()
         
         s->arg_local = s->arg;
         g_hash_table_insert(dwb.settings, key, s);
+        dwb.settings_table[j] = s;
 
         if (s->apply & SETTING_BUILTIN || s->apply & SETTING_ONINIT) 
         {
@@ -4402,19 +4836,19 @@ dwb_init_hints(GList *gl, WebSettings *s)
             \"hintOffsetTop\" : %d, \
             \"hintOffsetLeft\" : %d, \
             \"hintOpacity\" : \"%f\", \"hintHighlighLinks\" : %s, \"hintAutoFollow\" : %s }", 
-            GET_CHAR("hint-letter-seq"),
-            GET_CHAR("hint-font"),
-            GET_CHAR("hint-style"), 
-            GET_CHAR("hint-fg-color"), 
-            GET_CHAR("hint-bg-color"), 
-            GET_CHAR("hint-active-color"), 
-            GET_CHAR("hint-normal-color"), 
-            GET_CHAR("hint-border"), 
-            GET_INT("hint-offset-top"), 
-            GET_INT("hint-offset-left"), 
-            GET_DOUBLE("hint-opacity"),
-            GET_BOOL("hint-highlight-links") ? "true" : "false",
-            GET_BOOL("hint-autofollow") ? "true" : "false");
+            GET_CHAR(SETTINGS_HINT_LETTER_SEQ),
+            GET_CHAR(SETTINGS_HINT_FONT),
+            GET_CHAR(SETTINGS_HINT_STYLE), 
+            GET_CHAR(SETTINGS_HINT_FG_COLOR), 
+            GET_CHAR(SETTINGS_HINT_BG_COLOR), 
+            GET_CHAR(SETTINGS_HINT_ACTIVE_COLOR), 
+            GET_CHAR(SETTINGS_HINT_NORMAL_COLOR), 
+            GET_CHAR(SETTINGS_HINT_BORDER), 
+            GET_INT(SETTINGS_HINT_OFFSET_TOP), 
+            GET_INT(SETTINGS_HINT_OFFSET_LEFT), 
+            GET_DOUBLE(SETTINGS_HINT_OPACITY),
+            GET_BOOL(SETTINGS_HINT_HIGHLIGHT_LINKS) ? "true" : "false",
+            GET_BOOL(SETTINGS_HINT_AUTOFOLLOW) ? "true" : "false");
     return STATUS_OK;
 }
 
@@ -4424,45 +4858,45 @@ dwb_init_style()
 {
     /* Colors  */
     /* Statusbar */
-    DWB_COLOR_PARSE(&dwb.color.active_fg, GET_CHAR("foreground-color"));
-    DWB_COLOR_PARSE(&dwb.color.active_bg, GET_CHAR("background-color"));
-    DWB_COLOR_PARSE(&dwb.color.private_bg, GET_CHAR("private-color"));
+    DWB_COLOR_PARSE(&dwb.color.active_fg, GET_CHAR(SETTINGS_FOREGROUND_COLOR));
+    DWB_COLOR_PARSE(&dwb.color.active_bg, GET_CHAR(SETTINGS_BACKGROUND_COLOR));
+    DWB_COLOR_PARSE(&dwb.color.private_bg, GET_CHAR(SETTINGS_PRIVATE_COLOR));
 
     /* Tabs */
-    DWB_COLOR_PARSE(&dwb.color.tab_active_fg, GET_CHAR("tab-active-fg-color"));
-    DWB_COLOR_PARSE(&dwb.color.tab_active_bg, GET_CHAR("tab-active-bg-color"));
-    DWB_COLOR_PARSE(&dwb.color.tab_normal_fg1, GET_CHAR("tab-normal-fg-color-1"));
-    DWB_COLOR_PARSE(&dwb.color.tab_normal_bg1, GET_CHAR("tab-normal-bg-color-1"));
-    DWB_COLOR_PARSE(&dwb.color.tab_normal_fg2, GET_CHAR("tab-normal-fg-color-2"));
-    DWB_COLOR_PARSE(&dwb.color.tab_normal_bg2, GET_CHAR("tab-normal-bg-color-2"));
+    DWB_COLOR_PARSE(&dwb.color.tab_active_fg, GET_CHAR(SETTINGS_TAB_ACTIVE_FG_COLOR));
+    DWB_COLOR_PARSE(&dwb.color.tab_active_bg, GET_CHAR(SETTINGS_TAB_ACTIVE_BG_COLOR));
+    DWB_COLOR_PARSE(&dwb.color.tab_normal_fg1, GET_CHAR(SETTINGS_TAB_NORMAL_FG_COLOR_1));
+    DWB_COLOR_PARSE(&dwb.color.tab_normal_bg1, GET_CHAR(SETTINGS_TAB_NORMAL_BG_COLOR_1));
+    DWB_COLOR_PARSE(&dwb.color.tab_normal_fg2, GET_CHAR(SETTINGS_TAB_NORMAL_FG_COLOR_2));
+    DWB_COLOR_PARSE(&dwb.color.tab_normal_bg2, GET_CHAR(SETTINGS_TAB_NORMAL_BG_COLOR_2));
 
     /* Downloads */
-    DWB_COLOR_PARSE(&dwb.color.download_fg, GET_CHAR("download-fg-color"));
-    DWB_COLOR_PARSE(&dwb.color.download_bg, GET_CHAR("download-bg-color"));
-    DWB_COLOR_PARSE(&dwb.color.download_start, GET_CHAR("download-gradient-start"));
-    DWB_COLOR_PARSE(&dwb.color.download_end, GET_CHAR("download-gradient-end"));
+    DWB_COLOR_PARSE(&dwb.color.download_fg, GET_CHAR(SETTINGS_DOWNLOAD_FG_COLOR));
+    DWB_COLOR_PARSE(&dwb.color.download_bg, GET_CHAR(SETTINGS_DOWNLOAD_BG_COLOR));
+    DWB_COLOR_PARSE(&dwb.color.download_start, GET_CHAR(SETTINGS_DOWNLOAD_GRADIENT_START));
+    DWB_COLOR_PARSE(&dwb.color.download_end, GET_CHAR(SETTINGS_DOWNLOAD_GRADIENT_END));
 
     /* SSL */
-    DWB_COLOR_PARSE(&dwb.color.ssl_trusted, GET_CHAR("ssl-trusted-color"));
-    DWB_COLOR_PARSE(&dwb.color.ssl_untrusted, GET_CHAR("ssl-untrusted-color"));
+    DWB_COLOR_PARSE(&dwb.color.ssl_trusted, GET_CHAR(SETTINGS_SSL_TRUSTED_COLOR));
+    DWB_COLOR_PARSE(&dwb.color.ssl_untrusted, GET_CHAR(SETTINGS_SSL_UNTRUSTED_COLOR));
 
-    DWB_COLOR_PARSE(&dwb.color.active_c_bg, GET_CHAR("active-completion-bg-color"));
-    DWB_COLOR_PARSE(&dwb.color.active_c_fg, GET_CHAR("active-completion-fg-color"));
-    DWB_COLOR_PARSE(&dwb.color.normal_c_bg, GET_CHAR("normal-completion-bg-color"));
-    DWB_COLOR_PARSE(&dwb.color.normal_c_fg, GET_CHAR("normal-completion-fg-color"));
+    DWB_COLOR_PARSE(&dwb.color.active_c_bg, GET_CHAR(SETTINGS_ACTIVE_COMPLETION_BG_COLOR));
+    DWB_COLOR_PARSE(&dwb.color.active_c_fg, GET_CHAR(SETTINGS_ACTIVE_COMPLETION_FG_COLOR));
+    DWB_COLOR_PARSE(&dwb.color.normal_c_bg, GET_CHAR(SETTINGS_NORMAL_COMPLETION_BG_COLOR));
+    DWB_COLOR_PARSE(&dwb.color.normal_c_fg, GET_CHAR(SETTINGS_NORMAL_COMPLETION_FG_COLOR));
 
-    DWB_COLOR_PARSE(&dwb.color.error, GET_CHAR("error-color"));
-    DWB_COLOR_PARSE(&dwb.color.prompt, GET_CHAR("prompt-color"));
+    DWB_COLOR_PARSE(&dwb.color.error, GET_CHAR(SETTINGS_ERROR_COLOR));
+    DWB_COLOR_PARSE(&dwb.color.prompt, GET_CHAR(SETTINGS_PROMPT_COLOR));
 
-    dwb.color.tab_number_color = GET_CHAR("tab-number-color");
-    dwb.color.tab_protected_color = GET_CHAR("tab-protected-color");
-    dwb.color.allow_color = GET_CHAR("status-allowed-color");
-    dwb.color.block_color = GET_CHAR("status-blocked-color");
+    dwb.color.tab_number_color = GET_CHAR(SETTINGS_TAB_NUMBER_COLOR);
+    dwb.color.tab_protected_color = GET_CHAR(SETTINGS_TAB_PROTECTED_COLOR);
+    dwb.color.allow_color = GET_CHAR(SETTINGS_STATUS_ALLOWED_COLOR);
+    dwb.color.block_color = GET_CHAR(SETTINGS_STATUS_BLOCKED_COLOR);
 
-    dwb.color.progress_full = GET_CHAR("progress-bar-full-color");
-    dwb.color.progress_empty = GET_CHAR("progress-bar-empty-color");
+    dwb.color.progress_full = GET_CHAR(SETTINGS_PROGRESS_BAR_FULL_COLOR);
+    dwb.color.progress_empty = GET_CHAR(SETTINGS_PROGRESS_BAR_EMPTY_COLOR);
 
-    char *font = GET_CHAR("font");
+    char *font = GET_CHAR(SETTINGS_FONT);
     if (font) 
         dwb.font.fd_active = pango_font_description_from_string(font);
     char *f;
@@ -4473,9 +4907,9 @@ dwb_init_style()
     var = dwb.font.fd_active; \
 } while(0)
 
-    SET_FONT(dwb.font.fd_inactive, "font-nofocus");
-    SET_FONT(dwb.font.fd_entry, "font-entry");
-    SET_FONT(dwb.font.fd_completion, "font-completion");
+    SET_FONT(dwb.font.fd_inactive, SETTINGS_FONT_NOFOCUS);
+    SET_FONT(dwb.font.fd_entry, SETTINGS_FONT_ENTRY);
+    SET_FONT(dwb.font.fd_completion, SETTINGS_FONT_COMPLETION);
 #undef SET_FONT
 } /*}}}*/
 
@@ -4504,6 +4938,8 @@ dwb_apply_style()
     DWB_WIDGET_OVERRIDE_COLOR(dwb.gui.lstatus, GTK_STATE_NORMAL, &dwb.color.active_fg);
     DWB_WIDGET_OVERRIDE_FONT(dwb.gui.rstatus, dwb.font.fd_active);
     DWB_WIDGET_OVERRIDE_FONT(dwb.gui.urilabel, dwb.font.fd_active);
+    // colors are parsed in place, the uri label must be updated
+    s_uri_color = NULL;
     DWB_WIDGET_OVERRIDE_FONT(dwb.gui.lstatus, dwb.font.fd_active);
 
     DWB_WIDGET_OVERRIDE_BACKGROUND(dwb.gui.window, GTK_STATE_NORMAL, &dwb.color.active_bg);
@@ -4637,7 +5073,7 @@ dwb_pack(const char *layout, gboolean rebuild)
             gtk_box_reorder_child(GTK_BOX(dwb.gui.tabwrapperbox), dwb.gui.tabbox, -1);
         }
         gtk_orientable_set_orientation(GTK_ORIENTABLE(dwb.gui.tabcontainer), GTK_ORIENTATION_VERTICAL);
-        gtk_widget_set_size_request(dwb.gui.tabcontainer, GET_INT("tab-width"), -1);
+        gtk_widget_set_size_request(dwb.gui.tabcontainer, GET_INT(SETTINGS_TAB_WIDTH), -1);
         gtk_box_set_child_packing(GTK_BOX(dwb.gui.tabbox), dwb.gui.tabcontainer, false, false, 0, GTK_PACK_START);
         gtk_widget_show(dwb.gui.dummybox);
     }
@@ -4680,7 +5116,7 @@ dwb_init_gui()
     gtk_window_set_has_resize_grip(GTK_WINDOW(dwb.gui.window), false);
     GtkCssProvider *provider = gtk_css_provider_get_default();
     GString *buffer = g_string_new("GtkEntry {background-image: none; }");
-    if (! GET_BOOL("scrollbars")) 
+    if (! GET_BOOL(SETTINGS_SCROLLBARS)) 
     {
         g_string_append(buffer, "GtkScrollbar { \
                 -GtkRange-slider-width: 0; \
@@ -4696,7 +5132,7 @@ dwb_init_gui()
     gtk_style_context_add_provider_for_screen(screen, GTK_STYLE_PROVIDER(provider), GTK_STYLE_PROVIDER_PRIORITY_APPLICATION);
 #endif
 
-    gtk_window_set_default_size(GTK_WINDOW(dwb.gui.window), GET_INT("default-width"), GET_INT("default-height"));
+    gtk_window_set_default_size(GTK_WINDOW(dwb.gui.window), GET_INT(SETTINGS_DEFAULT_WIDTH), GET_INT(SETTINGS_DEFAULT_HEIGHT));
     gtk_window_set_geometry_hints(GTK_WINDOW(dwb.gui.window), NULL, NULL, GDK_HINT_MIN_SIZE);
     g_signal_connect(dwb.gui.window, "delete-event", G_CALLBACK(callback_delete_event), NULL);
     g_signal_connect(dwb.gui.window, "key-press-event", G_CALLBACK(callback_key_press), NULL);
@@ -4781,7 +5217,7 @@ dwb_init_gui()
         gtk_widget_set_size_request(dwb.gui.status_hbox, -1, dwb.misc.statusbar_height);
     }
     dwb.gui.alignment = gtk_alignment_new(0.5, 0.5, 1, 1);
-    int padding = GET_INT("bars-padding");
+    int padding = GET_INT(SETTINGS_BARS_PADDING);
     gtk_alignment_set_padding(GTK_ALIGNMENT(dwb.gui.alignment), padding, padding, padding, padding);
     gtk_container_add(GTK_CONTAINER(dwb.gui.alignment), dwb.gui.status_hbox);
 
@@ -4837,6 +5273,30 @@ dwb_init_file_content(GList *gl, const char *filename, Content_Func func)
     return gl;
 }/*}}}*/
 
+/* dwb_init_domain_index {{{*/
+static DomainIndex *
+dwb_init_domain_index(DomainIndex *index, const char *filename) 
+{
+    char **lines = util_get_lines(filename);
+    const char *entry;
+
+    if (index == NULL)
+        index = domain_index_new();
+    else 
+        domain_index_clear(index, DOMAIN_INDEX_PERSISTENT);
+
+    if (lines) 
+    {
+        for (int i=0; lines[i] != NULL; i++) 
+        {
+            if ((entry = dwb_domain_entry(lines[i])) != NULL)
+                domain_index_add(index, entry, DOMAIN_INDEX_PERSISTENT);
+        }
+        g_strfreev(lines);
+    }
+    return index;
+}/*}}}*/
+
 static Navigation * 
 dwb_get_search_completion_from_navigation(Navigation *n) 
 {
@@ -5014,18 +5474,16 @@ dwb_init_files()
     dwb.fc.navigations = dwb_init_file_content(dwb.fc.navigations, dwb.files[FILES_NAVIGATION_HISTORY], (Content_Func)dwb_return);
     dwb.fc.commands = dwb_init_file_content(dwb.fc.commands, dwb.files[FILES_COMMAND_HISTORY], (Content_Func)dwb_return);
     dwb.fc.searches = dwb_init_file_content(dwb.fc.searches, dwb.files[FILES_SEARCH_HISTORY], (Content_Func)dwb_return);
-    dwb.fc.tmp_scripts = NULL;
-    dwb.fc.tmp_plugins = NULL;
     dwb.fc.downloads   = NULL;
-    dwb.fc.pers_scripts = dwb_get_simple_list(NULL, dwb.files[FILES_SCRIPTS_ALLOW]);
-    dwb.fc.pers_plugins = dwb_get_simple_list(NULL, dwb.files[FILES_PLUGINS_ALLOW]);
+    dwb.fc.scripts_allow = dwb_init_domain_index(dwb.fc.scripts_allow, dwb.files[FILES_SCRIPTS_ALLOW]);
+    dwb.fc.plugins_allow = dwb_init_domain_index(dwb.fc.plugins_allow, dwb.files[FILES_PLUGINS_ALLOW]);
 
     if (g_list_last(dwb.fc.searchengines) && dwb.fc.searchengines->data) 
         dwb.misc.default_search = ((Navigation*)dwb.fc.searchengines->data)->second;
     else 
         dwb.misc.default_search = NULL;
-    dwb.fc.cookies_allow = dwb_init_file_content(dwb.fc.cookies_allow, dwb.files[FILES_COOKIES_ALLOW], (Content_Func)dwb_return);
-    dwb.fc.cookies_session_allow = dwb_init_file_content(dwb.fc.cookies_session_allow, dwb.files[FILES_COOKIES_SESSION_ALLOW], (Content_Func)dwb_return);
+    dwb.fc.cookies_allow = dwb_init_domain_index(dwb.fc.cookies_allow, dwb.files[FILES_COOKIES_ALLOW]);
+    dwb.fc.cookies_session_allow = dwb_init_domain_index(dwb.fc.cookies_session_allow, dwb.files[FILES_COOKIES_SESSION_ALLOW]);
 
     g_free(path);
     g_free(profile_path);
@@ -5155,6 +5613,7 @@ dwb_init_custom_keys(gboolean reload)
         g_string_free(keybuf, true);
     }
     g_strfreev(lines);
+    dwb_keymap_changed();
 }
 
 void
@@ -5184,6 +5643,9 @@ dwb_init_vars(void)
     dwb.misc.sync_interval = 0;
     dwb.misc.synctimer = 0;
     dwb.misc.sync_files = SYNC_ALL;
+    dwb.misc.hibernatetimer = 0;
+    dwb.misc.hibernate_timeout = 0;
+    dwb.misc.hibernate_max_tabs = 0;
 
     dwb.misc.https_quark = g_quark_from_static_string("dwb_is_https");
 
@@ -5206,9 +5668,9 @@ dwb_init()
     dwb_clean_vars();
     dwb.state.buffer = g_string_new(NULL);
 
-    dwb.misc.tabbed_browsing = GET_BOOL("tabbed-browsing");
+    dwb.misc.tabbed_browsing = GET_BOOL(SETTINGS_TABBED_BROWSING);
 
-    char *cache_model = GET_CHAR("cache-model");
+    char *cache_model = GET_CHAR(SETTINGS_CACHE_MODEL);
 
     if (cache_model != NULL && !g_ascii_strcasecmp(cache_model, "documentviewer"))
         webkit_set_cache_model(WEBKIT_CACHE_MODEL_DOCUMENT_VIEWER);
@@ -5218,13 +5680,15 @@ dwb_init()
     dwb_init_style();
     dwb_init_gui();
     dwb_init_custom_keys(false);
-    if (GET_BOOL("enable-ipc"))
+    if (GET_BOOL(SETTINGS_ENABLE_IPC))
         ipc_start(dwb.gui.window);
     domain_init();
     adblock_init();
+    request_policy_init();
     dwb_init_hints(NULL, NULL);
 
     dwb_soup_init();
+    dwb_share_files(GET_BOOL(SETTINGS_SHARED_FILES));
 #ifndef DISABLE_HSTS
     hsts_init();
 #endif
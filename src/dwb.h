@@ -37,6 +37,9 @@
 #endif
 
 #define PBAR_LENGTH   20
+/* Queued status bar and tab label updates are flushed at most once per
+ * interval (ms), roughly once per frame */
+#define STATUS_UPDATE_INTERVAL 16
 #define STRING_LENGTH 1024
 #define BUFFER_LENGTH 256
 
@@ -142,10 +145,10 @@
 #define DWB_COMPLETE_KEY(e)         (DWB_TAB_KEY(e) || e->keyval == GDK_KEY_Down || e->keyval == GDK_KEY_Up)
 
 // Settings
-#define GET_CHAR(prop)              ((char*)(((WebSettings*)g_hash_table_lookup(dwb.settings, prop))->arg_local.p))
-#define GET_BOOL(prop)              (((WebSettings*)g_hash_table_lookup(dwb.settings, prop))->arg_local.b)
-#define GET_INT(prop)               (((WebSettings*)g_hash_table_lookup(dwb.settings, prop))->arg_local.i)
-#define GET_DOUBLE(prop)            (((WebSettings*)g_hash_table_lookup(dwb.settings, prop))->arg_local.d)
+#define GET_CHAR(id)                ((char*)(dwb.settings_table[id]->arg_local.p))
+#define GET_BOOL(id)                (dwb.settings_table[id]->arg_local.b)
+#define GET_INT(id)                 (dwb.settings_table[id]->arg_local.i)
+#define GET_DOUBLE(id)              (dwb.settings_table[id]->arg_local.d)
 #define NUMMOD                      (dwb.state.nummod < 0 ? 1 : dwb.state.nummod)
 
 #ifdef DWB_DEBUG
@@ -213,6 +216,7 @@ enum {
 typedef struct _Arg Arg;
 typedef struct _Color Color;
 typedef struct _Completions Completions;
+typedef struct _DomainIndex DomainIndex;
 typedef struct _Dwb Dwb;
 typedef struct _FileContent FileContent;
 typedef struct _Font DwbFont;
@@ -228,6 +232,7 @@ typedef struct _Quickmark Quickmark;
 typedef struct _Settings Settings;
 typedef struct _State State;
 typedef struct _View View;
+typedef struct _ViewHibernation ViewHibernation;
 typedef struct _ViewStatus ViewStatus;
 typedef struct _WebSettings WebSettings;
 /*}}}*/
@@ -285,6 +290,11 @@ enum {
 } EntryProp;
 #define EP_COMPLETION (EP_COMP_DEFAULT | EP_COMP_QUICKMARK)
 
+typedef enum _StatusUpdate {
+  STATUS_UPDATE_TEXT  = 1<<0,
+  STATUS_UPDATE_ALL   = 1<<1,
+} StatusUpdate;
+
 typedef enum _TabMoveDirection {
   TAB_MOVE_NONE,
   TAB_MOVE_LEFT,
@@ -339,6 +349,9 @@ enum {
 };
 #define SYNC_ALL (SYNC_HISTORY | SYNC_COOKIES | SYNC_SESSION)
 
+/* Interval in seconds to check for tabs that can be hibernated */
+#define HIBERNATE_INTERVAL 10
+
 typedef enum {
   HINT_T_ALL        = 0,
   HINT_T_LINKS      = 1,
@@ -714,8 +727,23 @@ struct _ViewStatus {
   guint group;
   gboolean deferred;
   char *deferred_uri;
+  ViewHibernation *hibernation;
+  gint64 last_focus;
+  guint blocked_requests;
+  GHashTable *third_party;
   double marks[MARK_LENGTH];
   WebKitWebNavigationReason reason;
+  unsigned int pending_update;
+};
+struct _ViewHibernation {
+  GList *items;
+  Navigation *current;
+  int forward;
+  unsigned int lockprotect;
+  guint serial;
+  double hscroll;
+  double vscroll;
+  GList *gl;
 };
 struct _View {
   GtkWidget *web;
@@ -730,6 +758,8 @@ struct _View {
   WebKitWebSettings *settings;
   JSObjectRef js_base;
   JSObjectRef script_wv;
+  int index;
+  guint id;
 };
 struct _Color {
   DwbColor active_fg;
@@ -834,6 +864,9 @@ struct _Misc {
 
   int synctimer;
   int sync_interval;
+  int hibernatetimer;
+  int hibernate_timeout;
+  int hibernate_max_tabs;
   int sync_files;
   int statusbar_height;
   int tabbar_height;
@@ -885,6 +918,187 @@ enum Files {
   FILES_PLUGINDB,
   FILES_LAST
 };
+/* Indices into DWB_SETTINGS and dwb.settings_table, used by the GET_* macros */
+enum SettingsId {
+  SETTINGS_FIRST = 0,
+  SETTINGS_AUTO_LOAD_IMAGES = 0,
+  SETTINGS_AUTO_RESIZE_WINDOW,
+  SETTINGS_AUTO_SHRINK_IMAGES,
+  SETTINGS_CURSIVE_FONT_FAMILY,
+  SETTINGS_DEFAULT_ENCODING,
+  SETTINGS_DEFAULT_FONT_FAMILY,
+  SETTINGS_DEFAULT_FONT_SIZE,
+  SETTINGS_DEFAULT_MONOSPACE_FONT_SIZE,
+  SETTINGS_ENABLE_CARET_BROWSING,
+  SETTINGS_ENABLE_DEFAULT_CONTEXT_MENU,
+  SETTINGS_ENABLE_DEVELOPER_EXTRAS,
+  SETTINGS_ENABLE_DNS_PREFETCHING,
+  SETTINGS_ENABLE_DOM_PASTE,
+  SETTINGS_ENABLE_FRAME_FLATTENING,
+  SETTINGS_ENABLE_FILE_ACCESS_FROM_FILE_URIS,
+  SETTINGS_ENABLE_HTML5_DATABASE,
+  SETTINGS_ENABLE_HTML5_LOCAL_STORAGE,
+  SETTINGS_ENABLE_JAVA_APPLET,
+  SETTINGS_ENABLE_OFFLINE_WEB_APPLICATION_CACHE,
+  SETTINGS_ENABLE_PAGE_CACHE,
+  SETTINGS_ENABLE_PLUGINS,
+  SETTINGS_ENABLE_PRIVATE_BROWSING,
+  SETTINGS_ENABLE_SCRIPTS,
+  SETTINGS_ENABLE_SITE_SPECIFIC_QUIRKS,
+  SETTINGS_ENABLE_SPATIAL_NAVIGATION,
+  SETTINGS_ENABLE_SPELL_CHECKING,
+  SETTINGS_ENABLE_UNIVERSAL_ACCESS_FROM_FILE_URIS,
+  SETTINGS_ENABLE_WEBGL,
+  SETTINGS_ENABLE_XSS_AUDITOR,
+  SETTINGS_ENFORCE_96_DPI,
+  SETTINGS_FANTASY_FONT_FAMILY,
+  SETTINGS_JAVASCRIPT_CAN_ACCESS_CLIPBOARD,
+  SETTINGS_JAVASCRIPT_CAN_OPEN_WINDOWS_AUTOMATICALLY,
+  SETTINGS_MINIMUM_FONT_SIZE,
+  SETTINGS_MINIMUM_LOGICAL_FONT_SIZE,
+  SETTINGS_MONOSPACE_FONT_FAMILY,
+  SETTINGS_PRINT_BACKGROUNDS,
+  SETTINGS_RESIZABLE_TEXT_AREAS,
+  SETTINGS_SANS_SERIF_FONT_FAMILY,
+  SETTINGS_SERIF_FONT_FAMILY,
+  SETTINGS_SPELL_CHECKING_LANGUAGES,
+  SETTINGS_TAB_KEY_CYCLES_THROUGH_ELEMENTS,
+  SETTINGS_USER_AGENT,
+  SETTINGS_USER_STYLESHEET_URI,
+  SETTINGS_ZOOM_STEP,
+  SETTINGS_CUSTOM_ENCODING,
+  SETTINGS_EDITABLE,
+  SETTINGS_FULL_CONTENT_ZOOM,
+  SETTINGS_ZOOM_LEVEL,
+  SETTINGS_PROXY,
+  SETTINGS_PROXY_URL,
+  SETTINGS_SSL_STRICT,
+#ifdef WITH_LIBSOUP_2_38
+  SETTINGS_SSL_USE_SYSTEM_CA_FILE,
+#else
+  SETTINGS_SSL_CA_CERT,
+#endif
+  SETTINGS_COOKIES_STORE_POLICY,
+  SETTINGS_COOKIES_ACCEPT_POLICY,
+  SETTINGS_BACKGROUND_TABS,
+  SETTINGS_SCROLL_STEP,
+  SETTINGS_DO_NOT_TRACK,
+  SETTINGS_FOREGROUND_COLOR,
+  SETTINGS_BACKGROUND_COLOR,
+  SETTINGS_PRIVATE_COLOR,
+  SETTINGS_TAB_ACTIVE_FG_COLOR,
+  SETTINGS_TAB_ACTIVE_BG_COLOR,
+  SETTINGS_TAB_NORMAL_FG_COLOR_1,
+  SETTINGS_TAB_NORMAL_BG_COLOR_1,
+  SETTINGS_TAB_NORMAL_FG_COLOR_2,
+  SETTINGS_TAB_NORMAL_BG_COLOR_2,
+  SETTINGS_TAB_NUMBER_COLOR,
+  SETTINGS_TAB_PROTECTED_COLOR,
+  SETTINGS_TABBED_BROWSING,
+  SETTINGS_ENABLE_FAVICON,
+  SETTINGS_FAVICON_SIZE,
+  SETTINGS_TABBAR_HEIGHT,
+  SETTINGS_STATUSBAR_HEIGHT,
+  SETTINGS_FILE_SYNC_INTERVAL,
+  SETTINGS_SYNC_FILES,
+  SETTINGS_SHARED_FILES,
+  SETTINGS_ACTIVE_COMPLETION_FG_COLOR,
+  SETTINGS_ACTIVE_COMPLETION_BG_COLOR,
+  SETTINGS_NORMAL_COMPLETION_FG_COLOR,
+  SETTINGS_NORMAL_COMPLETION_BG_COLOR,
+  SETTINGS_SSL_TRUSTED_COLOR,
+  SETTINGS_SSL_UNTRUSTED_COLOR,
+  SETTINGS_ERROR_COLOR,
+  SETTINGS_PROMPT_COLOR,
+  SETTINGS_STATUS_ALLOWED_COLOR,
+  SETTINGS_STATUS_BLOCKED_COLOR,
+  SETTINGS_DOWNLOAD_BG_COLOR,
+  SETTINGS_DOWNLOAD_FG_COLOR,
+  SETTINGS_DOWNLOAD_GRADIENT_START,
+  SETTINGS_DOWNLOAD_GRADIENT_END,
+  SETTINGS_PROGRESS_BAR_FULL_COLOR,
+  SETTINGS_PROGRESS_BAR_EMPTY_COLOR,
+  SETTINGS_FONT,
+  SETTINGS_FONT_ENTRY,
+  SETTINGS_FONT_COMPLETION,
+  SETTINGS_FONT_NOFOCUS,
+  SETTINGS_FONT_HIDDEN_STATUSBAR,
+  SETTINGS_HINT_STYLE,
+  SETTINGS_HINT_LETTER_SEQ,
+  SETTINGS_HINT_HIGHLIGHT_LINKS,
+  SETTINGS_HINT_FONT,
+  SETTINGS_HINT_FG_COLOR,
+  SETTINGS_HINT_BG_COLOR,
+  SETTINGS_HINT_ACTIVE_COLOR,
+  SETTINGS_HINT_NORMAL_COLOR,
+  SETTINGS_HINT_BORDER,
+  SETTINGS_HINT_OPACITY,
+  SETTINGS_HINT_OFFSET_TOP,
+  SETTINGS_HINT_OFFSET_LEFT,
+  SETTINGS_HINT_AUTOFOLLOW,
+  SETTINGS_AUTO_COMPLETION,
+  SETTINGS_STARTPAGE,
+  SETTINGS_UPDATE_SEARCH_DELAY,
+  SETTINGS_SINGLE_INSTANCE,
+  SETTINGS_SAVE_SESSION,
+  SETTINGS_WIDGET_PACKING,
+  SETTINGS_PROGRESS_BAR_STYLE,
+  SETTINGS_CACHE_MODEL,
+  SETTINGS_JAVASCRIPT_SCHEMES,
+  SETTINGS_DOWNLOAD_EXTERNAL_COMMAND,
+  SETTINGS_DOWNLOAD_NO_CONFIRM,
+  SETTINGS_DOWNLOAD_DIRECTORY,
+  SETTINGS_DOWNLOAD_USE_EXTERNAL_PROGRAM,
+  SETTINGS_COMPLETE_HISTORY,
+  SETTINGS_COMPLETE_BOOKMARKS,
+  SETTINGS_COMPLETE_SEARCHENGINES,
+  SETTINGS_COMPLETE_USERSCRIPTS,
+  SETTINGS_DEFAULT_WIDTH,
+  SETTINGS_DEFAULT_HEIGHT,
+  SETTINGS_MESSAGE_DELAY,
+  SETTINGS_HISTORY_LENGTH,
+  SETTINGS_NAVIGATION_HISTORY_MAX,
+  SETTINGS_SCROLLBARS,
+  SETTINGS_SCHEME_HANDLER,
+  SETTINGS_EDITOR,
+  SETTINGS_ADBLOCKER,
+  SETTINGS_ADBLOCKER_FILTERLIST,
+  SETTINGS_ADBLOCKER_ELEMENT_HIDER,
+#ifndef DISABLE_HSTS
+  SETTINGS_HSTS,
+#endif
+#ifdef WITH_LIBSOUP_2_38
+  SETTINGS_ADDRESSBAR_DNS_LOOKUP,
+#endif
+  SETTINGS_PLUGIN_BLOCKER,
+  SETTINGS_AUTO_INSERT_MODE,
+  SETTINGS_TABBAR_VISIBLE,
+  SETTINGS_NEW_TAB_POSITION_POLICY,
+  SETTINGS_CLOSE_TAB_FOCUS_POLICY,
+  SETTINGS_CLOSE_LAST_TAB_POLICY,
+  SETTINGS_BARS_PADDING,
+  SETTINGS_SEARCHENGINE_SUBMIT_PATTERN,
+  SETTINGS_SHOW_SINGLE_TAB,
+  SETTINGS_HINTS_KEY_LOCK,
+  SETTINGS_LOAD_ON_FOCUS,
+  SETTINGS_HIBERNATE_TIMEOUT,
+  SETTINGS_HIBERNATE_MAX_TABS,
+  SETTINGS_PRINT_PREVIEWER,
+  SETTINGS_ACCEPT_LANGUAGE,
+  SETTINGS_MAX_VISIBLE_COMPLETIONS,
+  SETTINGS_COOKIE_EXPIRATION,
+  SETTINGS_PASSTHROUGH_KEYS,
+#if !_HAS_GTK3
+  SETTINGS_TAB_ORIENTATION,
+  SETTINGS_TAB_WIDTH,
+#endif
+  SETTINGS_MOUSE_CYCLES_THROUGH_TABS,
+  SETTINGS_MAXIMUM_TABS,
+  SETTINGS_JAVASCRIPT_API,
+  SETTINGS_BLOCK_INSECURE_CONTENT,
+  SETTINGS_ENABLE_IPC,
+  SETTINGS_LAST
+};
 // TODO implement plugins blocker, script blocker with File struct
 typedef struct _File {
   unsigned long int mod;
@@ -899,16 +1113,14 @@ struct _FileContent {
   GList *se_completion;
   GList *keys;
   GList *settings;
-  GList *cookies_allow;
-  GList *cookies_session_allow;
+  DomainIndex *cookies_allow;
+  DomainIndex *cookies_session_allow;
   GList *navigations;
   GList *commands;
   GList *mimetypes;
   GList *adblock;
-  GList *tmp_scripts;
-  GList *tmp_plugins;
-  GList *pers_scripts; 
-  GList *pers_plugins; 
+  DomainIndex *scripts_allow;
+  DomainIndex *plugins_allow;
   GList *downloads;
   GList *searches;
 };
@@ -924,6 +1136,7 @@ struct _Dwb {
   GList *override_keys;
   GSList *custom_commands;
   GHashTable *settings;
+  WebSettings *settings_table[SETTINGS_LAST];
   //Files files;
   char *files[FILES_LAST];
   FileContent fc;
@@ -951,6 +1164,11 @@ void dwb_tab_label_set_text(GList *, const char *);
 void dwb_set_status_bar_text(GtkWidget *, const char *, DwbColor *,  PangoFontDescription *, gboolean);
 void dwb_update_status_text(GList *gl, GtkAdjustment *);
 void dwb_update_status(GList *gl, const char *);
+void dwb_tabs_reindex(void);
+int dwb_tab_index(GList *gl);
+GList * dwb_tab_nth(int n);
+guint dwb_tab_count(void);
+void dwb_queue_status_update(GList *gl, StatusUpdate);
 void dwb_unfocus(void);
 
 DwbStatus dwb_prepend_navigation(GList *, GList **);
@@ -973,7 +1191,7 @@ void dwb_scroll(GList *, double, ScrollDirection);
 
 void dwb_focus(GList *);
 void dwb_source_remove();
-gboolean dwb_spawn(GList *, const char *, const char *uri);
+gboolean dwb_spawn(GList *, int, const char *uri);
 
 DwbStatus dwb_set_proxy(GList *, WebSettings *);
 
@@ -986,6 +1204,7 @@ int dwb_end(int);
 Key dwb_str_to_key(char *);
 
 GList * dwb_keymap_add(GList *, KeyValue );
+void dwb_keymap_changed(void);
 
 void dwb_save_settings(void);
 gboolean dwb_save_files(gboolean, int);
@@ -998,8 +1217,9 @@ void dwb_clean_load_begin(GList *);
 void dwb_clear_last_command();
 
 void dwb_update_uri(GList *, gboolean);
+void dwb_set_uri_label(const char *, DwbColor *);
 gboolean dwb_get_allowed(const char *, const char *);
-gboolean dwb_toggle_allowed(const char *, const char *, GList **);
+gboolean dwb_toggle_allowed(const char *, const char *, DomainIndex *);
 char * dwb_get_host(WebKitWebView *);
 gboolean dwb_focus_view(GList *, const char *event);
 void dwb_clean_key_buffer(void);
@@ -1014,6 +1234,9 @@ char * dwb_get_stock_item_base64_encoded(const char *);
 void dwb_remove_bookmark(const char *);
 void dwb_remove_download(const char *);
 void dwb_remove_history(const char *);
+void dwb_history_add_item(Navigation *);
+void dwb_clear_history(void);
+void dwb_share_files(gboolean);
 void dwb_remove_quickmark(const char *);
 void dwb_remove_search_engine(const char *);
 DwbStatus dwb_evaluate_hints(const char *);
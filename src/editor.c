@@ -129,7 +129,7 @@ editor_open(void)
     gboolean success;
     gboolean contenteditable = false;
 
-    char *editor = GET_CHAR("editor");
+    char *editor = GET_CHAR(SETTINGS_EDITOR);
 
     if (editor == NULL) 
         return STATUS_ERROR;
@@ -861,7 +861,7 @@ static HSTSProvider *s_provider;
 gboolean
 hsts_running()
 {
-    return s_init && GET_BOOL("hsts");
+    return s_init && GET_BOOL(SETTINGS_HSTS);
 }
 
 /* Activates hsts */
@@ -896,7 +896,7 @@ hsts_init()
 {
     if(s_init)
         return true;
-    if(!GET_BOOL("hsts"))
+    if(!GET_BOOL(SETTINGS_HSTS))
         return false;
 
     s_provider = g_object_new(HSTS_TYPE_PROVIDER, NULL);
@@ -50,6 +50,7 @@ DwbStatus html_scripts(GList *, HtmlTable *);
 DwbStatus html_keys(GList *, HtmlTable *);
 DwbStatus html_plugins(GList *, HtmlTable *);
 DwbStatus html_cookies(GList *, HtmlTable *);
+DwbStatus html_profile(GList *, HtmlTable *);
 
 
 static HtmlTable table[] = {
@@ -64,6 +65,7 @@ static HtmlTable table[] = {
     { SCRIPT_PATH,            "Scripts",        NULL,           0, html_scripts },
     { "dwb:startpage",         NULL,            NULL,           0, html_startpage },
     { "dwb:cookies",         "cookies",            NULL,           0, html_cookies },
+    { "dwb:profile",          "Profile",        INFO_FILE,      0, html_profile },
 };
 
 static char current_uri[BUFFER_LENGTH];
@@ -591,6 +593,46 @@ html_cookies(GList *gl, HtmlTable *table)
     dwb_load_uri(gl, "dwb-chrome://cookies");
     return STATUS_OK;
 }
+DwbStatus
+html_profile(GList *gl, HtmlTable *table) 
+{
+    DwbStatus ret = STATUS_ERROR;
+    GString *buf = g_string_new(NULL);
+    GList *profiles = scripts_profile_get();
+
+    g_string_append(buf, "\n<tr class='dwb_table_row'>"
+            "<th class='dwb_table_headline'>Signal</th>"
+            "<th class='dwb_table_headline'>Script</th>"
+            "<th class='dwb_table_headline'>Calls</th>"
+            "<th class='dwb_table_headline'>Total ms</th>"
+            "<th class='dwb_table_headline'>Average ms</th>"
+            "<th class='dwb_table_headline'>Max ms</th>"
+            "<th class='dwb_table_headline'>Exceptions</th></tr>\n");
+    for (GList *l = profiles; l; l=l->next) 
+    {
+        ScriptProfile *p = l->data;
+        char *owner = p->owner != NULL ? g_markup_escape_text(p->owner, -1) : g_strdup("(all)");
+        char *signal = g_markup_escape_text(p->signal, -1);
+        g_string_append_printf(buf, "<tr class='dwb_table_row'>"
+                "<td class='dwb_table_cell_left'>%s</td>"
+                "<td class='dwb_table_cell_middle'>%s</td>"
+                "<td>%u</td><td>%.2f</td><td>%.3f</td><td>%.2f</td><td>%u</td></tr>\n", 
+                signal, owner, p->calls, p->total / 1000.0, p->total / 1000.0 / p->calls, 
+                p->max / 1000.0, p->exceptions);
+        g_free(owner);
+        g_free(signal);
+    }
+    g_string_append_printf(buf, "<tr><td colspan='7'>"
+            "<div class='footnote'>Times of single handlers are %s, "
+            "they are recorded if <i>Signal.profiling</i> is set to true</div>"
+            "</td></tr>", scripts_profile_enabled() ? "recorded" : "not recorded");
+
+    ret = html_load_page(WEBVIEW(gl), table, buf->str);
+
+    g_list_free(profiles);
+    g_string_free(buf, true);
+    return ret;
+}
 gboolean
 html_scripts_confirm(WebKitDOMElement *el, WebKitDOMEvent *ev, GList *gl) 
 {
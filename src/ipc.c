@@ -19,6 +19,7 @@
 #include "dwb.h"
 #include "ipc.h"
 #include "session.h"
+#include "scripts.h"
 #include <dwbremote.h>
 #include "soup.h"
 #include <string.h>
@@ -110,7 +111,7 @@ send_hook_list(const char *action, char **list, int count)
 static DwbStatus 
 bind_callback(KeyMap *map, Arg *a)
 {
-    char *data = g_strdup_printf("%d %s", g_list_position(dwb.state.views, dwb.state.fview), CURRENT_URL());
+    char *data = g_strdup_printf("%d %s", dwb_tab_index(dwb.state.fview), CURRENT_URL());
     char *argv[2] = { a->arg, data };
     dwbremote_set_property_list(s_dpy, s_win, s_atoms[DWB_ATOM_BIND], argv, 2);
     return STATUS_OK;
@@ -168,7 +169,7 @@ parse_commands(char **list, int count)
             if ((n = get_number(list[argc])) != -1)
             {
                 argc++;
-                l = g_list_nth(dwb.state.views, n - 1);
+                l = dwb_tab_nth(n - 1);
                 if (l == NULL)
                 {
                     return -1;
@@ -197,7 +198,7 @@ parse_commands(char **list, int count)
         }
         else if (STREQ(list[argc], "ntabs"))
         {
-            text = g_strdup_printf("%d", g_list_length(dwb.state.views));
+            text = g_strdup_printf("%d", dwb_tab_count());
         }
         else if (STREQ(list[argc], "all_uris"))
         {
@@ -241,7 +242,7 @@ parse_commands(char **list, int count)
         else if (STREQ(list[argc], "current_tab"))
         {
             dwbremote_set_formatted_property_value(s_dpy, s_win, s_atoms[DWB_ATOM_WRITE],
-                    "%d", g_list_position(dwb.state.views, dwb.state.fview) + 1);
+                    "%d", dwb_tab_index(dwb.state.fview) + 1);
         }
         else if (STREQ(list[argc], "history"))
         {
@@ -261,6 +262,21 @@ parse_commands(char **list, int count)
         {
             text = g_strdup(dwb.misc.profile);
         }
+        else if (STREQ(list[argc], "script_profile"))
+        {
+            GString *s = g_string_new(NULL);
+            GList *profiles = scripts_profile_get();
+            for (GList *l = profiles; l; l=l->next)
+            {
+                ScriptProfile *p = l->data;
+                g_string_append_printf(s, "%s%s %s %u %.3f %.3f %u", OPTNL(l == profiles), 
+                        p->signal, p->owner != NULL ? p->owner : "(all)", p->calls, 
+                        p->total / 1000.0, p->max / 1000.0, p->exceptions);
+            }
+            g_list_free(profiles);
+            text = s->str;
+            g_string_free(s, false);
+        }
         else if (STREQ(list[argc], "session"))
         {
             text = g_strdup(session_get_name());
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2010-2014 Stefan Bolte <portix@gmx.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include "dwb.h"
+#include "journal.h"
+
+/*
+ * A journal shares changes of a file between several dwb instances. Every
+ * instance appends its changes as single lines to <filename>.journal
+ *
+ *      <instance-id> <op> <data>
+ *
+ * and watches the journal with a GFileMonitor, changes of other instances are
+ * read incrementally from the last offset and passed to the apply function.
+ *
+ * Appending and compacting is serialized with a lock on <filename>.lock.
+ * Compacting reads all pending changes, writes a snapshot of the current state
+ * to the file and replaces the journal with an empty one. Other instances still
+ * hold a descriptor to the old journal, they read it to the end before they
+ * switch to the new one, so no change is lost.
+ */
+struct _Journal {
+    char *path;
+    char *lock_path;
+    char *id;
+    int fd;
+    dev_t dev;
+    ino_t ino;
+    GString *partial;
+    GFileMonitor *monitor;
+    JournalApplyFunc apply;
+    gpointer user_data;
+    gboolean applied;
+};
+
+static int
+journal_lock(Journal *j)
+{
+    int fd = open(j->lock_path, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+    if (fd != -1)
+        flock(fd, LOCK_EX);
+    return fd;
+}
+static void
+journal_unlock(int fd)
+{
+    if (fd != -1) 
+    {
+        flock(fd, LOCK_UN);
+        close(fd);
+    }
+}
+
+/* (Re)opens the journal for reading at offset 0 */
+static int
+journal_open(Journal *j)
+{
+    struct stat st;
+
+    if (j->fd != -1)
+        close(j->fd);
+    g_string_truncate(j->partial, 0);
+
+    j->fd = open(j->path, O_RDONLY | O_CREAT, S_IRUSR | S_IWUSR);
+    if (j->fd == -1) 
+    {
+        perror("open");
+        return -1;
+    }
+    if (fstat(j->fd, &st) == 0) 
+    {
+        j->dev = st.st_dev;
+        j->ino = st.st_ino;
+    }
+    return j->fd;
+}
+
+static void
+journal_apply_line(Journal *j, const char *line)
+{
+    const char *op = strchr(line, ' ');
+    size_t length;
+
+    if (op == NULL || op[1] == '\0')
+        return;
+    length = op - line;
+    /* Own changes have already been applied */
+    if (length == strlen(j->id) && !strncmp(line, j->id, length))
+        return;
+
+    op++;
+    if (*op == JOURNAL_READ)
+        return;
+    j->apply(*op, op[1] == ' ' ? op + 2 : op + 1, j->user_data);
+    j->applied = true;
+}
+static void
+journal_parse(Journal *j, const char *buffer, ssize_t length)
+{
+    const char *end = buffer + length;
+    const char *nl;
+
+    while (buffer < end) 
+    {
+        nl = memchr(buffer, '\n', end - buffer);
+        if (nl == NULL) 
+        {
+            g_string_append_len(j->partial, buffer, end - buffer);
+            break;
+        }
+        g_string_append_len(j->partial, buffer, nl - buffer);
+        journal_apply_line(j, j->partial->str);
+        g_string_truncate(j->partial, 0);
+        buffer = nl + 1;
+    }
+}
+
+/* Reads all changes that haven't been read yet */
+void
+journal_read(Journal *j)
+{
+    g_return_if_fail(j != NULL);
+
+    char buffer[BUFSIZ];
+    ssize_t r;
+    struct stat st;
+
+    while (j->fd != -1) 
+    {
+        while ((r = read(j->fd, buffer, sizeof(buffer))) > 0) 
+            journal_parse(j, buffer, r);
+
+        /* The journal was replaced by another instance, continue with the new
+         * one */
+        if (stat(j->path, &st) == 0 && st.st_dev == j->dev && st.st_ino == j->ino)
+            break;
+        if (journal_open(j) == -1)
+            break;
+    }
+    if (j->applied) 
+    {
+        j->applied = false;
+        j->apply(JOURNAL_READ, NULL, j->user_data);
+    }
+}
+
+static void
+journal_changed_cb(GFileMonitor *monitor, GFile *file, GFile *other, GFileMonitorEvent event, Journal *j)
+{
+    journal_read(j);
+}
+
+/* Appends a change, newlines in data are replaced with spaces */
+gboolean
+journal_append(Journal *j, char op, const char *data)
+{
+    g_return_val_if_fail(j != NULL, false);
+
+    gboolean ret = false;
+    int lock, fd;
+    char *line = g_strdup_printf("%s %c %s\n", j->id, op, data != NULL ? data : "");
+    size_t length = strlen(line);
+
+    g_strdelimit(line, "\n", ' ');
+    line[length-1] = '\n';
+
+    lock = journal_lock(j);
+    fd = open(j->path, O_WRONLY | O_APPEND | O_CREAT, S_IRUSR | S_IWUSR);
+    if (fd != -1) 
+    {
+        ret = write(fd, line, length) == (ssize_t)length;
+        close(fd);
+    }
+    journal_unlock(lock);
+
+    g_free(line);
+    return ret;
+}
+
+/* Writes a snapshot and starts a new journal. If force is false the journal is
+ * only compacted if it is larger than JOURNAL_MAX_SIZE */
+gboolean
+journal_compact(Journal *j, JournalSnapshotFunc snapshot, gboolean force)
+{
+    g_return_val_if_fail(j != NULL, false);
+
+    struct stat st;
+    int lock;
+
+    if (!force && (stat(j->path, &st) == -1 || st.st_size < JOURNAL_MAX_SIZE))
+        return false;
+
+    lock = journal_lock(j);
+
+    journal_read(j);
+    snapshot(j->user_data);
+
+    if (unlink(j->path) == -1)
+        perror("unlink");
+    journal_open(j);
+
+    journal_unlock(lock);
+    return true;
+}
+
+Journal *
+journal_new(const char *filename, JournalApplyFunc apply, gpointer user_data)
+{
+    g_return_val_if_fail(filename != NULL, NULL);
+    g_return_val_if_fail(apply != NULL, NULL);
+
+    GFile *file;
+    Journal *j = dwb_malloc(sizeof(Journal));
+
+    j->path = g_strconcat(filename, ".journal", NULL);
+    j->lock_path = g_strconcat(filename, ".lock", NULL);
+    j->id = g_strdup_printf("%x.%08x", (guint)getpid(), g_random_int());
+    j->fd = -1;
+    j->partial = g_string_new(NULL);
+    j->apply = apply;
+    j->user_data = user_data;
+    j->applied = false;
+    j->monitor = NULL;
+
+    /* Changes that haven't been compacted yet, e.g. after a crash, are replayed */
+    journal_open(j);
+    journal_read(j);
+
+    file = g_file_new_for_path(j->path);
+    j->monitor = g_file_monitor_file(file, G_FILE_MONITOR_NONE, NULL, NULL);
+    if (j->monitor != NULL)
+        g_signal_connect(j->monitor, "changed", G_CALLBACK(journal_changed_cb), j);
+    g_object_unref(file);
+
+    return j;
+}
+
+void
+journal_free(Journal *j)
+{
+    if (j == NULL)
+        return;
+    if (j->monitor != NULL) 
+    {
+        g_file_monitor_cancel(j->monitor);
+        g_object_unref(j->monitor);
+    }
+    if (j->fd != -1)
+        close(j->fd);
+    g_string_free(j->partial, true);
+    g_free(j->path);
+    g_free(j->lock_path);
+    g_free(j->id);
+    g_free(j);
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2010-2014 Stefan Bolte <portix@gmx.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#ifndef __DWB_JOURNAL_H__
+#define __DWB_JOURNAL_H__
+
+/* A journal is compacted into its file if it grows beyond this size */
+#define JOURNAL_MAX_SIZE (512*BPKB)
+
+typedef struct _Journal Journal;
+typedef void (*JournalApplyFunc)(char, const char *, gpointer);
+typedef void (*JournalSnapshotFunc)(gpointer);
+
+enum {
+    JOURNAL_ADD     = '+',
+    JOURNAL_REMOVE  = '-',
+    JOURNAL_CLEAR   = '!',
+    /* Passed to the apply function with NULL data after changes of other
+     * instances have been applied, never written to the journal */
+    JOURNAL_READ    = '.',
+};
+
+Journal * journal_new(const char *filename, JournalApplyFunc apply, gpointer user_data);
+void journal_free(Journal *);
+gboolean journal_append(Journal *, char op, const char *data);
+void journal_read(Journal *);
+gboolean journal_compact(Journal *, JournalSnapshotFunc snapshot, gboolean force);
+#endif
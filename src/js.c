@@ -56,12 +56,87 @@ js_string_equals(JSContextRef ctx, JSValueRef val, const char *cmp)
     }
     return result;
 }
-void 
-js_set_object_property(JSContextRef ctx, JSObjectRef arg, const char *name, const char *value, JSValueRef *exc) 
+/* INTERNED PROPERTY NAMES {{{*/
+static const char *s_interned_names[JS_PROP_LAST] = {
+    [JS_PROP_ARG]                 = "arg", 
+    [JS_PROP_ARGUMENT]            = "argument", 
+    [JS_PROP_BODY]                = "body", 
+    [JS_PROP_BUTTON]              = "button", 
+    [JS_PROP_CALLBACK]            = "callback", 
+    [JS_PROP_CAN_GO_BACK]         = "canGoBack", 
+    [JS_PROP_CAN_GO_FORWARD]      = "canGoForward", 
+    [JS_PROP_COMMAND]             = "command", 
+    [JS_PROP_CONTENT_TYPE]        = "contentType", 
+    [JS_PROP_DATA]                = "data", 
+    [JS_PROP_DIRECTION]           = "direction", 
+    [JS_PROP_FRAGMENT]            = "fragment", 
+    [JS_PROP_HEADERS]             = "headers", 
+    [JS_PROP_HOST]                = "host", 
+    [JS_PROP_HOSTS]               = "hosts", 
+    [JS_PROP_INTERVAL]            = "interval", 
+    [JS_PROP_IS_BOOKMARKED]       = "isBookmarked", 
+    [JS_PROP_IS_MODIFIER]         = "isModifier", 
+    [JS_PROP_IS_QUICKMARKED]      = "isQuickmarked", 
+    [JS_PROP_KEY]                 = "key", 
+    [JS_PROP_KEY_CODE]            = "keyCode", 
+    [JS_PROP_KEY_VAL]             = "keyVal", 
+    [JS_PROP_LABEL]               = "label", 
+    [JS_PROP_LEFT]                = "left", 
+    [JS_PROP_LINES]               = "lines", 
+    [JS_PROP_MAIN_FRAME]          = "mainFrame", 
+    [JS_PROP_MENU]                = "menu", 
+    [JS_PROP_METHOD]              = "method", 
+    [JS_PROP_MICRO]               = "micro", 
+    [JS_PROP_MODIFIER]            = "modifier", 
+    [JS_PROP_NAME]                = "name", 
+    [JS_PROP_NUMMOD]              = "nummod", 
+    [JS_PROP_ON_CHUNK]            = "onChunk", 
+    [JS_PROP_PASSWORD]            = "password", 
+    [JS_PROP_PATH]                = "path", 
+    [JS_PROP_PLUGIN_BLOCKED]      = "pluginBlocked", 
+    [JS_PROP_PORT]                = "port", 
+    [JS_PROP_POSITION]            = "position", 
+    [JS_PROP_QUERY]               = "query", 
+    [JS_PROP_RIGHT]               = "right", 
+    [JS_PROP_SCHEME]              = "scheme", 
+    [JS_PROP_SCHEMES]             = "schemes", 
+    [JS_PROP_SCRIPTS_BLOCKED]     = "scriptsBlocked", 
+    [JS_PROP_SECONDS]             = "seconds", 
+    [JS_PROP_SIZE]                = "size", 
+    [JS_PROP_SSL]                 = "ssl", 
+    [JS_PROP_STATE]               = "state", 
+    [JS_PROP_STATUS]              = "status", 
+    [JS_PROP_STDERR]              = "stderr", 
+    [JS_PROP_STDOUT]              = "stdout", 
+    [JS_PROP_TIME]                = "time", 
+    [JS_PROP_TYPE]                = "type", 
+    [JS_PROP_URI]                 = "uri", 
+    [JS_PROP_USER]                = "user", 
+    [JS_PROP_X]                   = "x", 
+    [JS_PROP_X_ROOT]              = "xRoot", 
+    [JS_PROP_Y]                   = "y", 
+    [JS_PROP_Y_ROOT]              = "yRoot", 
+};
+static JSStringRef s_interned[JS_PROP_LAST];
+
+/* js_interned(int) {{{*/
+/* 
+ * Returns the interned JSStringRef of a JS_PROP_* name, interned strings are
+ * created once and never released
+ * */
+JSStringRef 
+js_interned(int name) 
 {
-    g_return_if_fail(name != NULL);
+    g_return_val_if_fail(name >= 0 && name < JS_PROP_LAST, NULL);
 
-    JSStringRef js_key = JSStringCreateWithUTF8CString(name);
+    if (s_interned[name] == NULL)
+        s_interned[name] = JSStringCreateWithUTF8CString(s_interned_names[name]);
+    return s_interned[name];
+}/*}}}*//*}}}*/
+
+static void 
+js_set_string_property(JSContextRef ctx, JSObjectRef arg, JSStringRef js_key, const char *value, JSValueRef *exc) 
+{
     JSValueRef js_value;
     if (value != NULL)
         js_value = js_char_to_value(ctx, value);
@@ -69,8 +144,21 @@ js_set_object_property(JSContextRef ctx, JSObjectRef arg, const char *name, cons
         js_value = JSValueMakeNull(ctx);
         
     JSObjectSetProperty(ctx, arg, js_key, js_value, kJSPropertyAttributeDontDelete | kJSPropertyAttributeReadOnly, exc);
+}
+void 
+js_set_object_property(JSContextRef ctx, JSObjectRef arg, const char *name, const char *value, JSValueRef *exc) 
+{
+    g_return_if_fail(name != NULL);
+
+    JSStringRef js_key = JSStringCreateWithUTF8CString(name);
+    js_set_string_property(ctx, arg, js_key, value, exc);
     JSStringRelease(js_key);
 }
+void 
+js_set_object_property_interned(JSContextRef ctx, JSObjectRef arg, int name, const char *value, JSValueRef *exc) 
+{
+    js_set_string_property(ctx, arg, js_interned(name), value, exc);
+}
 gboolean 
 js_object_has_property(JSContextRef ctx, JSObjectRef arg, const char *name)
 {
@@ -87,15 +175,18 @@ js_set_object_number_property(JSContextRef ctx, JSObjectRef arg, const char *nam
     JSObjectSetProperty(ctx, arg, js_key, js_value, kJSPropertyAttributeDontDelete | kJSPropertyAttributeReadOnly, exc);
     JSStringRelease(js_key);
 }
+void 
+js_set_object_number_property_interned(JSContextRef ctx, JSObjectRef arg, int name, gdouble value, JSValueRef *exc) 
+{
+    JSObjectSetProperty(ctx, arg, js_interned(name), JSValueMakeNumber(ctx, value), kJSPropertyAttributeDontDelete | kJSPropertyAttributeReadOnly, exc);
+}
 /* js_get_object_property {{{*/
-JSObjectRef 
-js_get_object_property(JSContextRef ctx, JSObjectRef arg, const char *name) 
+static JSObjectRef 
+js_property_to_object(JSContextRef ctx, JSObjectRef arg, JSStringRef js_name) 
 {
     JSValueRef exc = NULL;
     JSObjectRef ret;
-    JSStringRef buffer = JSStringCreateWithUTF8CString(name);
-    JSValueRef val = JSObjectGetProperty(ctx, arg, buffer, &exc);
-    JSStringRelease(buffer);
+    JSValueRef val = JSObjectGetProperty(ctx, arg, js_name, &exc);
     if (exc != NULL || !JSValueIsObject(ctx, val)) 
         return NULL;
 
@@ -103,6 +194,19 @@ js_get_object_property(JSContextRef ctx, JSObjectRef arg, const char *name)
     if (exc != NULL)
         return NULL;
     return ret;
+}
+JSObjectRef 
+js_get_object_property(JSContextRef ctx, JSObjectRef arg, const char *name) 
+{
+    JSStringRef buffer = JSStringCreateWithUTF8CString(name);
+    JSObjectRef ret = js_property_to_object(ctx, arg, buffer);
+    JSStringRelease(buffer);
+    return ret;
+}
+JSObjectRef 
+js_get_object_property_interned(JSContextRef ctx, JSObjectRef arg, int name) 
+{
+    return js_property_to_object(ctx, arg, js_interned(name));
 }/*}}}*/
 
 JSValueRef 
@@ -114,33 +218,55 @@ js_char_to_value(JSContextRef ctx, const char *text)
     return ret;
 }
 /* js_get_string_property {{{*/
-char * 
-js_get_string_property(JSContextRef ctx, JSObjectRef arg, const char *name) 
+static char * 
+js_property_to_char(JSContextRef ctx, JSObjectRef arg, JSStringRef js_name) 
 {
     JSValueRef exc = NULL;
-    JSStringRef buffer = JSStringCreateWithUTF8CString(name);
-    JSValueRef val = JSObjectGetProperty(ctx, arg, buffer, &exc);
-    JSStringRelease(buffer);
+    JSValueRef val = JSObjectGetProperty(ctx, arg, js_name, &exc);
     if (exc != NULL || !JSValueIsString(ctx, val) )
         return NULL;
     return js_value_to_char(ctx, val, JS_STRING_MAX, NULL);
+}
+char * 
+js_get_string_property(JSContextRef ctx, JSObjectRef arg, const char *name) 
+{
+    JSStringRef buffer = JSStringCreateWithUTF8CString(name);
+    char *ret = js_property_to_char(ctx, arg, buffer);
+    JSStringRelease(buffer);
+    return ret;
+}
+char * 
+js_get_string_property_interned(JSContextRef ctx, JSObjectRef arg, int name) 
+{
+    return js_property_to_char(ctx, arg, js_interned(name));
 }/*}}}*/
 
 /* js_get_double_property {{{*/
-double  
-js_get_double_property(JSContextRef ctx, JSObjectRef arg, const char *name) 
+static double  
+js_property_to_double(JSContextRef ctx, JSObjectRef arg, JSStringRef js_name) 
 {
     double ret;
     JSValueRef exc = NULL;
-    JSStringRef buffer = JSStringCreateWithUTF8CString(name);
-    JSValueRef val = JSObjectGetProperty(ctx, arg, buffer, &exc);
-    JSStringRelease(buffer);
+    JSValueRef val = JSObjectGetProperty(ctx, arg, js_name, &exc);
     if (exc != NULL || !JSValueIsNumber(ctx, val) )
         return NAN;
     ret = JSValueToNumber(ctx, val, &exc);
     if (exc != NULL)
         return NAN;
     return ret;
+}
+double  
+js_get_double_property(JSContextRef ctx, JSObjectRef arg, const char *name) 
+{
+    JSStringRef buffer = JSStringCreateWithUTF8CString(name);
+    double ret = js_property_to_double(ctx, arg, buffer);
+    JSStringRelease(buffer);
+    return ret;
+}
+double  
+js_get_double_property_interned(JSContextRef ctx, JSObjectRef arg, int name) 
+{
+    return js_property_to_double(ctx, arg, js_interned(name));
 }/*}}}*/
 double 
 js_val_get_double_property(JSContextRef ctx, JSValueRef val, const char *name, JSValueRef *exc)
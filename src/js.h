@@ -20,6 +20,69 @@
 #define __DWB_JS_H__
 #include <JavaScriptCore/JavaScript.h>
 
+/* Interned property names, see js_interned */
+enum {
+  JS_PROP_ARG, 
+  JS_PROP_ARGUMENT, 
+  JS_PROP_BODY, 
+  JS_PROP_BUTTON, 
+  JS_PROP_CALLBACK, 
+  JS_PROP_CAN_GO_BACK, 
+  JS_PROP_CAN_GO_FORWARD, 
+  JS_PROP_COMMAND, 
+  JS_PROP_CONTENT_TYPE, 
+  JS_PROP_DATA, 
+  JS_PROP_DIRECTION, 
+  JS_PROP_FRAGMENT, 
+  JS_PROP_HEADERS, 
+  JS_PROP_HOST, 
+  JS_PROP_HOSTS, 
+  JS_PROP_INTERVAL, 
+  JS_PROP_IS_BOOKMARKED, 
+  JS_PROP_IS_MODIFIER, 
+  JS_PROP_IS_QUICKMARKED, 
+  JS_PROP_KEY, 
+  JS_PROP_KEY_CODE, 
+  JS_PROP_KEY_VAL, 
+  JS_PROP_LABEL, 
+  JS_PROP_LEFT, 
+  JS_PROP_LINES, 
+  JS_PROP_MAIN_FRAME, 
+  JS_PROP_MENU, 
+  JS_PROP_METHOD, 
+  JS_PROP_MICRO, 
+  JS_PROP_MODIFIER, 
+  JS_PROP_NAME, 
+  JS_PROP_NUMMOD, 
+  JS_PROP_ON_CHUNK, 
+  JS_PROP_PASSWORD, 
+  JS_PROP_PATH, 
+  JS_PROP_PLUGIN_BLOCKED, 
+  JS_PROP_PORT, 
+  JS_PROP_POSITION, 
+  JS_PROP_QUERY, 
+  JS_PROP_RIGHT, 
+  JS_PROP_SCHEME, 
+  JS_PROP_SCHEMES, 
+  JS_PROP_SCRIPTS_BLOCKED, 
+  JS_PROP_SECONDS, 
+  JS_PROP_SIZE, 
+  JS_PROP_SSL, 
+  JS_PROP_STATE, 
+  JS_PROP_STATUS, 
+  JS_PROP_STDERR, 
+  JS_PROP_STDOUT, 
+  JS_PROP_TIME, 
+  JS_PROP_TYPE, 
+  JS_PROP_URI, 
+  JS_PROP_USER, 
+  JS_PROP_X, 
+  JS_PROP_X_ROOT, 
+  JS_PROP_Y, 
+  JS_PROP_Y_ROOT, 
+  JS_PROP_LAST, 
+};
+
 typedef struct js_iterator_s js_array_iterator;
 typedef struct js_property_iterator_s js_property_iterator;
 
@@ -61,6 +124,13 @@ JSObjectRef js_value_to_function(JSContextRef, JSValueRef, JSValueRef *);
 gboolean js_check_syntax(JSContextRef ctx, const char *script, const char *filename, int lineOffset);
 gboolean js_object_has_property(JSContextRef ctx, JSObjectRef arg, const char *name);
 
+JSStringRef js_interned(int name);
+JSObjectRef js_get_object_property_interned(JSContextRef ctx, JSObjectRef arg, int name);
+char * js_get_string_property_interned(JSContextRef ctx, JSObjectRef arg, int name);
+double js_get_double_property_interned(JSContextRef ctx, JSObjectRef arg, int name);
+void js_set_object_property_interned(JSContextRef ctx, JSObjectRef arg, int name, const char *value, JSValueRef *exc);
+void js_set_object_number_property_interned(JSContextRef ctx, JSObjectRef arg, int name, gdouble value, JSValueRef *exc);
+
 void js_array_iterator_init(JSContextRef ctx, js_array_iterator *iter, JSObjectRef object);
 JSValueRef js_array_iterator_next(js_array_iterator *iter, JSValueRef *exc);
 void js_array_iterator_finish(js_array_iterator *iter);
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2010-2014 Stefan Bolte <portix@gmx.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+#include "dwb.h"
+#include "domain.h"
+#include "requestpolicy.h"
+
+/*
+ * Native third-party request policy. Requests from a base domain other than
+ * the base domain of the first party are blocked unless 
+ *
+ *  - the first party allows all third-party requests, 
+ *  - the third-party domain is allowed on all sites or
+ *  - the third-party domain is whitelisted for the first party
+ *
+ * Domains that are blocked on all sites have the highest precedence. Every
+ * list is a DomainIndex, entries are either persistent or temporary, the
+ * policy is configured by scripts and only applied if it is enabled.
+ * */
+
+static gboolean s_enabled;
+/* first party base domain -> DomainIndex of allowed domains */
+static GHashTable *s_first_parties;
+/* first parties that allow all third-party requests */
+static DomainIndex *s_allow_all;
+/* domains allowed on all sites */
+static DomainIndex *s_always;
+/* domains blocked on all sites */
+static DomainIndex *s_always_block;
+
+/* request_policy_set_enabled(gboolean) {{{*/
+void 
+request_policy_set_enabled(gboolean enabled) 
+{
+    s_enabled = enabled;
+}/*}}}*/
+
+/* request_policy_enabled() {{{*/
+gboolean 
+request_policy_enabled() 
+{
+    return s_enabled;
+}/*}}}*/
+
+/* request_policy_allow(const char *, const char *, guint) {{{*/
+/* 
+ * Whitelists domain for first_party, if first_party is NULL domain is allowed
+ * on all sites, if domain is NULL all requests are allowed on first_party
+ * */
+gboolean 
+request_policy_allow(const char *first_party, const char *domain, guint flags) 
+{
+    g_return_val_if_fail(first_party != NULL || domain != NULL, false);
+
+    DomainIndex *index;
+
+    if (first_party == NULL)
+        return domain_index_add(s_always, domain, flags);
+    if (domain == NULL)
+        return domain_index_add(s_allow_all, first_party, flags);
+
+    index = g_hash_table_lookup(s_first_parties, first_party);
+    if (index == NULL) 
+    {
+        index = domain_index_new();
+        g_hash_table_insert(s_first_parties, g_strdup(first_party), index);
+    }
+    return domain_index_add(index, domain, flags);
+}/*}}}*/
+
+/* request_policy_disallow(const char *, const char *, guint) {{{*/
+/* 
+ * Removes an entry added with request_policy_allow, if first_party is not NULL
+ * and domain is NULL all entries of first_party are removed
+ * */
+gboolean 
+request_policy_disallow(const char *first_party, const char *domain, guint flags) 
+{
+    g_return_val_if_fail(first_party != NULL || domain != NULL, false);
+
+    DomainIndex *index;
+    gboolean ret;
+
+    if (first_party == NULL)
+        return domain_index_remove(s_always, domain, flags);
+
+    if (domain == NULL) 
+    {
+        ret = domain_index_remove(s_allow_all, first_party, flags);
+        if ((index = g_hash_table_lookup(s_first_parties, first_party)) != NULL) 
+            domain_index_clear(index, flags);
+        return ret;
+    }
+
+    index = g_hash_table_lookup(s_first_parties, first_party);
+    return index != NULL && domain_index_remove(index, domain, flags);
+}/*}}}*/
+
+/* request_policy_block(const char *, guint) {{{*/
+gboolean 
+request_policy_block(const char *domain, guint flags) 
+{
+    g_return_val_if_fail(domain != NULL, false);
+
+    return domain_index_add(s_always_block, domain, flags);
+}/*}}}*/
+
+/* request_policy_unblock(const char *, guint) {{{*/
+gboolean 
+request_policy_unblock(const char *domain, guint flags) 
+{
+    g_return_val_if_fail(domain != NULL, false);
+
+    return domain_index_remove(s_always_block, domain, flags);
+}/*}}}*/
+
+/* request_policy_clear(guint) {{{*/
+void 
+request_policy_clear(guint flags) 
+{
+    GHashTableIter iter;
+    gpointer value;
+
+    domain_index_clear(s_allow_all, flags);
+    domain_index_clear(s_always, flags);
+    domain_index_clear(s_always_block, flags);
+
+    g_hash_table_iter_init(&iter, s_first_parties);
+    while (g_hash_table_iter_next(&iter, NULL, &value)) 
+        domain_index_clear(value, flags);
+}/*}}}*/
+
+/* request_policy_allowed(const char *, const char *) {{{*/
+/* 
+ * Checks if requests to the base domain domain are allowed on the base domain
+ * first_party 
+ * */
+gboolean 
+request_policy_allowed(const char *first_party, const char *domain) 
+{
+    DomainIndex *index;
+
+    if (first_party == NULL || domain == NULL || !strcmp(first_party, domain))
+        return true;
+    if (domain_index_match_host(s_always_block, domain))
+        return false;
+    if (domain_index_match_host(s_allow_all, first_party) || domain_index_match_host(s_always, domain)) 
+        return true;
+    index = g_hash_table_lookup(s_first_parties, first_party);
+    return index != NULL && domain_index_match_host(index, domain);
+}/*}}}*/
+
+/* request_policy_check(GList *, WebKitNetworkRequest *) {{{*/
+/* 
+ * Applies the policy to a request, blocked requests are redirected to
+ * about:blank and counted in the view. Returns true if the request was
+ * blocked.
+ * */
+gboolean 
+request_policy_check(GList *gl, WebKitNetworkRequest *request) 
+{
+    View *v = VIEW(gl);
+    SoupMessage *msg;
+    SoupURI *suri;
+    const char *host, *first_host, *domain, *first_party;
+
+    if (!s_enabled)
+        return false;
+
+    msg = webkit_network_request_get_message(request);
+    if (msg == NULL)
+        return false;
+
+    suri = soup_message_get_uri(msg);
+    if (suri == NULL || (host = soup_uri_get_host(suri)) == NULL || *host == '\0')
+        return false;
+
+    if ((suri = soup_message_get_first_party(msg)) == NULL || (first_host = soup_uri_get_host(suri)) == NULL)
+        return false;
+
+    domain = domain_get_base_for_host(host);
+    first_party = domain_get_base_for_host(first_host);
+    if (domain == NULL || first_party == NULL || !strcmp(domain, first_party))
+        return false;
+
+    if (v->status->third_party == NULL)
+        v->status->third_party = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+    if (!g_hash_table_contains(v->status->third_party, domain))
+        g_hash_table_add(v->status->third_party, g_strdup(domain));
+
+    if (request_policy_allowed(first_party, domain))
+        return false;
+
+    webkit_network_request_set_uri(request, "about:blank");
+    v->status->blocked_requests++;
+    return true;
+}/*}}}*/
+
+/* request_policy_reset(GList *) {{{*/
+/* Resets the counters of a view, called when a new page is loaded */
+void 
+request_policy_reset(GList *gl) 
+{
+    View *v = VIEW(gl);
+
+    v->status->blocked_requests = 0;
+    if (v->status->third_party != NULL)
+        g_hash_table_remove_all(v->status->third_party);
+}/*}}}*/
+
+/* request_policy_end() {{{*/
+void 
+request_policy_end() 
+{
+    if (s_first_parties == NULL)
+        return;
+    g_hash_table_unref(s_first_parties);
+    domain_index_free(s_allow_all);
+    domain_index_free(s_always);
+    domain_index_free(s_always_block);
+    s_first_parties = NULL;
+    s_enabled = false;
+}/*}}}*/
+
+/* request_policy_init() {{{*/
+void 
+request_policy_init() 
+{
+    if (s_first_parties != NULL)
+        return;
+    s_first_parties = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, (GDestroyNotify)domain_index_free);
+    s_allow_all = domain_index_new();
+    s_always = domain_index_new();
+    s_always_block = domain_index_new();
+}/*}}}*/
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2010-2014 Stefan Bolte <portix@gmx.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __DWB_REQUEST_POLICY_H__
+#define __DWB_REQUEST_POLICY_H__
+
+enum {
+    REQUEST_POLICY_PERSISTENT = DOMAIN_INDEX_PERSISTENT,
+    REQUEST_POLICY_TEMPORARY  = DOMAIN_INDEX_TEMPORARY,
+};
+#define REQUEST_POLICY_ALL (REQUEST_POLICY_PERSISTENT | REQUEST_POLICY_TEMPORARY)
+
+void request_policy_init(void);
+void request_policy_end(void);
+void request_policy_set_enabled(gboolean);
+gboolean request_policy_enabled(void);
+gboolean request_policy_allow(const char *first_party, const char *domain, guint flags);
+gboolean request_policy_disallow(const char *first_party, const char *domain, guint flags);
+gboolean request_policy_block(const char *domain, guint flags);
+gboolean request_policy_unblock(const char *domain, guint flags);
+void request_policy_clear(guint flags);
+gboolean request_policy_allowed(const char *first_party, const char *domain);
+gboolean request_policy_check(GList *gl, WebKitNetworkRequest *request);
+void request_policy_reset(GList *gl);
+#endif
@@ -37,7 +37,7 @@
 "var xprovide=function(n,m,o){provide(n+exports.id,m,o);};"\
 "var xrequire=function(n){return require(n+exports.id);};/*<dwb*/"
 
-#define SCRIPT_TEMPLATE_END "%s/*dwb>*/}catch(e){script.debug(e);} if(exports && !exports.id) return exports;"
+#define SCRIPT_TEMPLATE_END "%.*s/*dwb>*/}catch(e){script.debug(e);}finally{_finishContext();} if(exports && !exports.id) return exports;"
 
 #define SCRIPT_TEMPLATE SCRIPT_TEMPLATE_START"//!javascript\n"SCRIPT_TEMPLATE_END
 #define SCRIPT_TEMPLATE_INCLUDE SCRIPT_TEMPLATE_START SCRIPT_TEMPLATE_END
@@ -424,6 +424,7 @@ unbind_free_keymap(JSContextRef ctx, GList *l)
     g_free(m->map);
     g_free(m);
     dwb.keymap = g_list_delete_link(dwb.keymap, l);
+    dwb_keymap_changed();
 }
 
 
@@ -449,7 +450,6 @@ unbind_free_keymap(JSContextRef ctx, GList *l)
 DwbStatus
 scripts_eval_key(KeyMap *m, Arg *arg) 
 {
-    char *json = NULL;
     int nummod = dwb.state.nummod;
 
     if (! (m->map->prop & CP_OVERRIDE)) {
@@ -459,22 +459,21 @@ scripts_eval_key(KeyMap *m, Arg *arg)
 
     if (s_ctx != NULL && s_ctx->global_context != NULL)
     {
+        JSObjectRef payload;
         if (arg->p == NULL) 
-            json = util_create_json(3, CHAR, "key", m->key, 
-                    INTEGER, "modifier", m->mod,  
-                    INTEGER, "nummod", nummod);
+            payload = scripts_create_payload(3, CHAR, JS_PROP_KEY, m->key, 
+                    INTEGER, JS_PROP_MODIFIER, m->mod,  
+                    INTEGER, JS_PROP_NUMMOD, nummod);
         else 
-            json = util_create_json(4, CHAR, "key", m->key, 
-                    INTEGER, "modifier", m->mod,  
-                    INTEGER, "nummod", nummod,
-                    CHAR, "arg", arg->p);
+            payload = scripts_create_payload(4, CHAR, JS_PROP_KEY, m->key, 
+                    INTEGER, JS_PROP_MODIFIER, m->mod,  
+                    INTEGER, JS_PROP_NUMMOD, nummod,
+                    CHAR, JS_PROP_ARG, arg->p);
 
-        JSValueRef argv[] = { js_json_to_value(s_ctx->global_context, json) };
+        JSValueRef argv[] = { payload != NULL ? payload : NIL };
         scripts_call_as_function(s_ctx->global_context, arg->js, arg->js, 1, argv);
     }
 
-    g_free(json);
-
     return STATUS_OK;
 }/*}}}*/
 
@@ -532,19 +531,21 @@ settings_get(JSContextRef ctx, JSObjectRef jsobj, JSStringRef js_name, JSValueRe
 /*}}}*/
 
 JSValueRef 
-scripts_include(JSContextRef ctx, const char *path, const char *script, gboolean global, gboolean is_archive, size_t argc, const JSValueRef *argv, JSValueRef *exc)
+scripts_include(JSContextRef ctx, const char *path, const char *script, int length, gboolean global, gboolean is_archive, size_t argc, const JSValueRef *argv, JSValueRef *exc)
 {
     JSStringRef js_script;
     JSValueRef ret = NIL;
 
     if (global)
     {
-        js_script = JSStringCreateWithUTF8CString(script);
+        char *copy = length < 0 ? NULL : g_strndup(script, length);
+        js_script = JSStringCreateWithUTF8CString(copy != NULL ? copy : script);
         ret = JSEvaluateScript(ctx, js_script, NULL, NULL, 0, exc);
+        g_free(copy);
     }
     else 
     {
-        char *debug = g_strdup_printf(is_archive ? SCRIPT_TEMPLATE_XINCLUDE : SCRIPT_TEMPLATE_INCLUDE, path, script);
+        char *debug = g_strdup_printf(is_archive ? SCRIPT_TEMPLATE_XINCLUDE : SCRIPT_TEMPLATE_INCLUDE, path, length, script);
         js_script = JSStringCreateWithUTF8CString(debug);
         JSObjectRef function = JSObjectMakeFunction(ctx, NULL, 0, NULL, js_script, NULL, 1, exc);
         if (function != NULL) 
@@ -591,6 +592,411 @@ scripts_make_cookie(SoupCookie *cookie)
 /* gui {{{*/
 
 /* SIGNALS {{{*/
+/* PROFILER {{{*/
+/*
+ * The time of every signal emitted by dwb is always recorded, the time of
+ * single handlers is only recorded if profiling is enabled with
+ * Signal.profiling, handlers are recorded per owner, i.e. the script that
+ * connected the signal.
+ * */
+static ScriptProfile s_signal_profile[SCRIPTS_SIG_LAST];
+static GHashTable *s_handler_profile;
+static gboolean s_profiling;
+
+static void
+profile_free(ScriptProfile *profile) 
+{
+    g_free(profile->owner);
+    g_free(profile->signal);
+    g_free(profile);
+}
+static void 
+profile_record(ScriptProfile *profile, gint64 elapsed, gboolean exception) 
+{
+    profile->calls++;
+    profile->total += elapsed;
+    if (elapsed > profile->max)
+        profile->max = elapsed;
+    if (exception)
+        profile->exceptions++;
+}
+static gint 
+profile_compare(const ScriptProfile *a, const ScriptProfile *b) 
+{
+    return a->total < b->total ? 1 : a->total > b->total ? -1 : 0;
+}
+/* scripts_profile_get() {{{*/
+/* 
+ * Returns the recorded profiles sorted by total time, the list must be freed
+ * with g_list_free, the profiles are owned by the profiler
+ * */
+GList * 
+scripts_profile_get() 
+{
+    GList *list = NULL;
+    for (int i=SCRIPTS_SIG_FIRST; i<SCRIPTS_SIG_LAST; i++) 
+    {
+        if (s_signal_profile[i].calls > 0) 
+        {
+            s_signal_profile[i].signal = (char*)s_sigmap[i];
+            list = g_list_prepend(list, &s_signal_profile[i]);
+        }
+    }
+    if (s_handler_profile != NULL) 
+    {
+        GList *handlers = g_hash_table_get_values(s_handler_profile);
+        list = g_list_concat(list, handlers);
+    }
+    return g_list_sort(list, (GCompareFunc)profile_compare);
+}/*}}}*/
+
+void 
+scripts_profile_reset() 
+{
+    memset(s_signal_profile, 0, sizeof(s_signal_profile));
+    if (s_handler_profile != NULL)
+        g_hash_table_remove_all(s_handler_profile);
+}
+gboolean 
+scripts_profile_enabled() 
+{
+    return s_profiling;
+}
+
+static JSValueRef 
+signal_profile_now(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject, size_t argc, const JSValueRef argv[], JSValueRef* exc) 
+{
+    return JSValueMakeNumber(ctx, g_get_monotonic_time());
+}
+/* signal_profile_record(owner, signal, start, exception) {{{*/
+static JSValueRef 
+signal_profile_record(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject, size_t argc, const JSValueRef argv[], JSValueRef* exc) 
+{
+    char *owner, *signal, *key;
+    ScriptProfile *profile;
+    gint64 now = g_get_monotonic_time();
+
+    if (argc < 4)
+        return NIL;
+
+    signal = js_value_to_char(ctx, argv[1], JS_STRING_MAX, exc);
+    if (signal == NULL)
+        return NIL;
+    owner = JSValueIsString(ctx, argv[0]) ? js_value_to_char(ctx, argv[0], PATH_MAX, exc) : g_strdup("(unknown)");
+    key = g_strconcat(owner, "\n", signal, NULL);
+
+    if (s_handler_profile == NULL)
+        s_handler_profile = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, (GDestroyNotify)profile_free);
+
+    profile = g_hash_table_lookup(s_handler_profile, key);
+    if (profile == NULL) 
+    {
+        profile = g_malloc0(sizeof(ScriptProfile));
+        profile->owner = owner;
+        profile->signal = signal;
+        g_hash_table_insert(s_handler_profile, key, profile);
+    }
+    else 
+    {
+        g_free(owner);
+        g_free(signal);
+        g_free(key);
+    }
+    profile_record(profile, now - (gint64)JSValueToNumber(ctx, argv[2], exc), JSValueToBoolean(ctx, argv[3]));
+    return NIL;
+}/*}}}*/
+
+static JSValueRef 
+signal_profile_enable(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject, size_t argc, const JSValueRef argv[], JSValueRef* exc) 
+{
+    if (argc > 0)
+        s_profiling = JSValueToBoolean(ctx, argv[0]);
+    return NIL;
+}
+/* signal_profile_get {{{*/
+static JSValueRef 
+signal_profile_get(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject, size_t argc, const JSValueRef argv[], JSValueRef* exc) 
+{
+    GList *profiles = scripts_profile_get();
+    guint length = g_list_length(profiles), i = 0;
+    JSValueRef *values = g_malloc_n(length + 1, sizeof(JSValueRef));
+
+    for (GList *l = profiles; l; l=l->next, i++) 
+    {
+        ScriptProfile *p = l->data;
+        JSObjectRef o = JSObjectMake(ctx, NULL, NULL);
+        js_set_object_property(ctx, o, "owner", p->owner, exc);
+        js_set_object_property(ctx, o, "signal", p->signal, exc);
+        js_set_object_number_property(ctx, o, "calls", p->calls, exc);
+        js_set_object_number_property(ctx, o, "exceptions", p->exceptions, exc);
+        js_set_object_number_property(ctx, o, "total", p->total / 1000.0, exc);
+        js_set_object_number_property(ctx, o, "max", p->max / 1000.0, exc);
+        values[i] = o;
+    }
+    JSValueRef ret = JSObjectMakeArray(ctx, length, values, exc);
+
+    g_free(values);
+    g_list_free(profiles);
+    return ret;
+}/*}}}*/
+
+static JSValueRef 
+signal_profile_reset(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject, size_t argc, const JSValueRef argv[], JSValueRef* exc) 
+{
+    scripts_profile_reset();
+    return NIL;
+}
+/*}}}*/
+
+/* SIGNAL FILTERS {{{*/
+/*
+ * Signals connected with a filter object instead of a predicate function are
+ * matched natively, signals that no connected Signal is interested in are not
+ * emitted at all.
+ * */
+typedef struct _SignalFilter {
+    int signal;
+    int id;
+    gboolean any;
+    gboolean main_frame;
+    char **schemes;
+    DomainIndex *hosts;
+} SignalFilter;
+
+static GHashTable *s_signal_filters;
+static GSList *s_filters[SCRIPTS_SIG_LAST];
+static int s_unfiltered[SCRIPTS_SIG_LAST];
+static int s_filtered[SCRIPTS_SIG_LAST];
+static GHashTable *s_filter_matches[SCRIPTS_SIG_LAST];
+
+/* signal_filter_free {{{*/
+static void
+signal_filter_free(SignalFilter *filter) 
+{
+    g_strfreev(filter->schemes);
+    if (filter->hosts != NULL)
+        domain_index_free(filter->hosts);
+    g_free(filter);
+}/*}}}*/
+
+/* signal_filter_remove(SignalFilter *) {{{*/
+static void
+signal_filter_remove(SignalFilter *filter) 
+{
+    s_filters[filter->signal] = g_slist_remove(s_filters[filter->signal], filter);
+    if (filter->any)
+        s_unfiltered[filter->signal]--;
+    else 
+        s_filtered[filter->signal]--;
+    g_hash_table_remove(s_signal_filters, GINT_TO_POINTER(filter->id));
+}/*}}}*/
+
+/* signal_filter_clear(int signal) {{{*/
+static void
+signal_filter_clear(int signal) 
+{
+    while (s_filters[signal] != NULL)
+        signal_filter_remove(s_filters[signal]->data);
+}/*}}}*/
+
+/* signal_filter_get_strv(JSContextRef, JSObjectRef, int) {{{*/
+static char **
+signal_filter_get_strv(JSContextRef ctx, JSObjectRef object, int name) 
+{
+    js_array_iterator iter;
+    JSValueRef value;
+    GPtrArray *array;
+
+    JSObjectRef list = js_get_object_property_interned(ctx, object, name);
+    if (list == NULL)
+        return NULL;
+
+    array = g_ptr_array_new();
+    js_array_iterator_init(ctx, &iter, list);
+    while ((value = js_array_iterator_next(&iter, NULL)) != NULL) 
+    {
+        char *item = js_value_to_char(ctx, value, JS_STRING_MAX, NULL);
+        if (item != NULL)
+            g_ptr_array_add(array, item);
+    }
+    js_array_iterator_finish(&iter);
+    if (array->len == 0) 
+    {
+        g_ptr_array_free(array, true);
+        return NULL;
+    }
+    g_ptr_array_add(array, NULL);
+    return (char **)g_ptr_array_free(array, false);
+}/*}}}*/
+
+/* signal_filter_matches(SignalFilter *, int, const char *, const char *) {{{*/
+static gboolean
+signal_filter_matches(SignalFilter *filter, int main_frame, const char *uri, const char *host) 
+{
+    if (filter->main_frame && main_frame == 0)
+        return false;
+    if (filter->schemes != NULL && uri != NULL) 
+    {
+        const char *end = strchr(uri, ':');
+        gboolean match = false;
+        for (int i=0; end != NULL && filter->schemes[i] != NULL && !match; i++)
+            match = strlen(filter->schemes[i]) == (size_t)(end - uri) && !g_ascii_strncasecmp(filter->schemes[i], uri, end - uri);
+        if (!match)
+            return false;
+    }
+    if (filter->hosts != NULL && host != NULL && !domain_index_match_host(filter->hosts, host)) 
+        return false;
+    return true;
+}/*}}}*/
+
+/* signal_filter_emission(ScriptSignal *) {{{*/
+/* 
+ * Returns the ids of all filtered Signals that want the emission or NULL if
+ * the signal has no filters, matches is set to false if no Signal wants the
+ * emission at all.
+ * */
+static GHashTable *
+signal_filter_emission(ScriptSignal *sig, gboolean *matches) 
+{
+    WebKitWebFrame *frame = NULL;
+    WebKitNetworkRequest *request = NULL;
+    const char *uri = NULL, *host = NULL;
+    int main_frame = -1;
+    GHashTable *ids;
+
+    *matches = true;
+    if (s_filtered[sig->signal] == 0)
+        return NULL;
+
+    for (int i=0; i<sig->numobj; i++) 
+    {
+        if (sig->objects[i] == NULL)
+            continue;
+        if (frame == NULL && WEBKIT_IS_WEB_FRAME(sig->objects[i]))
+            frame = WEBKIT_WEB_FRAME(sig->objects[i]);
+        else if (request == NULL && WEBKIT_IS_NETWORK_REQUEST(sig->objects[i]))
+            request = WEBKIT_NETWORK_REQUEST(sig->objects[i]);
+    }
+    if (frame != NULL) 
+    {
+        main_frame = frame == webkit_web_view_get_main_frame(webkit_web_frame_get_web_view(frame));
+        uri = webkit_web_frame_get_uri(frame);
+        host = dwb_soup_get_host(frame);
+    }
+    if (request != NULL) 
+    {
+        uri = webkit_network_request_get_uri(request);
+        host = dwb_soup_get_host_from_request(request);
+    }
+
+    ids = g_hash_table_new(NULL, NULL);
+    for (GSList *l = s_filters[sig->signal]; l; l=l->next) 
+    {
+        SignalFilter *filter = l->data;
+        if (!filter->any && signal_filter_matches(filter, main_frame, uri, host))
+            g_hash_table_add(ids, GINT_TO_POINTER(filter->id));
+    }
+    *matches = s_unfiltered[sig->signal] > 0 || g_hash_table_size(ids) > 0;
+    return ids;
+}/*}}}*/
+
+/** 
+ * Registers the native filter of a connected Signal
+ *
+ * @name _addFilter
+ * @memberOf signals
+ * @function
+ * @private
+ *
+ * @param {String} name     The signal name
+ * @param {Number} id       The id of the Signal
+ * @param {Object} [filter] The filter, if omitted the Signal gets every emission
+ * @param {Boolean} [filter.mainFrame]  Only emissions for the main frame
+ * @param {Array} [filter.hosts]        Hosts or domains, subdomains also match 
+ * @param {Array} [filter.schemes]      Uri schemes, e.g. <i>["http", "https"]</i>
+ * */
+/* signal_add_filter {{{*/
+static JSValueRef 
+signal_add_filter(JSContextRef ctx, JSObjectRef function, JSObjectRef this, size_t argc, const JSValueRef argv[], JSValueRef* exc) 
+{
+    int signal = -1;
+    char **hosts;
+    if (argc < 2) 
+        return NIL;
+
+    char *name = js_value_to_char(ctx, argv[0], PROP_LENGTH, exc);
+    if (name == NULL)
+        return NIL;
+    for (int i = SCRIPTS_SIG_FIRST; i<SCRIPTS_SIG_LAST && signal == -1; i++) 
+    {
+        if (!strcmp(name, s_sigmap[i]))
+            signal = i;
+    }
+    g_free(name);
+    if (signal == -1)
+        return NIL;
+
+    SignalFilter *filter = g_malloc0(sizeof(SignalFilter));
+    filter->signal = signal;
+    filter->id = (int)JSValueToNumber(ctx, argv[1], exc);
+
+    JSObjectRef o = argc > 2 && JSValueIsObject(ctx, argv[2]) ? JSValueToObject(ctx, argv[2], exc) : NULL;
+    if (o != NULL) 
+    {
+        filter->main_frame = JSValueToBoolean(ctx, JSObjectGetProperty(ctx, o, js_interned(JS_PROP_MAIN_FRAME), exc));
+        filter->schemes = signal_filter_get_strv(ctx, o, JS_PROP_SCHEMES);
+        if ((hosts = signal_filter_get_strv(ctx, o, JS_PROP_HOSTS)) != NULL) 
+        {
+            filter->hosts = domain_index_new();
+            for (int i=0; hosts[i]; i++)
+                domain_index_add(filter->hosts, hosts[i], DOMAIN_INDEX_PERSISTENT);
+            g_strfreev(hosts);
+        }
+    }
+    filter->any = !filter->main_frame && filter->schemes == NULL && filter->hosts == NULL;
+
+    SignalFilter *old = g_hash_table_lookup(s_signal_filters, GINT_TO_POINTER(filter->id));
+    if (old != NULL)
+        signal_filter_remove(old);
+
+    g_hash_table_insert(s_signal_filters, GINT_TO_POINTER(filter->id), filter);
+    s_filters[signal] = g_slist_prepend(s_filters[signal], filter);
+    if (filter->any)
+        s_unfiltered[signal]++;
+    else 
+        s_filtered[signal]++;
+    return NIL;
+}/*}}}*/
+
+/* signal_remove_filter {{{*/
+static JSValueRef 
+signal_remove_filter(JSContextRef ctx, JSObjectRef function, JSObjectRef this, size_t argc, const JSValueRef argv[], JSValueRef* exc) 
+{
+    if (argc > 0) 
+    {
+        SignalFilter *filter = g_hash_table_lookup(s_signal_filters, GINT_TO_POINTER((int)JSValueToNumber(ctx, argv[0], exc)));
+        if (filter != NULL)
+            signal_filter_remove(filter);
+    }
+    return NIL;
+}/*}}}*/
+
+/* signal_filter_matches_cb {{{*/
+static JSValueRef 
+signal_filter_matches_cb(JSContextRef ctx, JSObjectRef function, JSObjectRef this, size_t argc, const JSValueRef argv[], JSValueRef* exc) 
+{
+    gboolean ret = true;
+    if (argc > 0) 
+    {
+        int id = (int)JSValueToNumber(ctx, argv[0], exc);
+        SignalFilter *filter = g_hash_table_lookup(s_signal_filters, GINT_TO_POINTER(id));
+        if (filter != NULL && s_filter_matches[filter->signal] != NULL)
+            ret = g_hash_table_contains(s_filter_matches[filter->signal], GINT_TO_POINTER(id));
+    }
+    return JSValueMakeBoolean(ctx, ret);
+}/*}}}*/
+/*}}}*/
+
 /* signal_set {{{*/
 static bool
 signal_set(JSContextRef ctx, JSObjectRef object, JSStringRef js_name, JSValueRef value, JSValueRef* exception) 
@@ -629,6 +1035,7 @@ signal_set(JSContextRef ctx, JSObjectRef object, JSStringRef js_name, JSValueRef
         if (strcmp(name, s_sigmap[i])) 
             continue;
 
+        signal_filter_clear(i);
         if (JSValueIsNull(ctx, value)) 
         {
             s_ctx->sig_objects[i] = NULL;
@@ -653,7 +1060,8 @@ scripts_emit(ScriptSignal *sig)
     g_return_val_if_fail(s_ctx != NULL, false);
 
     int numargs, i, additional = 0;
-    gboolean ret = false;
+    gboolean ret = false, matches;
+    GHashTable *filter_matches, *previous_matches;
     JSObjectRef function = s_ctx->sig_objects[sig->signal];
     if (function == NULL)
         return false;
@@ -663,17 +1071,24 @@ scripts_emit(ScriptSignal *sig)
 
     EXEC_LOCK_RETURN(false);
 
+    /* Evaluate native filters before any wrapper object is created */
+    filter_matches = signal_filter_emission(sig, &matches);
+    if (!matches) 
+        goto unlock;
+
     PROTECT_SIGNAL(sig->signal);
+    previous_matches = s_filter_matches[sig->signal];
+    s_filter_matches[sig->signal] = filter_matches;
 
     if (sig->jsobj != NULL)
         additional++;
-    if (sig->json != NULL)
+    if (sig->json != NULL || sig->payload != NULL)
         additional++;
     if (sig->arg != NULL)
         additional++;
 
     numargs = MIN(sig->numobj, SCRIPT_MAX_SIG_OBJECTS)+additional;
-    JSValueRef val[numargs];
+    JSValueRef val[SCRIPT_MAX_SIG_OBJECTS + 3];
     i = 0;
 
     if (sig->jsobj != NULL) 
@@ -687,7 +1102,9 @@ scripts_emit(ScriptSignal *sig)
             val[i++] = NIL;
     }
 
-    if (sig->json != NULL)
+    if (sig->payload != NULL)
+        val[i++] = sig->payload;
+    else if (sig->json != NULL)
     {
         JSValueRef vson = js_json_to_value(s_ctx->global_context, sig->json);
         val[i++] = vson == NULL ? NIL : vson;
@@ -703,19 +1120,77 @@ scripts_emit(ScriptSignal *sig)
         }
     }
 
+    gint64 start = g_get_monotonic_time();
     JSValueRef js_ret = scripts_call_as_function(s_ctx->global_context, function, function, numargs, val);
+    profile_record(&s_signal_profile[sig->signal], g_get_monotonic_time() - start, js_ret == NULL);
 
     if (JSValueIsBoolean(s_ctx->global_context, js_ret)) 
         ret = JSValueToBoolean(s_ctx->global_context, js_ret);
 
+    s_filter_matches[sig->signal] = previous_matches;
     UNPROTECT_SIGNAL(sig->signal);
 
+unlock:
+    if (filter_matches != NULL)
+        g_hash_table_unref(filter_matches);
     EXEC_UNLOCK;
 
     return ret;
 }/*}}}*/
 /*}}}*/
 
+/* scripts_create_payload(int n, ...) {{{*/
+/*
+ * Creates the data object of a signal directly, the arguments are triples of
+ * the type, a JS_PROP_* property name and the value like in
+ * util_create_json. Used instead of json for signals that are emitted
+ * frequently.
+ * */
+JSObjectRef 
+scripts_create_payload(int n, ...) 
+{
+    JSObjectRef payload = NULL;
+    JSValueRef value;
+    const char *text;
+    va_list args;
+    int type, key;
+
+    EXEC_LOCK_RETURN(NULL);
+
+    JSContextRef ctx = s_ctx->global_context;
+    payload = JSObjectMake(ctx, NULL, NULL);
+
+    va_start(args, n);
+    for (int i=0; i<n; i++) 
+    {
+        type = va_arg(args, int);
+        key = va_arg(args, int);
+        switch (type) 
+        {
+            case CHAR     : 
+                text = va_arg(args, const char *);
+                value = text == NULL ? JSValueMakeNull(ctx) : js_char_to_value(ctx, text);
+                break;
+            case INTEGER  : value = JSValueMakeNumber(ctx, va_arg(args, gint)); break;
+            case UINTEGER : value = JSValueMakeNumber(ctx, va_arg(args, guint)); break;
+            case LONG     : value = JSValueMakeNumber(ctx, va_arg(args, glong)); break;
+            case ULONG    : value = JSValueMakeNumber(ctx, va_arg(args, gulong)); break;
+            case DOUBLE   : value = JSValueMakeNumber(ctx, va_arg(args, double)); break;
+            case BOOLEAN  : value = JSValueMakeBoolean(ctx, va_arg(args, gboolean)); break;
+            /* The size of the value is unknown, the remaining arguments
+             * cannot be read */
+            default       : g_warn_if_reached(); goto finish;
+        }
+        JSObjectSetProperty(ctx, payload, js_interned(key), value, kJSPropertyAttributeNone, NULL);
+    }
+finish:
+    va_end(args);
+
+    EXEC_UNLOCK;
+
+    return payload;
+}/*}}}*/
+
 /* OBJECTS {{{*/
 /* scripts_make_object {{{*/
 
@@ -731,16 +1206,24 @@ make_boxed(gpointer boxed, JSClassRef klass)
     return ret;
 }
 
-JSObjectRef 
-scripts_make_object(JSContextRef ctx, GObject *o) 
+/* scripts_get_object_class(GObject *) {{{*/
+/* 
+ * Returns the class of a GObject, the class is cached per GType. DOM objects
+ * return SCRIPTS_CLASS_DOM, they are created by make_dom_object.
+ * */
+#define SCRIPTS_CLASS_DOM CLASS_LAST
+static int 
+scripts_get_object_class(GObject *o) 
 {
-    if (o == NULL) 
-    {
-        JSValueRef v = NIL;
-        return JSValueToObject(ctx, v, NULL);
-    }
-    JSObjectRef result;
+    static GHashTable *type_classes;
+    GType type = G_OBJECT_TYPE(o);
     int iclass;
+
+    if (type_classes == NULL)
+        type_classes = g_hash_table_new(NULL, NULL);
+    else if ((iclass = GPOINTER_TO_INT(g_hash_table_lookup(type_classes, GSIZE_TO_POINTER(type)))) != 0)
+        return iclass - 1;
+
     if (WEBKIT_IS_WEB_VIEW(o)) 
         iclass = CLASS_WEBVIEW;
     else if (WEBKIT_IS_WEB_FRAME(o))
@@ -756,17 +1239,41 @@ scripts_make_object(JSContextRef ctx, GObject *o)
     else if (GTK_IS_WIDGET(o))
         iclass = CLASS_SECURE_WIDGET;
 #if WEBKIT_CHECK_VERSION(1, 10, 0)
-    else if (WEBKIT_IS_FILE_CHOOSER_REQUEST(o)) {
+    else if (WEBKIT_IS_FILE_CHOOSER_REQUEST(o)) 
         iclass = CLASS_FILE_CHOOSER;
-        o = g_object_ref(o);
-    }
 #endif
-    else if (WEBKIT_IS_DOM_OBJECT(o)) {
-        return make_dom_object(ctx, o);
-    }
+    else if (WEBKIT_IS_DOM_OBJECT(o)) 
+        iclass = SCRIPTS_CLASS_DOM;
     else 
         iclass = CLASS_GOBJECT;
 
+    g_hash_table_insert(type_classes, GSIZE_TO_POINTER(type), GINT_TO_POINTER(iclass + 1));
+    return iclass;
+}/*}}}*/
+
+JSObjectRef 
+scripts_make_object(JSContextRef ctx, GObject *o) 
+{
+    if (o == NULL) 
+    {
+        JSValueRef v = NIL;
+        return JSValueToObject(ctx, v, NULL);
+    }
+    JSObjectRef result;
+    int iclass;
+
+    /* Wrappers stay attached to the object until it is finalized */
+    if (s_ctx != NULL && (result = g_object_get_qdata(o, s_ctx->ref_quark)) != NULL)
+        return result;
+
+    iclass = scripts_get_object_class(o);
+    if (iclass == SCRIPTS_CLASS_DOM)
+        return make_dom_object(ctx, o);
+#if WEBKIT_CHECK_VERSION(1, 10, 0)
+    if (iclass == CLASS_FILE_CHOOSER)
+        o = g_object_ref(o);
+#endif
+
     result =  make_object_for_class(ctx, iclass, o, true);
 
     return result;
@@ -838,6 +1345,7 @@ create_global_object()
 
     JSGlobalContextRef ctx = global_initialize();
     s_ctx->global_context = ctx;
+
     JSObjectRef global_object = JSContextGetGlobalObject(s_ctx->global_context);
 
     /**
@@ -935,10 +1443,24 @@ create_global_object()
      *
      *
      * */
+    JSStaticFunction signal_functions[] = { 
+        { "_addFilter",         signal_add_filter,            kJSDefaultAttributes },
+        { "_removeFilter",      signal_remove_filter,         kJSDefaultAttributes },
+        { "_filterMatches",     signal_filter_matches_cb,     kJSDefaultAttributes },
+        { "_profileNow",        signal_profile_now,           kJSDefaultAttributes },
+        { "_profileRecord",     signal_profile_record,        kJSDefaultAttributes },
+        { "_profileEnable",     signal_profile_enable,        kJSDefaultAttributes },
+        { "_profileGet",        signal_profile_get,           kJSDefaultAttributes },
+        { "_profileReset",      signal_profile_reset,         kJSDefaultAttributes },
+        { 0, 0, 0 }, 
+    };
     cd = kJSClassDefinitionEmpty;
     cd.className = "signals";
+    cd.staticFunctions = signal_functions;
     cd.setProperty = signal_set;
     class = JSClassCreate(&cd);
+    if (s_signal_filters == NULL)
+        s_signal_filters = g_hash_table_new_full(NULL, NULL, NULL, (GDestroyNotify)signal_filter_free);
 
     s_ctx->namespaces[NAMESPACE_SIGNALS] = JSObjectMake(ctx, class, NULL);
     JSValueProtect(ctx, s_ctx->namespaces[NAMESPACE_SIGNALS]);
@@ -975,6 +1497,7 @@ create_global_object()
     deferred_initialize(s_ctx);
     message_initialize(s_ctx);
     cltimer_initilize(s_ctx);
+    urlpatternset_initialize(s_ctx);
     history_initialize(s_ctx);
     widget_initialize(s_ctx);
     menu_initialize(s_ctx);
@@ -1063,6 +1586,24 @@ scripts_create_tab(GList *gl)
     VIEW(gl)->script_wv = o;
 }/*}}}*/
 
+/* scripts_reset_tab {{{*/
+/* 
+ * Called when the webview of a tab has been replaced, the old object is
+ * released and invalidated when the old webview is finalized. 
+ * */
+void 
+scripts_reset_tab(GList *gl) 
+{
+    if (s_ctx == NULL)
+        return;
+    if (VIEW(gl)->script_wv != NULL) 
+    {
+        JSValueUnprotect(s_ctx->global_context, VIEW(gl)->script_wv);
+        VIEW(gl)->script_wv = NULL;
+    }
+    scripts_create_tab(gl);
+}/*}}}*/
+
 /* scripts_remove_tab {{{*/
 void 
 scripts_remove_tab(JSObjectRef obj) 
@@ -1233,7 +1774,7 @@ init_script(const char *path, const char *script, gboolean is_archive, const cha
 
         g_return_if_fail(prepared != NULL);
 
-        debug = g_strdup_printf(template, path, prepared);
+        debug = g_strdup_printf(template, path, -1, prepared);
 
         JSObjectRef function = js_make_function(s_ctx->global_context, debug, path, offset);
         if (is_archive)
@@ -1354,7 +1895,7 @@ scripts_execute_one(const char *script, const char *path)
     gboolean ret = false;
     if (s_ctx != NULL && s_ctx->global_context != NULL)
     {
-        char *debug = g_strdup_printf(SCRIPT_TEMPLATE_INCLUDE, path, script);
+        char *debug = g_strdup_printf(SCRIPT_TEMPLATE_INCLUDE, path, -1, script);
         ret = js_execute(s_ctx->global_context, debug, NULL) != NULL;
         g_free(debug);
     }
@@ -1427,6 +1968,7 @@ scripts_end(gboolean clean_all)
                 dwb.override_keys = g_list_delete_link(dwb.override_keys, l);
 
         }
+        dwb_keymap_changed();
         next = dwb.keymap;
         while(next != NULL) 
         {
@@ -1437,6 +1979,8 @@ scripts_end(gboolean clean_all)
                 unbind_free_keymap(s_ctx->global_context, l);
         }
         dwb.misc.script_signals = 0;
+        for (int i = SCRIPTS_SIG_FIRST; i<SCRIPTS_SIG_LAST; i++) 
+            signal_filter_clear(i);
 
         for (GList *gl = dwb.state.views; gl; gl=gl->next) {
             if (VIEW(gl)->script_wv != NULL) {
@@ -1448,7 +1992,12 @@ scripts_end(gboolean clean_all)
         s_ctx = NULL;
     }
     pthread_rwlock_unlock(&s_context_lock);
+    s_profiling = false;
     if (clean_all) {
         g_slist_free_full(s_autoloaded_extensions, g_free);
+        if (s_handler_profile != NULL) {
+            g_hash_table_unref(s_handler_profile);
+            s_handler_profile = NULL;
+        }
     }
 }/*}}}*//*}}}*/
@@ -67,12 +67,30 @@ typedef struct _ScriptSignal {
   uint64_t signal;
   int numobj;
   Arg *arg;
+  JSObjectRef payload;
 } ScriptSignal;
 
+/* Time spent in signal handlers, owner is NULL for the total time of a
+ * signal emitted by dwb, times are in microseconds */
+typedef struct _ScriptProfile {
+  char *owner;
+  char *signal;
+  guint calls;
+  guint exceptions;
+  gint64 total;
+  gint64 max;
+} ScriptProfile;
+
 gboolean scripts_emit(ScriptSignal *);
+JSObjectRef scripts_create_payload(int n, ...);
+
+GList * scripts_profile_get(void);
+void scripts_profile_reset(void);
+gboolean scripts_profile_enabled(void);
 
 void scripts_create_tab(GList *gl);
 void scripts_remove_tab(JSObjectRef );
+void scripts_reset_tab(GList *gl);
 
 void scripts_check_syntax(char **scripts);
 void scripts_run_scripts(char **scripts);
@@ -116,5 +134,6 @@ G_STMT_END
 
 #define SCRIPTS_WV(gl) .jsobj = (VIEW(gl)->script_wv)
 #define SCRIPTS_SIG_META(js, sig, num) .json = js, .signal = SCRIPTS_SIG_##sig, .numobj = num, .arg = NULL
+#define SCRIPTS_SIG_PAYLOAD(obj, sig, num) .payload = obj, .signal = SCRIPTS_SIG_##sig, .numobj = num, .arg = NULL
 #define SCRIPTS_SIG_ARG(js, sig, num) .json = js, .signal = SCRIPTS_SIG_##sig, .numobj = num 
 #endif
@@ -79,7 +79,12 @@ make_dom_object(JSContextRef ctx, GObject *o) {
     if (WEBKIT_DOM_IS_NODE_LIST(o)) {
         return dom_make_node_list(ctx, WEBKIT_DOM_NODE_LIST(o), NULL);
     }
-    JSObjectRef result =  make_object_for_class(ctx, CLASS_DOM_OBJECT, o, true);
+    ScriptContext *sctx = scripts_get_context();
+    JSObjectRef result = sctx != NULL ? g_object_get_qdata(o, sctx->ref_quark) : NULL;
+    if (result != NULL)
+        return result;
+
+    result =  make_object_for_class(ctx, CLASS_DOM_OBJECT, o, true);
     g_object_weak_ref(o, (GWeakNotify)object_destroy_weak_cb, result);
     return result;
 }
@@ -925,12 +930,11 @@ dom_event_remove(JSContextRef ctx, JSObjectRef func, JSObjectRef self, size_t ar
         g_closure_unref(closure);
         JSObjectSetPrivate(self, NULL);
 
-        JSStringRef propname = JSStringCreateWithUTF8CString("callback");
+        JSStringRef propname = js_interned(JS_PROP_CALLBACK);
 
         JSValueRef cb = JSObjectGetProperty(ctx, self, propname, exc);
         JSObjectDeleteProperty(ctx, self, propname, exc);
 
-        JSStringRelease(propname);
         JSValueUnprotect(ctx, cb);
     }
     return NULL;
@@ -995,7 +999,7 @@ dom_on(JSContextRef ctx, JSObjectRef func, JSObjectRef self, size_t argc, const
         ScriptContext *sctx = scripts_get_context();
         if (sctx != NULL) {
             JSObjectRef retobj = JSObjectMake(ctx, sctx->classes[CLASS_DOM_EVENT], closure);
-            js_set_property(ctx, retobj, "callback", cb, kJSPropertyAttributeDontEnum, exc);
+            JSObjectSetProperty(ctx, retobj, js_interned(JS_PROP_CALLBACK), cb, kJSPropertyAttributeDontEnum, exc);
             ret = retobj;
             scripts_release_context();
         }
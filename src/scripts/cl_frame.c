@@ -30,11 +30,11 @@ inject_api_callback(JSContextRef ctx, JSObjectRef function, JSObjectRef this, si
         if (argc > 1)
         {
             JSValueRef args [] = { js_context_change(ctx, ctx, argv[1], exc) };
-            scripts_include(ctx, "local", body, false, false, 1, args, NULL);
+            scripts_include(ctx, "local", body, -1, false, false, 1, args, NULL);
         }
         else 
         {
-            scripts_include(ctx, "local", body, false, false, 0, NULL, NULL);
+            scripts_include(ctx, "local", body, -1, false, false, 0, NULL, NULL);
         }
         g_free(body);
         
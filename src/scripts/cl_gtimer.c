@@ -38,8 +38,8 @@ gtimer_elapsed(JSContextRef ctx, JSObjectRef object, JSStringRef js_name, JSValu
     if (timer != NULL) {
         elapsed = g_timer_elapsed(timer, &micro);
         JSObjectRef value = JSObjectMake(ctx, NULL, NULL);
-        js_set_object_number_property(ctx, value, "seconds", elapsed, exception);
-        js_set_object_number_property(ctx, value, "micro", micro, exception);
+        js_set_object_number_property_interned(ctx, value, JS_PROP_SECONDS, elapsed, exception);
+        js_set_object_number_property_interned(ctx, value, JS_PROP_MICRO, micro, exception);
         return value;
     }
     return NIL;
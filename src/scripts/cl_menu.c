@@ -114,9 +114,9 @@ menu_add_items(JSContextRef ctx, JSObjectRef function, JSObjectRef self, size_t
     GtkMenu *menu = JSObjectGetPrivate(self);
     if (menu)
     {
-        JSStringRef str_position = JSStringCreateWithUTF8CString("position");
-        JSStringRef str_label = JSStringCreateWithUTF8CString("label");
-        JSStringRef str_callback = JSStringCreateWithUTF8CString("callback");
+        JSStringRef str_position = js_interned(JS_PROP_POSITION);
+        JSStringRef str_label = js_interned(JS_PROP_LABEL);
+        JSStringRef str_callback = js_interned(JS_PROP_CALLBACK);
 
         js_array_iterator iter;
         js_array_iterator_init(ctx, &iter, arg);
@@ -151,7 +151,7 @@ menu_add_items(JSContextRef ctx, JSObjectRef function, JSObjectRef self, size_t
                     goto error;
                 item = gtk_menu_item_new_with_mnemonic(label);
 
-                if ((js_submenu = js_get_object_property(ctx, o, "menu")) != NULL) {
+                if ((js_submenu = js_get_object_property_interned(ctx, o, JS_PROP_MENU)) != NULL) {
                     submenu = JSObjectGetPrivate(js_submenu);
                     if (submenu == NULL || !GTK_IS_MENU(submenu)) {
                         gtk_widget_destroy(item);
@@ -183,10 +183,6 @@ error:
             g_free(label);
         }
         js_array_iterator_finish(&iter);
-
-        JSStringRelease(str_position);
-        JSStringRelease(str_label);
-        JSStringRelease(str_callback);
     }
     return NULL;
 
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2010-2014 Stefan Bolte <portix@gmx.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "private.h"
+#include "../urlpattern.h"
+
+static guint
+urlpatternset_get_flags(JSContextRef ctx, size_t argc, const JSValueRef argv[], JSValueRef *exc) 
+{
+    guint flags = URL_PATTERN_INCLUDE;
+    if (argc > 2) 
+    {
+        char *type = js_value_to_char(ctx, argv[2], JS_STRING_MAX, exc);
+        if (!g_strcmp0(type, "exclude"))
+            flags = URL_PATTERN_EXCLUDE;
+        else if (!g_strcmp0(type, "match"))
+            flags = URL_PATTERN_INCLUDE | URL_PATTERN_MATCH;
+        g_free(type);
+    }
+    return flags;
+}
+/** 
+ * Adds patterns for an id
+ *
+ * @name add
+ * @memberOf UrlPatternSet.prototype
+ * @function 
+ * @since 1.12
+ *
+ * @param {Number} id 
+ *      The id the patterns belong to
+ * @param {String|Array} patterns 
+ *      A pattern or an array of patterns
+ * @param {String} [type] 
+ *      The pattern type, either <i>"include"</i>, <i>"exclude"</i> or
+ *      <i>"match"</i>, default <i>"include"</i>. Include and exclude patterns
+ *      are globs, a pattern enclosed in slashes is a regular expression, if a
+ *      pattern contains <i>.tld</i> it matches all top level domains. Match
+ *      patterns have the form &lt;scheme&gt;://&lt;host&gt;/&lt;path&gt; or
+ *      are <i>&lt;all_urls&gt;</i>.
+ *
+ * @returns {Boolean}
+ *      true if all patterns are valid, invalid patterns are ignored
+ * */
+static JSValueRef 
+urlpatternset_add(JSContextRef ctx, JSObjectRef function, JSObjectRef this, size_t argc, const JSValueRef argv[], JSValueRef* exc) 
+{
+    UrlPatternSet *set = JSObjectGetPrivate(this);
+    gboolean ret = true;
+    char *pattern;
+    JSValueRef value;
+    js_array_iterator iter;
+
+    if (set == NULL || argc < 2)
+        return JSValueMakeBoolean(ctx, false);
+
+    int id = (int)JSValueToNumber(ctx, argv[0], exc);
+    guint flags = urlpatternset_get_flags(ctx, argc, argv, exc);
+
+    if (JSValueIsString(ctx, argv[1])) 
+    {
+        pattern = js_value_to_char(ctx, argv[1], -1, exc);
+        ret = pattern != NULL && url_pattern_set_add(set, id, pattern, flags);
+        g_free(pattern);
+    }
+    else if (JSValueIsObject(ctx, argv[1])) 
+    {
+        js_array_iterator_init(ctx, &iter, JSValueToObject(ctx, argv[1], exc));
+        while ((value = js_array_iterator_next(&iter, exc)) != NULL) 
+        {
+            pattern = js_value_to_char(ctx, value, -1, exc);
+            if (pattern == NULL || !url_pattern_set_add(set, id, pattern, flags))
+                ret = false;
+            g_free(pattern);
+        }
+        js_array_iterator_finish(&iter);
+    }
+    else 
+        ret = false;
+    return JSValueMakeBoolean(ctx, ret);
+}
+/** 
+ * Removes all patterns of an id
+ *
+ * @name remove
+ * @memberOf UrlPatternSet.prototype
+ * @function 
+ * @since 1.12
+ *
+ * @param {Number} id The id
+ * */
+static JSValueRef 
+urlpatternset_remove(JSContextRef ctx, JSObjectRef function, JSObjectRef this, size_t argc, const JSValueRef argv[], JSValueRef* exc) 
+{
+    UrlPatternSet *set = JSObjectGetPrivate(this);
+    if (set != NULL && argc > 0) 
+        url_pattern_set_remove(set, (int)JSValueToNumber(ctx, argv[0], exc));
+    return NULL;
+}
+/** 
+ * Matches an uri against all patterns
+ *
+ * @name match
+ * @memberOf UrlPatternSet.prototype
+ * @function 
+ * @since 1.12
+ *
+ * @param {String} uri The uri
+ *
+ * @returns {Array}
+ *      The ids in ascending order that have a matching include or match
+ *      pattern and no matching exclude pattern 
+ * */
+static JSValueRef 
+urlpatternset_match(JSContextRef ctx, JSObjectRef function, JSObjectRef this, size_t argc, const JSValueRef argv[], JSValueRef* exc) 
+{
+    UrlPatternSet *set = JSObjectGetPrivate(this);
+    JSValueRef ret;
+    char *uri;
+    GArray *ids;
+
+    if (set == NULL || argc < 1 || (uri = js_value_to_char(ctx, argv[0], -1, exc)) == NULL)
+        return JSObjectMakeArray(ctx, 0, NULL, exc);
+
+    ids = url_pattern_set_match(set, uri);
+    if (ids->len > 0) 
+    {
+        JSValueRef values[ids->len];
+        for (guint i=0; i<ids->len; i++)
+            values[i] = JSValueMakeNumber(ctx, g_array_index(ids, int, i));
+        ret = JSObjectMakeArray(ctx, ids->len, values, exc);
+    }
+    else 
+        ret = JSObjectMakeArray(ctx, 0, NULL, exc);
+
+    g_array_free(ids, true);
+    g_free(uri);
+    return ret;
+}
+
+static JSObjectRef 
+urlpatternset_constructor_cb(JSContextRef ctx, JSObjectRef constructor, size_t argc, const JSValueRef argv[], JSValueRef* exception) 
+{
+    ScriptContext *sctx = scripts_get_context();
+    return JSObjectMake(ctx, sctx->classes[CLASS_URL_PATTERN_SET], url_pattern_set_new());
+}
+static void 
+finalize(JSObjectRef o) 
+{
+    UrlPatternSet *set = JSObjectGetPrivate(o);
+    if (set != NULL)
+        url_pattern_set_free(set);
+}
+
+void
+urlpatternset_initialize(ScriptContext *sctx) 
+{
+    /** 
+     * Constructs a new UrlPatternSet.
+     *
+     * @name UrlPatternSet
+     * @class 
+     *      A set of url patterns that is matched natively, e.g. the
+     *      @include, @exclude and @match rules of userscripts. Every
+     *      pattern belongs to a numeric id, {@link UrlPatternSet#match|match}
+     *      returns all ids that match an uri in one call.
+     * @since 1.12
+     * @example 
+     * var set = new UrlPatternSet();
+     * set.add(0, ["http://example.com/foo*", "http://example.org*"]);
+     * set.add(1, "*://*.example.com/foo*", "match");
+     * set.add(1, "*bar*", "exclude");
+     * set.match("http://www.example.com/foo"); // [ 1 ]
+     * */
+    JSStaticFunction urlpatternset_functions[] = {
+        { "add",                urlpatternset_add,       kJSDefaultAttributes }, 
+        { "remove",             urlpatternset_remove,    kJSDefaultAttributes }, 
+        { "match",              urlpatternset_match,     kJSDefaultAttributes }, 
+        { 0, 0, 0 }, 
+    };
+
+    JSClassDefinition cd = kJSClassDefinitionEmpty;
+    cd.className = "UrlPatternSet";
+    cd.staticFunctions = urlpatternset_functions;
+    cd.finalize = finalize;
+    sctx->classes[CLASS_URL_PATTERN_SET] = JSClassCreate(&cd);
+    sctx->constructors[CONSTRUCTOR_URL_PATTERN_SET] = scripts_create_constructor(sctx->global_context, "UrlPatternSet", sctx->classes[CLASS_URL_PATTERN_SET], urlpatternset_constructor_cb, NULL);
+}
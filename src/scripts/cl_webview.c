@@ -491,6 +491,58 @@ wv_get_all_frames(JSContextRef ctx, JSObjectRef object, JSStringRef js_name, JSV
     return ret;
 }/*}}}*/
 
+/** 
+ * Number of requests that were blocked by {@link net.requestPolicy} since the
+ * current site was loaded
+ * 
+ * @name blockedRequests
+ * @memberOf WebKitWebView.prototype
+ * @type Number
+ * @since 1.12
+ *
+ * */
+/* wv_get_blocked_requests {{{*/
+static JSValueRef 
+wv_get_blocked_requests(JSContextRef ctx, JSObjectRef object, JSStringRef js_name, JSValueRef* exception) 
+{
+    GList *gl = find_webview(object);
+    if (gl == NULL)
+        return NIL;
+    return JSValueMakeNumber(ctx, VIEW(gl)->status->blocked_requests);
+}/*}}}*/
+
+/** 
+ * Base domains of all thirdparty requests of the current site, only collected
+ * if {@link net.requestPolicy} is enabled
+ * 
+ * @name thirdPartyDomains
+ * @memberOf WebKitWebView.prototype
+ * @type Array
+ * @since 1.12
+ *
+ * */
+/* wv_get_third_party_domains {{{*/
+static JSValueRef 
+wv_get_third_party_domains(JSContextRef ctx, JSObjectRef object, JSStringRef js_name, JSValueRef* exception) 
+{
+    GHashTableIter iter;
+    gpointer key;
+    int i = 0;
+    GList *gl = find_webview(object);
+    if (gl == NULL)
+        return NIL;
+
+    GHashTable *domains = VIEW(gl)->status->third_party;
+    if (domains == NULL || g_hash_table_size(domains) == 0)
+        return JSObjectMakeArray(ctx, 0, NULL, exception);
+
+    JSValueRef argv[g_hash_table_size(domains)];
+    g_hash_table_iter_init(&iter, domains);
+    while (g_hash_table_iter_next(&iter, &key, NULL))
+        argv[i++] = js_char_to_value(ctx, key);
+    return JSObjectMakeArray(ctx, i, argv, exception);
+}/*}}}*/
+
 /** 
  * The tabnumber of the webview, starting at 0
  * 
@@ -638,6 +690,8 @@ webview_initialize(ScriptContext *sctx) {
         { "focusedFrame",  wv_get_focused_frame, NULL, kJSDefaultAttributes }, 
         { "allFrames",     wv_get_all_frames, NULL, kJSDefaultAttributes }, 
         { "number",        wv_get_number, NULL, kJSDefaultAttributes }, 
+        { "blockedRequests", wv_get_blocked_requests, NULL, kJSDefaultAttributes }, 
+        { "thirdPartyDomains", wv_get_third_party_domains, NULL, kJSDefaultAttributes }, 
         { "tabWidget",     wv_get_tab_widget, NULL, kJSDefaultAttributes }, 
         { "tabBox",        wv_get_tab_box, NULL, kJSDefaultAttributes }, 
         { "tabLabel",      wv_get_tab_label, NULL, kJSDefaultAttributes }, 
@@ -18,10 +18,15 @@
 
 #include "private.h"
 
-static char * 
+/* 
+ * Returns the content of a file in an archive, the content points into the
+ * mapped archive and is not null terminated.
+ * */
+static const char * 
 xextract(JSContextRef ctx, size_t argc, const JSValueRef argv[], char **archive, off_t *fs, JSValueRef *exc)
 {
-    char *content = NULL, *larchive = NULL, *path = NULL;
+    const char *content = NULL;
+    char *larchive = NULL, *path = NULL;
     if (argc < 2) 
         return NULL;
     if ((larchive = js_value_to_char(ctx, argv[0], -1, exc)) == NULL)
@@ -29,10 +34,10 @@ xextract(JSContextRef ctx, size_t argc, const JSValueRef argv[], char **archive,
     if ((path = js_value_to_char(ctx, argv[1], -1, exc)) == NULL)
         goto error_out;
     if (*path == '~') {
-        content = (char*)exar_search_extract(larchive, path + 1, fs);
+        content = (const char*)exar_search_view(larchive, path + 1, fs);
     }
     else {
-        content = (char*)exar_extract(larchive, path, fs);
+        content = (const char*)exar_view(larchive, path, fs);
     }
 error_out: 
     if (archive != NULL) 
@@ -43,6 +48,22 @@ error_out:
     return content;
 }
 
+/* 
+ * Skips an interpreter line at the beginning of a script
+ * */
+static const char *
+skip_interpreter_line(const char *script, const char *end) 
+{
+    if (script < end && *script == '#') 
+    {
+        do {
+            script++;
+        } while(script < end && *script != '\n');
+        if (script < end)
+            script++;
+    }
+    return script;
+}
 
 /** 
  * Includes a file. 
@@ -97,8 +118,10 @@ global_include(JSContextRef ctx, JSObjectRef f, JSObjectRef this, size_t argc, c
 {
     JSValueRef ret = NIL;
     gboolean global = false;
-    char *path = NULL, *content = NULL, *econtent = NULL; 
-    const char *script;
+    char *path = NULL, *content = NULL; 
+    const char *script, *end;
+    gsize length = 0;
+    off_t fs = 0;
     JSValueRef exports[1];
     gboolean is_archive = false;
 
@@ -113,17 +136,17 @@ global_include(JSContextRef ctx, JSObjectRef f, JSObjectRef this, size_t argc, c
 
     if (exar_check_version(path) == 0)
     {
-        econtent = (char*) exar_search_extract(path, "main.js", NULL);
-        if (econtent == NULL)
+        script = (const char*) exar_search_view(path, "main.js", &fs);
+        if (script == NULL)
         {
             js_make_exception(ctx, exc, EXCEPTION("include: main.js was not found in %s."), path);
             goto error_out;
         }
         exports[0] = scripts_get_exports(ctx, path);
         is_archive = true;
-        script = econtent;
+        length = fs;
     }
-    else if ( (content = util_get_file_content(path, NULL)) != NULL) 
+    else if ( (content = util_get_file_content(path, &length)) != NULL) 
     {
         script = content;
         exports[0] = JSValueMakeNull(ctx);
@@ -133,23 +156,59 @@ global_include(JSContextRef ctx, JSObjectRef f, JSObjectRef this, size_t argc, c
         goto error_out;
     }
 
-    if (*script == '#') 
-    {
-        do {
-            script++;
-        } while(*script && *script != '\n');
-        script++;
-    }
+    end = script + length;
+    script = skip_interpreter_line(script, end);
 
-    ret = scripts_include(ctx, path, script, global, is_archive, 1, exports, exc);
+    ret = scripts_include(ctx, path, script, end - script, global, is_archive, 1, exports, exc);
 
 error_out: 
     g_free(content);
-    exar_free(econtent);
     g_free(path);
     return ret;
 }/*}}}*/
 
+/* 
+ * Internal function _includeSource, same as include but evaluates the source
+ * that was already read from path, used by the extension manager that has
+ * to read extensions before they are evaluated. If path is an archive the
+ * source must be its main.js.
+ * */
+static JSValueRef 
+global_include_source(JSContextRef ctx, JSObjectRef f, JSObjectRef this, size_t argc, const JSValueRef argv[], JSValueRef* exc) 
+{
+    JSValueRef ret = NIL;
+    char *path = NULL, *source = NULL; 
+    const char *script, *end;
+    JSValueRef exports[1];
+    gboolean is_archive = false;
+
+    if (argc < 2) 
+        return NIL;
+
+    if ( (path = js_value_to_char(ctx, argv[0], PATH_MAX, exc)) == NULL) 
+        goto error_out;
+    if ( (source = js_value_to_char(ctx, argv[1], -1, exc)) == NULL) 
+        goto error_out;
+
+    if (exar_check_version(path) == 0) 
+    {
+        exports[0] = scripts_get_exports(ctx, path);
+        is_archive = true;
+    }
+    else 
+        exports[0] = JSValueMakeNull(ctx);
+
+    end = source + strlen(source);
+    script = skip_interpreter_line(source, end);
+
+    ret = scripts_include(ctx, path, script, end - script, false, is_archive, 1, exports, exc);
+
+error_out: 
+    g_free(source);
+    g_free(path);
+    return ret;
+}
+
 
 /** 
  * Unbind a shortcut previously bound with <b>bind</b>
@@ -211,6 +270,7 @@ global_unbind(JSContextRef ctx, JSObjectRef function, JSObjectRef self, size_t a
             if (m->map->prop & CP_SCRIPT) 
                 dwb.override_keys = g_list_delete_link(dwb.override_keys, l);
         }
+        dwb_keymap_changed();
         result = true;
     }
     scripts_release_context();
@@ -278,7 +338,10 @@ global_bind(JSContextRef ctx, JSObjectRef function, JSObjectRef self, size_t arg
     Arg a = { .js = func, .i = ret };
     KeyMap *map = dwb_add_key(keystr, name, callback, (Func)scripts_eval_key, option, &a);
     if (override)
+    {
         dwb.override_keys = g_list_prepend(dwb.override_keys, map);
+        dwb_keymap_changed();
+    }
 
 error_out:
     g_free(keystr);
@@ -450,15 +513,17 @@ global_get(JSContextRef ctx, JSObjectRef object, JSStringRef js_name, JSValueRef
 static JSValueRef
 global_xget_text(JSContextRef ctx, JSObjectRef f, JSObjectRef thisObject, size_t argc, const JSValueRef argv[], JSValueRef* exc) 
 {
-    char *content = NULL;
+    const char *content = NULL;
+    char *text;
     JSValueRef ret = NIL;
     off_t fs;
 
     content = xextract(ctx, argc, argv, NULL, &fs, exc);
     if (content != NULL) {
-        ret = js_char_to_value(ctx, content);
+        text = g_strndup(content, fs);
+        ret = js_char_to_value(ctx, text);
+        g_free(text);
     }
-    exar_free(content);
     return ret;
 }
 /** 
@@ -524,7 +589,8 @@ global_xget_text(JSContextRef ctx, JSObjectRef f, JSObjectRef thisObject, size_t
 static JSValueRef
 global_xinclude(JSContextRef ctx, JSObjectRef f, JSObjectRef thisObject, size_t argc, const JSValueRef argv[], JSValueRef* exc) 
 {
-    char *content = NULL, *archive = NULL;
+    const char *content = NULL;
+    char *archive = NULL;
     JSValueRef ret = NIL;
     off_t fs;
 
@@ -532,10 +598,9 @@ global_xinclude(JSContextRef ctx, JSObjectRef f, JSObjectRef thisObject, size_t
     if (content != NULL)
     {
         JSValueRef exports[] = { scripts_get_exports(ctx, archive) };
-        ret = scripts_include(ctx, archive, content, false, true, 1, exports, exc);
+        ret = scripts_include(ctx, archive, content, fs, false, true, 1, exports, exc);
     }
     g_free(archive);
-    exar_free(content);
     return ret;
 }
 
@@ -557,6 +622,7 @@ global_initialize() {
         { "_bind",              global_bind,            kJSDefaultAttributes },
         { "unbind",             global_unbind,          kJSDefaultAttributes },
         { "include",            global_include,         kJSDefaultAttributes },
+        { "_includeSource",     global_include_source,  kJSDefaultAttributes },
         { "_xinclude",          global_xinclude,       kJSDefaultAttributes },
         { "_xgettext",          global_xget_text,       kJSDefaultAttributes },
         { 0, 0, 0 }, 
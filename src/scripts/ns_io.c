@@ -372,6 +372,378 @@ error_out:
 }/*}}}*/
 
 
+/* ASYNCHRONOUS IO {{{*/
+#define IO_JOB_READ     (0)
+#define IO_JOB_WRITE    (1)
+#define IO_JOB_LINES    (2)
+
+#define IO_LINES_CHUNK      (256)
+#define IO_LINES_CHUNK_MAX  (4096)
+
+/* 
+ * An IOJob is created on the main thread, handed over to a worker thread that
+ * does the file operation and handed back to the main thread with an idle
+ * callback that resolves or rejects the deferred. 
+ * */
+typedef struct IOJob_s {
+    int type;
+    char *path;
+    char *mode;
+    char *content;
+    char *error;
+    guint chunk_size;
+    gulong lines;
+    gint cancelled;
+    JSObjectRef deferred;
+    JSObjectRef callback;
+    GAsyncQueue *chunks;
+} IOJob;
+
+static void 
+io_job_free(IOJob *job)
+{
+    g_free(job->path);
+    g_free(job->mode);
+    g_free(job->content);
+    g_free(job->error);
+    if (job->chunks != NULL)
+        g_async_queue_unref(job->chunks);
+    g_free(job);
+}
+/* io_job_finish {{{*/
+static gboolean 
+io_job_finish(IOJob *job)
+{
+    JSContextRef ctx = scripts_get_global_context();
+    if (ctx != NULL) 
+    {
+        if (job->error != NULL) 
+        {
+            JSValueRef argv[] = { js_char_to_value(ctx, job->error) };
+            deferred_reject(ctx, job->deferred, job->deferred, 1, argv, NULL);
+        }
+        else 
+        {
+            JSValueRef argv[1];
+            switch (job->type) 
+            {
+                case IO_JOB_READ  : argv[0] = js_char_to_value(ctx, job->content != NULL ? job->content : ""); break;
+                case IO_JOB_LINES : argv[0] = JSValueMakeNumber(ctx, job->lines); break;
+                default           : argv[0] = JSValueMakeBoolean(ctx, true); break;
+            }
+            deferred_resolve(ctx, job->deferred, job->deferred, 1, argv, NULL);
+        }
+        if (job->callback != NULL)
+            JSValueUnprotect(ctx, job->callback);
+        scripts_release_global_context();
+    }
+    io_job_free(job);
+    return false;
+}/*}}}*/
+
+/* io_job_deliver_lines {{{*/
+/* 
+ * Every chunk pushed by the worker schedules exactly one idle callback, the
+ * last item in the queue is an empty array that marks the end of the file.
+ * */
+static gboolean 
+io_job_deliver_lines(IOJob *job)
+{
+    GPtrArray *chunk = g_async_queue_pop(job->chunks);
+    if (chunk->len == 0) 
+    {
+        g_ptr_array_free(chunk, true);
+        return io_job_finish(job);
+    }
+    if (!g_atomic_int_get(&job->cancelled)) 
+    {
+        JSContextRef ctx = scripts_get_global_context();
+        if (ctx != NULL) 
+        {
+            JSValueRef *values = g_malloc_n(chunk->len, sizeof(JSValueRef));
+            for (guint i=0; i<chunk->len; i++) 
+                values[i] = js_char_to_value(ctx, g_ptr_array_index(chunk, i));
+
+            JSValueRef argv[] = { JSObjectMakeArray(ctx, chunk->len, values, NULL) };
+            JSValueRef ret = scripts_call_as_function(ctx, job->callback, job->callback, 1, argv);
+            if (ret != NULL && JSValueIsBoolean(ctx, ret) && JSValueToBoolean(ctx, ret))
+                g_atomic_int_set(&job->cancelled, 1);
+            job->lines += chunk->len;
+
+            g_free(values);
+            scripts_release_global_context();
+        }
+        else 
+            g_atomic_int_set(&job->cancelled, 1);
+    }
+    g_ptr_array_free(chunk, true);
+    return false;
+}/*}}}*/
+
+/* io_job_run {{{*/
+static void
+io_job_read_lines(IOJob *job)
+{
+    GError *e = NULL;
+    GPtrArray *chunk = NULL;
+    char *line;
+    gsize length, terminator;
+
+    GIOChannel *channel = g_io_channel_new_file(job->path, "r", &e);
+    if (channel != NULL) 
+    {
+        g_io_channel_set_encoding(channel, NULL, NULL);
+        while (!g_atomic_int_get(&job->cancelled) && 
+                g_io_channel_read_line(channel, &line, &length, &terminator, &e) == G_IO_STATUS_NORMAL) 
+        {
+            line[terminator] = '\0';
+            if (chunk == NULL)
+                chunk = g_ptr_array_new_with_free_func(g_free);
+            g_ptr_array_add(chunk, line);
+            if (chunk->len == job->chunk_size) 
+            {
+                g_async_queue_push(job->chunks, chunk);
+                g_idle_add((GSourceFunc)io_job_deliver_lines, job);
+                chunk = NULL;
+            }
+        }
+        if (chunk != NULL) 
+        {
+            g_async_queue_push(job->chunks, chunk);
+            g_idle_add((GSourceFunc)io_job_deliver_lines, job);
+        }
+        g_io_channel_unref(channel);
+    }
+    if (e != NULL) 
+    {
+        job->error = g_strdup(e->message);
+        g_error_free(e);
+    }
+    g_async_queue_push(job->chunks, g_ptr_array_new());
+    g_idle_add((GSourceFunc)io_job_deliver_lines, job);
+}
+static gpointer 
+io_job_run(IOJob *job)
+{
+    GError *e = NULL;
+    FILE *f;
+
+    switch (job->type) 
+    {
+        case IO_JOB_READ : 
+            if (!g_file_get_contents(job->path, &job->content, NULL, &e)) 
+            {
+                job->error = g_strdup(e->message);
+                g_error_free(e);
+            }
+            break;
+        case IO_JOB_WRITE : 
+            if ((f = fopen(job->path, job->mode)) != NULL) 
+            {
+                if (fputs(job->content, f) == EOF)
+                    job->error = g_strdup_printf("Error writing %s: %s", job->path, g_strerror(errno));
+                fclose(f);
+            }
+            else 
+                job->error = g_strdup_printf("Cannot open %s for writing: %s", job->path, g_strerror(errno));
+            break;
+        case IO_JOB_LINES : 
+            /* The job belongs to the main thread after the last chunk was
+             * pushed */
+            io_job_read_lines(job);
+            return NULL;
+    }
+    g_idle_add((GSourceFunc)io_job_finish, job);
+    return NULL;
+}/*}}}*/
+
+static IOJob *
+io_job_new(JSContextRef ctx, int type, JSValueRef js_path, JSValueRef *exc)
+{
+    char expanded[4096];
+    char *path = js_value_to_char(ctx, js_path, PATH_MAX, exc);
+    if (path == NULL)
+        return NULL;
+    if (util_expand_home(expanded, path, sizeof(expanded)) == NULL)
+    {
+        js_make_exception(ctx, exc, EXCEPTION("Filename too long"));
+        g_free(path);
+        return NULL;
+    }
+    g_free(path);
+
+    IOJob *job = g_malloc0(sizeof(IOJob));
+    job->type = type;
+    job->path = g_strdup(expanded);
+    job->deferred = deferred_new(ctx);
+    return job;
+}
+
+/* io_read_async {{{*/
+/**
+ * Reads a file asynchronously, the file is read in a separate thread
+ *
+ * @name readAsync 
+ * @memberOf io
+ * @function 
+ * @since 1.12
+ *
+ * @param {String} path A path to a file
+ *
+ * @returns {Deferred}
+ *      A deferred, it will be resolved with the file content or rejected with
+ *      an error message
+ * @example 
+ * io.readAsync("/path/to/file").then(
+ *     function(content) { 
+ *         io.out(content);
+ *     }, 
+ *     function(error) { 
+ *         io.error(error);
+ *     }
+ * );
+ * */
+static JSValueRef 
+io_read_async(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject, size_t argc, const JSValueRef argv[], JSValueRef* exc) 
+{
+    IOJob *job;
+    if (argc < 1) 
+    {
+        js_make_exception(ctx, exc, EXCEPTION("io.readAsync needs an argument."));
+        return NIL;
+    }
+    if ((job = io_job_new(ctx, IO_JOB_READ, argv[0], exc)) == NULL)
+        return NIL;
+
+    JSObjectRef ret = job->deferred;
+    g_thread_unref(g_thread_new("io.readAsync", (GThreadFunc)io_job_run, job));
+    return ret;
+}/*}}}*/
+
+/* io_write_async {{{*/
+/** 
+ * Writes to a file asynchronously, the file is written in a separate thread
+ *
+ * @name writeAsync
+ * @memberOf io
+ * @function
+ * @since 1.12
+ *
+ * @param {String} path Path to a file to write to
+ * @param {String} mode Either <i>"a"</i> to append or <i>"w"</i> to strip the file
+ * @param {String} text The text that should be written to the file
+ *
+ * @returns {Deferred}
+ *      A deferred, it will be resolved with true if writing was successful or
+ *      rejected with an error message
+ * */
+static JSValueRef 
+io_write_async(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject, size_t argc, const JSValueRef argv[], JSValueRef* exc) 
+{
+    IOJob *job;
+    char *mode = NULL, *content = NULL;
+    JSObjectRef ret;
+
+    if (argc < 3) 
+    {
+        js_make_exception(ctx, exc, EXCEPTION("io.writeAsync needs 3 arguments."));
+        return NIL;
+    }
+    if ( (mode = js_value_to_char(ctx, argv[1], -1, exc)) == NULL )
+        return NIL;
+    if (g_strcmp0(mode, "w") && g_strcmp0(mode, "a")) 
+    {
+        js_make_exception(ctx, exc, EXCEPTION("io.writeAsync: invalid mode."));
+        g_free(mode);
+        return NIL;
+    }
+    if ( (content = js_value_to_char(ctx, argv[2], -1, exc)) == NULL ) 
+    {
+        g_free(mode);
+        return NIL;
+    }
+    if ((job = io_job_new(ctx, IO_JOB_WRITE, argv[0], exc)) == NULL) 
+    {
+        g_free(mode);
+        g_free(content);
+        return NIL;
+    }
+    job->mode = mode;
+    job->content = content;
+
+    ret = job->deferred;
+    g_thread_unref(g_thread_new("io.writeAsync", (GThreadFunc)io_job_run, job));
+    return ret;
+}/*}}}*/
+
+/* io_read_lines {{{*/
+/**
+ * Reads a file line by line in a separate thread, the lines are passed to
+ * the callback in chunks
+ *
+ * @name readLines 
+ * @memberOf io
+ * @function 
+ * @since 1.12
+ *
+ * @param {String} path A path to a file
+ * @param {io~onReadLines} callback 
+ *      Callback called with an array of lines for every chunk, the lines don't
+ *      contain the line terminator
+ * @param {Number} [chunkSize] 
+ *      Maximum number of lines passed to the callback at once, default 256
+ *
+ * @returns {Deferred}
+ *      A deferred, it will be resolved with the number of lines passed to the
+ *      callback or rejected with an error message
+ * @example 
+ * var hosts = [];
+ * io.readLines("/path/to/hosts", function(lines) {
+ *     hosts.push.apply(hosts, lines);
+ * }).then(function(count) {
+ *     io.out("read " + count + " hosts");
+ * });
+ * */
+/**
+ * Called for every chunk of lines
+ * @callback io~onReadLines
+ * @param {Array} lines 
+ *      The lines of the chunk 
+ * @returns {Boolean}
+ *      Return true to stop reading the file
+ * */
+static JSValueRef 
+io_read_lines(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject, size_t argc, const JSValueRef argv[], JSValueRef* exc) 
+{
+    IOJob *job;
+    JSObjectRef callback, ret;
+    double chunk_size = IO_LINES_CHUNK;
+
+    if (argc < 2 || (callback = js_value_to_function(ctx, argv[1], exc)) == NULL) 
+    {
+        js_make_exception(ctx, exc, EXCEPTION("io.readLines: arguments must be a path and a function."));
+        return NIL;
+    }
+    if (argc > 2) 
+    {
+        chunk_size = JSValueToNumber(ctx, argv[2], exc);
+        if (isnan(chunk_size) || chunk_size < 1)
+            chunk_size = IO_LINES_CHUNK;
+    }
+    if ((job = io_job_new(ctx, IO_JOB_LINES, argv[0], exc)) == NULL)
+        return NIL;
+
+    job->chunk_size = (guint) MIN(chunk_size, IO_LINES_CHUNK_MAX);
+    job->callback = callback;
+    JSValueProtect(ctx, callback);
+    job->chunks = g_async_queue_new();
+
+    ret = job->deferred;
+    g_thread_unref(g_thread_new("io.readLines", (GThreadFunc)io_job_run, job));
+    return ret;
+}/*}}}*/
+/*}}}*/
+
 /* io_print {{{*/
 /** 
  * Print messages to stdout
@@ -432,6 +804,9 @@ io_initialize(JSContextRef ctx) {
         { "confirm",   io_confirm,          kJSDefaultAttributes },
         { "read",      io_read,             kJSDefaultAttributes },
         { "write",     io_write,            kJSDefaultAttributes },
+        { "readAsync", io_read_async,       kJSDefaultAttributes },
+        { "writeAsync",io_write_async,      kJSDefaultAttributes },
+        { "readLines", io_read_lines,       kJSDefaultAttributes },
         { "dirNames",  io_dir_names,        kJSDefaultAttributes },
         { "notify",    io_notify,           kJSDefaultAttributes },
         { "error",     io_error,            kJSDefaultAttributes },
@@ -25,10 +25,10 @@ set_request(JSContextRef ctx, SoupMessage *msg, JSValueRef val, JSValueRef *exc)
     JSObjectRef data = JSValueToObject(ctx, val, exc);
     if (data == NULL)
         return;
-    content_type = js_get_string_property(ctx, data, "contentType");
+    content_type = js_get_string_property_interned(ctx, data, JS_PROP_CONTENT_TYPE);
     if (content_type != NULL)
     {
-        body = js_get_string_property(ctx, data, "data");
+        body = js_get_string_property_interned(ctx, data, JS_PROP_DATA);
         if (body != NULL) {
             soup_message_set_request(msg, content_type, SOUP_MEMORY_COPY, body, strlen(body));
         }
@@ -43,7 +43,6 @@ get_message_data(SoupMessage *msg)
     SoupMessageHeadersIter iter;
     JSObjectRef o = NULL, ho;
     JSValueRef ret;
-    JSStringRef s;
 
     JSContextRef ctx = scripts_get_global_context();
     if (ctx == NULL) {
@@ -51,7 +50,7 @@ get_message_data(SoupMessage *msg)
     }
 
     o = JSObjectMake(ctx, NULL, NULL);
-    js_set_object_property(ctx, o, "body", msg->response_body->data, NULL);
+    js_set_object_property_interned(ctx, o, JS_PROP_BODY, msg->response_body->data, NULL);
 
     ho = JSObjectMake(ctx, NULL, NULL);
 
@@ -59,9 +58,7 @@ get_message_data(SoupMessage *msg)
     while (soup_message_headers_iter_next(&iter, &name, &value)) 
         js_set_object_property(ctx, ho, name, value, NULL);
 
-    s = JSStringCreateWithUTF8CString("headers");
-    JSObjectSetProperty(ctx, o, s, ho, kJSDefaultProperty, NULL);
-    JSStringRelease(s);
+    JSObjectSetProperty(ctx, o, js_interned(JS_PROP_HEADERS), ho, kJSDefaultProperty, NULL);
     ret = o;
 
     scripts_release_global_context();
@@ -173,7 +170,8 @@ error_out:
 }/*}}}*/
 
 /** 
- * Sends a http-request synchronously
+ * Sends a http-request synchronously, the browser is blocked until the
+ * response arrives, use {@link net.sendRequests} instead
  * @name sendRequestSync
  * @memberOf net
  * @function
@@ -193,7 +191,6 @@ net_send_request_sync(JSContextRef ctx, JSObjectRef f, JSObjectRef thisObject, s
     guint status;
     JSValueRef val;
     JSObjectRef o;
-    JSStringRef js_key;
     JSValueRef js_value;
 
     if (argc < 1) 
@@ -213,16 +210,245 @@ net_send_request_sync(JSContextRef ctx, JSObjectRef f, JSObjectRef thisObject, s
     status = soup_session_send_message(webkit_get_default_session(), msg);
     val = get_message_data(msg);
 
-    js_key = JSStringCreateWithUTF8CString("status");
     js_value = JSValueMakeNumber(ctx, status);
 
     o = JSValueToObject(ctx, val, exc);
-    JSObjectSetProperty(ctx, o, js_key, js_value, kJSPropertyAttributeDontDelete | kJSPropertyAttributeReadOnly, exc);
+    JSObjectSetProperty(ctx, o, js_interned(JS_PROP_STATUS), js_value, kJSPropertyAttributeDontDelete | kJSPropertyAttributeReadOnly, exc);
 
-    JSStringRelease(js_key);
     return o;
 }
 
+/* BATCH REQUESTS {{{*/
+#define NET_BATCH_LIMIT 4
+
+typedef struct NetBatch_s {
+    GQueue *pending;
+    guint running;
+    guint limit;
+    gboolean dispatching;
+} NetBatch;
+
+typedef struct NetRequest_s {
+    NetBatch *batch;
+    SoupMessage *msg;
+    JSObjectRef deferred;
+    JSObjectRef on_chunk;
+} NetRequest;
+
+static void 
+batch_got_chunk(SoupMessage *msg, SoupBuffer *chunk, NetRequest *request) 
+{
+    JSContextRef ctx = scripts_get_global_context();
+    if (ctx != NULL) {
+        char *data = g_strndup(chunk->data, chunk->length);
+        JSValueRef argv[] = { js_char_to_value(ctx, data) };
+        scripts_call_as_function(ctx, request->on_chunk, request->on_chunk, 1, argv);
+        g_free(data);
+        scripts_release_global_context();
+    }
+}
+static void batch_request_callback(SoupSession *session, SoupMessage *msg, NetRequest *request);
+
+/* 
+ * Starts pending requests until the concurrency limit of the batch is
+ * reached, frees the batch when all requests are finished.
+ * */
+static void 
+batch_dispatch(NetBatch *batch) 
+{
+    NetRequest *request;
+    if (batch->dispatching) 
+        return;
+
+    batch->dispatching = true;
+    while (batch->running < batch->limit && (request = g_queue_pop_head(batch->pending)) != NULL) {
+        batch->running++;
+        soup_session_queue_message(dwb_soup_get_script_session(), request->msg, 
+                (SoupSessionCallback)batch_request_callback, request);
+    }
+    batch->dispatching = false;
+
+    if (batch->running == 0) {
+        g_queue_free(batch->pending);
+        g_free(batch);
+    }
+}
+static void 
+batch_request_callback(SoupSession *session, SoupMessage *msg, NetRequest *request) 
+{
+    NetBatch *batch = request->batch;
+    JSContextRef ctx = scripts_get_global_context();
+    if (ctx != NULL) {
+        if (SOUP_STATUS_IS_TRANSPORT_ERROR(msg->status_code)) {
+            JSValueRef argv[] = { 
+                js_char_to_value(ctx, msg->reason_phrase != NULL ? msg->reason_phrase : ""), 
+                JSValueMakeNumber(ctx, msg->status_code) 
+            };
+            deferred_reject(ctx, request->deferred, request->deferred, 2, argv, NULL);
+        }
+        else {
+            JSObjectRef o = JSValueToObject(ctx, get_message_data(msg), NULL);
+            JSObjectSetProperty(ctx, o, js_interned(JS_PROP_STATUS), JSValueMakeNumber(ctx, msg->status_code), 
+                    kJSPropertyAttributeDontDelete | kJSPropertyAttributeReadOnly, NULL);
+            JSValueRef argv[] = { o, make_object_for_class(ctx, CLASS_GOBJECT, G_OBJECT(msg), true) };
+            deferred_resolve(ctx, request->deferred, request->deferred, 2, argv, NULL);
+        }
+        if (request->on_chunk != NULL) 
+            JSValueUnprotect(ctx, request->on_chunk);
+        scripts_release_global_context();
+    }
+    g_free(request);
+
+    batch->running--;
+    batch_dispatch(batch);
+}
+static NetRequest * 
+batch_request_new(JSContextRef ctx, JSValueRef value, JSValueRef *exc) 
+{
+    char *uri = NULL, *method = NULL;
+    JSObjectRef o = NULL, on_chunk = NULL;
+    SoupMessage *msg = NULL;
+    NetRequest *request = NULL;
+
+    if (JSValueIsString(ctx, value)) 
+        uri = js_value_to_char(ctx, value, -1, exc);
+    else if (JSValueIsObject(ctx, value) && (o = JSValueToObject(ctx, value, exc)) != NULL) {
+        uri = js_get_string_property_interned(ctx, o, JS_PROP_URI);
+        method = js_get_string_property_interned(ctx, o, JS_PROP_METHOD);
+        on_chunk = js_get_object_property_interned(ctx, o, JS_PROP_ON_CHUNK);
+        if (on_chunk != NULL && !JSObjectIsFunction(ctx, on_chunk))
+            on_chunk = NULL;
+    }
+    if (uri == NULL || (msg = soup_message_new(method == NULL ? "GET" : method, uri)) == NULL) {
+        js_make_exception(ctx, exc, EXCEPTION("net.sendRequests: invalid request %s."), uri != NULL ? uri : "");
+        goto error_out;
+    }
+    if (o != NULL) {
+        JSValueRef data = JSObjectGetProperty(ctx, o, js_interned(JS_PROP_DATA), NULL);
+        if (data != NULL && JSValueIsObject(ctx, data)) 
+            set_request(ctx, msg, data, exc);
+    }
+
+    request = g_malloc0(sizeof(NetRequest));
+    request->msg = msg;
+    if (on_chunk != NULL) {
+        request->on_chunk = on_chunk;
+        JSValueProtect(ctx, on_chunk);
+        soup_message_body_set_accumulate(msg->response_body, false);
+        g_signal_connect(msg, "got-chunk", G_CALLBACK(batch_got_chunk), request);
+    }
+
+error_out:
+    g_free(uri);
+    g_free(method);
+    return request;
+}
+
+/** 
+ * Sends http-requests asynchronously with a separate session, at most
+ * <i>limit</i> requests of the batch are sent at the same time
+ *
+ * @name sendRequests
+ * @memberOf net
+ * @function
+ * @since 1.12
+ *
+ * @param {Array} requests
+ *      An array of uris or request objects
+ * @param {String} requests[].uri 
+ *      The uri the request will be sent to
+ * @param {String} [requests[].method]  
+ *      The http request method, default GET
+ * @param {Object} [requests[].data]  
+ *      The data that will be sent with the request
+ * @param {String} requests[].data.contentType 
+ *      The content type
+ * @param {String} requests[].data.data
+ *      The data
+ * @param {Function} [requests[].onChunk]  
+ *      If set the response body is streamed, the function is called with every
+ *      chunk of the body and the body of the resolved response is null
+ * @param {Number} [limit]
+ *      Maximum number of concurrent requests, default 4
+ *
+ * @returns {Array[Deferred]}
+ *      A Deferred for every request. A deferred is resolved with the response
+ *      and the {@link SoupMessage} or rejected with the reason and the status
+ *      code if the request couldn't be sent. The response contains the body,
+ *      the headers and the status code. 
+ * @example 
+ * var requests = net.sendRequests([ 
+ *      "http://example.com", 
+ *      { uri : "http://example.com/data", method : "POST", 
+ *        data : { contentType : "application/json", data : "{}" } }
+ * ]);
+ * requests[0].then(function(response) {
+ *      io.out(response.status + " " + response.body);
+ * });
+ * */
+static JSValueRef 
+net_send_requests(JSContextRef ctx, JSObjectRef f, JSObjectRef thisObject, size_t argc, const JSValueRef argv[], JSValueRef* exc) 
+{
+    js_array_iterator iter;
+    JSValueRef current, ret = NIL;
+    JSObjectRef list;
+    NetRequest *request;
+    NetBatch *batch;
+    GPtrArray *requests;
+    double limit = NET_BATCH_LIMIT;
+
+    if (argc < 1 || !JSValueIsObject(ctx, argv[0]) || (list = JSValueToObject(ctx, argv[0], exc)) == NULL) {
+        js_make_exception(ctx, exc, EXCEPTION("net.sendRequests: missing argument."));
+        return NIL;
+    }
+    if (argc > 1) {
+        limit = JSValueToNumber(ctx, argv[1], exc);
+        if (isnan(limit) || limit < 1) 
+            limit = NET_BATCH_LIMIT;
+    }
+
+    requests = g_ptr_array_new();
+    js_array_iterator_init(ctx, &iter, list);
+    while ((current = js_array_iterator_next(&iter, exc)) != NULL) {
+        if ((request = batch_request_new(ctx, current, exc)) == NULL) 
+            break;
+        g_ptr_array_add(requests, request);
+    }
+    js_array_iterator_finish(&iter);
+
+    if (current != NULL) {
+        for (guint i=0; i<requests->len; i++) {
+            request = g_ptr_array_index(requests, i);
+            if (request->on_chunk != NULL)
+                JSValueUnprotect(ctx, request->on_chunk);
+            g_object_unref(request->msg);
+            g_free(request);
+        }
+        goto error_out;
+    }
+
+    batch = g_malloc0(sizeof(NetBatch));
+    batch->pending = g_queue_new();
+    batch->limit = (guint) MIN(limit, SOUP_SCRIPT_MAX_CONNS);
+
+    JSValueRef *deferreds = g_malloc_n(requests->len + 1, sizeof(JSValueRef));
+    for (guint i=0; i<requests->len; i++) {
+        request = g_ptr_array_index(requests, i);
+        request->batch = batch;
+        request->deferred = deferred_new(ctx);
+        deferreds[i] = request->deferred;
+        g_queue_push_tail(batch->pending, request);
+    }
+    ret = JSObjectMakeArray(ctx, requests->len, deferreds, exc);
+    g_free(deferreds);
+
+    batch_dispatch(batch);
+
+error_out:
+    g_ptr_array_free(requests, true);
+    return ret;
+}/*}}}*/
+
 /* net_domain_from_host {{{*/
 /**
  * Gets the base domain name from a hostname where the base domain name is the
@@ -324,6 +550,196 @@ net_all_cookies(JSContextRef ctx, JSObjectRef f, JSObjectRef thisObject, size_t
     return ret;
 }
 
+/* REQUEST POLICY {{{*/
+static char *
+rp_get_domain(JSContextRef ctx, size_t argc, const JSValueRef argv[], size_t n, JSValueRef *exc) 
+{
+    if (argc <= n || JSValueIsNull(ctx, argv[n]) || JSValueIsUndefined(ctx, argv[n]))
+        return NULL;
+    return js_value_to_char(ctx, argv[n], -1, exc);
+}
+static guint
+rp_get_flags(JSContextRef ctx, size_t argc, const JSValueRef argv[], size_t n, guint def) 
+{
+    if (argc <= n || JSValueIsUndefined(ctx, argv[n]))
+        return def;
+    return JSValueToBoolean(ctx, argv[n]) ? REQUEST_POLICY_TEMPORARY : REQUEST_POLICY_PERSISTENT;
+}
+/** 
+ * Whether the request policy is applied, the policy is disabled by default 
+ *
+ * @name enabled
+ * @memberOf net.requestPolicy
+ * @type Boolean
+ * @since 1.12
+ * */
+static JSValueRef
+rp_get_enabled(JSContextRef ctx, JSObjectRef object, JSStringRef property, JSValueRef* exception) 
+{
+    return JSValueMakeBoolean(ctx, request_policy_enabled());
+}
+static bool 
+rp_set_enabled(JSContextRef ctx, JSObjectRef object, JSStringRef property, JSValueRef value, JSValueRef* exception) 
+{
+    request_policy_set_enabled(JSValueToBoolean(ctx, value));
+    return true;
+}
+/** 
+ * Allows requests from a thirdparty domain on a site
+ *
+ * @name allow
+ * @memberOf net.requestPolicy
+ * @function
+ * @since 1.12
+ *
+ * @param {String} firstParty 
+ *      Base domain of the site, if null the domain is allowed on all sites
+ * @param {String} domain 
+ *      Base domain of the thirdparty, if null all requests are allowed on
+ *      firstParty
+ * @param {Boolean} [temporary] 
+ *      Whether the entry is temporary, default false
+ *
+ * @returns {Boolean}
+ *      true if the entry was new
+ * @example 
+ * net.requestPolicy.allow("example.com", "examplecdn.com");
+ * net.requestPolicy.allow(null, "gstatic.com");
+ * */
+static JSValueRef 
+rp_allow(JSContextRef ctx, JSObjectRef f, JSObjectRef thisObject, size_t argc, const JSValueRef argv[], JSValueRef* exc) 
+{
+    gboolean ret = false;
+    char *first_party = rp_get_domain(ctx, argc, argv, 0, exc);
+    char *domain = rp_get_domain(ctx, argc, argv, 1, exc);
+    if (first_party != NULL || domain != NULL)
+        ret = request_policy_allow(first_party, domain, rp_get_flags(ctx, argc, argv, 2, REQUEST_POLICY_PERSISTENT));
+    g_free(first_party);
+    g_free(domain);
+    return JSValueMakeBoolean(ctx, ret);
+}
+/** 
+ * Removes an entry that was added with {@link net.requestPolicy.allow}, if
+ * domain is null all entries of the site are removed
+ *
+ * @name disallow
+ * @memberOf net.requestPolicy
+ * @function
+ * @since 1.12
+ *
+ * @param {String} firstParty   Base domain of the site or null 
+ * @param {String} domain       Base domain of the thirdparty or null
+ * @param {Boolean} [temporary] 
+ *      Only remove temporary or persistent entries, if omitted both are removed
+ *
+ * @returns {Boolean}
+ *      true if an entry was removed
+ * */
+static JSValueRef 
+rp_disallow(JSContextRef ctx, JSObjectRef f, JSObjectRef thisObject, size_t argc, const JSValueRef argv[], JSValueRef* exc) 
+{
+    gboolean ret = false;
+    char *first_party = rp_get_domain(ctx, argc, argv, 0, exc);
+    char *domain = rp_get_domain(ctx, argc, argv, 1, exc);
+    if (first_party != NULL || domain != NULL)
+        ret = request_policy_disallow(first_party, domain, rp_get_flags(ctx, argc, argv, 2, REQUEST_POLICY_ALL));
+    g_free(first_party);
+    g_free(domain);
+    return JSValueMakeBoolean(ctx, ret);
+}
+/** 
+ * Blocks requests from a domain on all sites, blocked domains have precedence
+ * over all other entries
+ *
+ * @name block
+ * @memberOf net.requestPolicy
+ * @function
+ * @since 1.12
+ *
+ * @param {String} domain       Base domain of the thirdparty
+ * @param {Boolean} [temporary] Whether the entry is temporary, default false
+ *
+ * @returns {Boolean}
+ *      true if the entry was new
+ * */
+static JSValueRef 
+rp_block(JSContextRef ctx, JSObjectRef f, JSObjectRef thisObject, size_t argc, const JSValueRef argv[], JSValueRef* exc) 
+{
+    gboolean ret = false;
+    char *domain = rp_get_domain(ctx, argc, argv, 0, exc);
+    if (domain != NULL)
+        ret = request_policy_block(domain, rp_get_flags(ctx, argc, argv, 1, REQUEST_POLICY_PERSISTENT));
+    g_free(domain);
+    return JSValueMakeBoolean(ctx, ret);
+}
+/** 
+ * Removes a domain that was blocked with {@link net.requestPolicy.block}
+ *
+ * @name unblock
+ * @memberOf net.requestPolicy
+ * @function
+ * @since 1.12
+ *
+ * @param {String} domain       Base domain of the thirdparty
+ * @param {Boolean} [temporary] 
+ *      Only remove a temporary or persistent entry, if omitted both are removed
+ *
+ * @returns {Boolean}
+ *      true if the domain was blocked
+ * */
+static JSValueRef 
+rp_unblock(JSContextRef ctx, JSObjectRef f, JSObjectRef thisObject, size_t argc, const JSValueRef argv[], JSValueRef* exc) 
+{
+    gboolean ret = false;
+    char *domain = rp_get_domain(ctx, argc, argv, 0, exc);
+    if (domain != NULL)
+        ret = request_policy_unblock(domain, rp_get_flags(ctx, argc, argv, 1, REQUEST_POLICY_ALL));
+    g_free(domain);
+    return JSValueMakeBoolean(ctx, ret);
+}
+/** 
+ * Removes all entries
+ *
+ * @name clear
+ * @memberOf net.requestPolicy
+ * @function
+ * @since 1.12
+ *
+ * @param {Boolean} [temporary] 
+ *      Only remove temporary or persistent entries, if omitted all entries
+ *      are removed
+ * */
+static JSValueRef 
+rp_clear(JSContextRef ctx, JSObjectRef f, JSObjectRef thisObject, size_t argc, const JSValueRef argv[], JSValueRef* exc) 
+{
+    request_policy_clear(rp_get_flags(ctx, argc, argv, 0, REQUEST_POLICY_ALL));
+    return NIL;
+}
+/** 
+ * Checks if requests from a thirdparty domain are allowed on a site
+ *
+ * @name isAllowed
+ * @memberOf net.requestPolicy
+ * @function
+ * @since 1.12
+ *
+ * @param {String} firstParty   Base domain of the site
+ * @param {String} domain       Base domain of the thirdparty
+ *
+ * @returns {Boolean}
+ *      Whether the request would be allowed
+ * */
+static JSValueRef 
+rp_is_allowed(JSContextRef ctx, JSObjectRef f, JSObjectRef thisObject, size_t argc, const JSValueRef argv[], JSValueRef* exc) 
+{
+    char *first_party = rp_get_domain(ctx, argc, argv, 0, exc);
+    char *domain = rp_get_domain(ctx, argc, argv, 1, exc);
+    gboolean ret = request_policy_allowed(first_party, domain);
+    g_free(first_party);
+    g_free(domain);
+    return JSValueMakeBoolean(ctx, ret);
+}/*}}}*/
+
 JSObjectRef 
 net_initialize(JSContextRef ctx) {
     /**
@@ -346,6 +762,7 @@ net_initialize(JSContextRef ctx) {
     JSStaticFunction net_functions[] = { 
         { "sendRequest",      net_send_request,         kJSDefaultAttributes },
         { "sendRequestSync",  net_send_request_sync,         kJSDefaultAttributes },
+        { "sendRequests",     net_send_requests,        kJSDefaultAttributes },
         { "domainFromHost",   net_domain_from_host,         kJSDefaultAttributes },
         { "parseUri",         net_parse_uri,         kJSDefaultAttributes },
         { "allCookies",       net_all_cookies,         kJSDefaultAttributes },
@@ -354,5 +771,38 @@ net_initialize(JSContextRef ctx) {
     JSClassRef klass = scripts_create_class("net", net_functions, net_values, NULL);
     JSObjectRef ret =  scripts_create_object(ctx, klass, global_object, kJSDefaultAttributes, "net", NULL);
     JSClassRelease(klass);
+
+    /**
+     * @namespace 
+     *      Native thirdparty request policy. If enabled requests from a
+     *      different base domain than the base domain of the site are
+     *      blocked unless they are allowed. The number of blocked requests and
+     *      the thirdparty domains of a site are available in {@link
+     *      WebKitWebView#blockedRequests} and {@link
+     *      WebKitWebView#thirdPartyDomains}.
+     * @name requestPolicy
+     * @memberOf net
+     * @static
+     * @since 1.12
+     * @example
+     * net.requestPolicy.allow("example.com", "examplecdn.com");
+     * net.requestPolicy.enabled = true;
+     * */
+    JSStaticValue rp_values[] = {
+        { "enabled",          rp_get_enabled, rp_set_enabled,   kJSPropertyAttributeDontDelete },
+        { 0, 0, 0,  0 }, 
+    };
+    JSStaticFunction rp_functions[] = { 
+        { "allow",            rp_allow,         kJSDefaultAttributes },
+        { "disallow",         rp_disallow,         kJSDefaultAttributes },
+        { "block",            rp_block,         kJSDefaultAttributes },
+        { "unblock",          rp_unblock,         kJSDefaultAttributes },
+        { "clear",            rp_clear,         kJSDefaultAttributes },
+        { "isAllowed",        rp_is_allowed,         kJSDefaultAttributes },
+        { 0, 0, 0 }, 
+    };
+    klass = scripts_create_class("requestPolicy", rp_functions, rp_values, NULL);
+    scripts_create_object(ctx, klass, ret, kJSDefaultAttributes, "requestPolicy", NULL);
+    JSClassRelease(klass);
     return ret;
 }
@@ -21,6 +21,16 @@
 #define SYSTEM_CHANNEL_OUT (0)
 #define SYSTEM_CHANNEL_ERR (1)
 
+#define SYSTEM_BATCH_SIZE       (16384)
+#define SYSTEM_BATCH_INTERVAL   (50)
+#define SYSTEM_BATCH_SIZE_MAX   (1048576)
+
+typedef struct SpawnBatch_s {
+    gsize size;
+    guint interval;
+    gboolean lines;
+} SpawnBatch;
+
 typedef struct SpawnData_s {
     GIOChannel *channel;
     JSObjectRef callback;
@@ -28,6 +38,10 @@ typedef struct SpawnData_s {
     GMutex mutex;
     int type;
     guint source;
+    /* Only used if output is delivered in batches */
+    SpawnBatch batch;
+    GString *buffer;
+    guint flush_source;
 } SpawnData;
 
 #define G_FILE_TEST_VALID (G_FILE_TEST_IS_REGULAR | G_FILE_TEST_IS_SYMLINK | G_FILE_TEST_IS_DIR | G_FILE_TEST_IS_EXECUTABLE | G_FILE_TEST_EXISTS) 
@@ -63,6 +77,77 @@ get_environment(JSContextRef ctx, JSValueRef v, JSValueRef *exc)
     }
     return envp;
 }
+/* spawn_flush {{{*/
+/* 
+ * Passes the buffered output to the callback. If the batch consists of whole
+ * lines only complete lines are passed unless it is the final flush or a
+ * single line exceeds the batch size. 
+ * */
+static void
+spawn_flush(JSContextRef ctx, SpawnData *data, gboolean final) 
+{
+    gsize length = data->buffer->len;
+    if (data->batch.lines && !final) {
+        char *end = g_strrstr_len(data->buffer->str, data->buffer->len, "\n");
+        if (end != NULL)
+            length = end - data->buffer->str + 1;
+        else if (data->buffer->len < data->batch.size) 
+            return;
+    }
+    if (length == 0)
+        return;
+
+    char *content = g_strndup(data->buffer->str, length);
+    g_string_erase(data->buffer, 0, length);
+
+    JSValueRef argv[] = { js_char_to_value(ctx, content) };
+    scripts_call_as_function(ctx, data->callback, data->callback, 1, argv);
+    g_free(content);
+}
+static gboolean 
+spawn_flush_timeout(SpawnData *data) 
+{
+    if (!g_mutex_trylock(&data->mutex)) {
+        return true;
+    }
+    data->flush_source = 0;
+
+    JSContextRef ctx = scripts_get_global_context();
+    if (ctx != NULL) {
+        spawn_flush(ctx, data, false);
+        scripts_release_global_context();
+    }
+    g_mutex_unlock(&data->mutex);
+    return false;
+}/*}}}*/
+
+/* 
+ * Reads at most one batch per wakeup, while the batch is full and the
+ * callback is running the pipe isn't read, so a child that writes faster than
+ * the callback consumes blocks on the full pipe. 
+ * */
+static void
+spawn_output_batch(GIOChannel *channel, SpawnData *data) 
+{
+    char buffer[4096];
+    gsize length;
+
+    while (data->buffer->len < data->batch.size && 
+            g_io_channel_read_chars(channel, buffer, MIN(sizeof(buffer), data->batch.size - data->buffer->len), 
+                &length, NULL) == G_IO_STATUS_NORMAL && length > 0) {
+        g_string_append_len(data->buffer, buffer, length);
+    }
+    if (data->buffer->len >= data->batch.size) {
+        JSContextRef ctx = scripts_get_global_context();
+        if (ctx != NULL) {
+            spawn_flush(ctx, data, false);
+            scripts_release_global_context();
+        }
+    }
+    if (data->buffer->len > 0 && data->flush_source == 0) {
+        data->flush_source = g_timeout_add(data->batch.interval, (GSourceFunc)spawn_flush_timeout, data);
+    }
+}
 static gboolean
 spawn_output(GIOChannel *channel, GIOCondition condition, SpawnData *data) 
 {
@@ -73,6 +158,11 @@ spawn_output(GIOChannel *channel, GIOCondition condition, SpawnData *data)
     if (!g_mutex_trylock(&data->mutex)) {
         return true;
     }
+    if (data->buffer != NULL) {
+        spawn_output_batch(channel, data);
+        g_mutex_unlock(&data->mutex);
+        return true;
+    }
     status = g_io_channel_read_line(channel, &content, &length, NULL, NULL);
     if (status == G_IO_STATUS_NORMAL && content != NULL)
     {
@@ -101,7 +191,12 @@ spawn_finish_data(SpawnData *data, int success)
         if (data->callback != NULL && data->channel != NULL) {
             // read remaining data
             GIOStatus status = g_io_channel_read_to_end(data->channel, &content, &l, NULL);
-            if (status == G_IO_STATUS_NORMAL && content != NULL) {
+            if (data->buffer != NULL) {
+                if (status == G_IO_STATUS_NORMAL && content != NULL) 
+                    g_string_append_len(data->buffer, content, l);
+                spawn_flush(ctx, data, true);
+            }
+            else if (status == G_IO_STATUS_NORMAL && content != NULL) {
                 JSValueRef argv[] = { js_char_to_value(ctx, content) };
                 scripts_call_as_function(ctx, data->callback, data->callback, 1, argv);
             }
@@ -126,6 +221,12 @@ spawn_finish_data(SpawnData *data, int success)
     if (data->source != 0) {
         g_source_remove(data->source);
     }
+    if (data->flush_source != 0) {
+        g_source_remove(data->flush_source);
+    }
+    if (data->buffer != NULL) {
+        g_string_free(data->buffer, true);
+    }
     if (data->channel != NULL) {
         g_io_channel_shutdown(data->channel, true, NULL);
         g_io_channel_unref(data->channel);
@@ -155,13 +256,18 @@ watch_spawn(GPid pid, gint status, SpawnData **data)
 }
 
 static SpawnData *
-initialize_channel(JSContextRef ctx, JSObjectRef callback, JSObjectRef deferred, int fd, int type) {
-    SpawnData *data = g_malloc(sizeof(SpawnData));
+initialize_channel(JSContextRef ctx, JSObjectRef callback, JSObjectRef deferred, int fd, int type, SpawnBatch *batch) {
+    SpawnData *data = g_malloc0(sizeof(SpawnData));
 
     data->deferred  = deferred;
     data->type      = type;
     g_mutex_init(&data->mutex);
 
+    if (callback != NULL && batch != NULL) {
+        data->batch = *batch;
+        data->buffer = g_string_sized_new(batch->size);
+    }
+
     if (callback != NULL) {
         data->callback = callback;
         JSValueProtect(ctx, callback);
@@ -171,11 +277,6 @@ initialize_channel(JSContextRef ctx, JSObjectRef callback, JSObjectRef deferred,
         g_io_channel_set_flags(data->channel, G_IO_FLAG_NONBLOCK, NULL);
         g_io_channel_set_close_on_unref(data->channel, true);
     }
-    else {
-        data->callback = NULL; 
-        data->channel = NULL;
-        data->source = 0;
-    }
     return data;
 }
 
@@ -299,9 +400,9 @@ system_spawn_sync(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject
             g_spawn_sync(NULL, srgv, envp, G_SPAWN_SEARCH_PATH, NULL, NULL, &out, &err, &status, NULL)) 
     {
         ret = JSObjectMake(ctx, NULL, NULL);
-        js_set_object_property(ctx, ret, "stdout", out, exc);
-        js_set_object_property(ctx, ret, "stderr", err, exc);
-        js_set_object_number_property(ctx, ret, "status", status, exc);
+        js_set_object_property_interned(ctx, ret, JS_PROP_STDOUT, out, exc);
+        js_set_object_property_interned(ctx, ret, JS_PROP_STDERR, err, exc);
+        js_set_object_number_property_interned(ctx, ret, JS_PROP_STATUS, status, exc);
     }
     g_free(command);
     g_strfreev(srgv);
@@ -364,6 +465,13 @@ system_spawn_sync(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject
  * }).then(function(result) { 
  *      io.out(result.stdout); 
  * });
+ * // Processing a lot of output in batches of lines
+ * system.spawn("grep -r foo /path", {
+ *      onStdout : function(lines) {
+ *          io.out("got " + lines.length + " lines");
+ *      },
+ *      batch : { size : 65536, interval : 100 }
+ * });
  *
  *
  * @param {String} command The command to execute
@@ -398,6 +506,19 @@ system_spawn_sync(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject
  *     String that will be piped to stdin of the child process. 
  * @param {Object} [options.environment] 
  *     Hash of environment variables that will be set in the childs environment
+ * @param {Object} [options.batch] 
+ *     If set stdout and stderr are delivered in batches instead of line by
+ *     line, <b>onStdout</b> and <b>onStderr</b> are then called with an
+ *     array of lines or with a string. A batch is delivered when it is full or
+ *     when the interval has elapsed. While a batch is processed the output of
+ *     the child isn't read, since 1.12
+ * @param {Number} [options.batch.size] 
+ *     Maximum size of a batch in bytes, default 16384
+ * @param {Number} [options.batch.interval] 
+ *     Maximum time in milliseconds output is buffered, default 50
+ * @param {Boolean} [options.batch.lines] 
+ *     Whether a batch is passed as an array of complete lines, if false the raw
+ *     output is passed as string, default true
  *
  * @returns {Deferred}
  *      A deferred, it will be resolved if the child exits normally, it will be
@@ -419,6 +540,7 @@ system_spawn(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject, siz
     GPid pid;
     char *pipe_stdin = NULL;
     gint spawn_options = G_SPAWN_SEARCH_PATH | G_SPAWN_DO_NOT_REAP_CHILD;
+    SpawnBatch batch_data, *batch = NULL;
 
 
     if (argc == 0) 
@@ -440,6 +562,20 @@ system_spawn(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject, siz
     if (argc > 4)
         envp = get_environment(ctx, argv[4], exc);
 
+    if (argc > 5 && JSValueIsObject(ctx, argv[5])) {
+        JSObjectRef o = JSValueToObject(ctx, argv[5], exc);
+        if (o != NULL) {
+            double size = js_get_double_property_interned(ctx, o, JS_PROP_SIZE);
+            double interval = js_get_double_property_interned(ctx, o, JS_PROP_INTERVAL);
+            JSValueRef lines = JSObjectGetProperty(ctx, o, js_interned(JS_PROP_LINES), NULL);
+
+            batch_data.size = isnan(size) || size < 1 ? SYSTEM_BATCH_SIZE : (gsize)MIN(size, SYSTEM_BATCH_SIZE_MAX);
+            batch_data.interval = isnan(interval) || interval < 0 ? SYSTEM_BATCH_INTERVAL : (guint)interval;
+            batch_data.lines = lines == NULL || JSValueIsUndefined(ctx, lines) || JSValueToBoolean(ctx, lines);
+            batch = &batch_data;
+        }
+    }
+
     if (oc == NULL) {
         spawn_options |= G_SPAWN_STDOUT_TO_DEV_NULL;
     }
@@ -463,8 +599,8 @@ system_spawn(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject, siz
 
     data = g_malloc_n(2, sizeof(SpawnData*));
 
-    data[SYSTEM_CHANNEL_OUT] = initialize_channel(ctx, oc, deferred, outfd, SYSTEM_CHANNEL_OUT);
-    data[SYSTEM_CHANNEL_ERR] = initialize_channel(ctx, ec, deferred, errfd, SYSTEM_CHANNEL_ERR);
+    data[SYSTEM_CHANNEL_OUT] = initialize_channel(ctx, oc, deferred, outfd, SYSTEM_CHANNEL_OUT, batch);
+    data[SYSTEM_CHANNEL_ERR] = initialize_channel(ctx, ec, deferred, errfd, SYSTEM_CHANNEL_ERR, batch);
 
     if (pipe_stdin != NULL && infd != -1)
     {
@@ -46,7 +46,7 @@ tabs_current(JSContextRef ctx, JSObjectRef this, JSStringRef name, JSValueRef* e
 static JSValueRef 
 tabs_number(JSContextRef ctx, JSObjectRef this, JSStringRef name, JSValueRef* exc) 
 {
-    return JSValueMakeNumber(ctx, g_list_position(dwb.state.views, dwb.state.fview));
+    return JSValueMakeNumber(ctx, dwb_tab_index(dwb.state.fview));
 }/*}}}*/
 
 /* tabs_length {{{*/
@@ -60,7 +60,7 @@ tabs_number(JSContextRef ctx, JSObjectRef this, JSStringRef name, JSValueRef* ex
 static JSValueRef 
 tabs_length(JSContextRef ctx, JSObjectRef this, JSStringRef name, JSValueRef* exc) 
 {
-    return JSValueMakeNumber(ctx, g_list_length(dwb.state.views));
+    return JSValueMakeNumber(ctx, dwb_tab_count());
 }/*}}}*/
 
 /* tabs_get{{{*/
@@ -69,7 +69,7 @@ tabs_get(JSContextRef ctx, JSObjectRef this, JSStringRef name, JSValueRef* exc)
     JSValueRef v = JSValueMakeString(ctx, name);
     double n = JSValueToNumber(ctx, v, exc);
     if (!isnan(n)) {
-        GList *nth = g_list_nth(dwb.state.views, (int)n);
+        GList *nth = dwb_tab_nth((int)n);
         if (nth != NULL) {
             return VIEW(nth)->script_wv;
         }
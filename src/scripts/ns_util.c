@@ -162,8 +162,8 @@ sutil_tab_complete(JSContextRef ctx, JSObjectRef f, JSObjectRef thisObject, size
         cur = JSValueToObject(ctx, val, exc);
         if (cur == NULL)
             goto error_out;
-        left = js_get_string_property(ctx, cur, "left");
-        right = js_get_string_property(ctx, cur, "right");
+        left = js_get_string_property_interned(ctx, cur, JS_PROP_LEFT);
+        right = js_get_string_property_interned(ctx, cur, JS_PROP_RIGHT);
         n = g_malloc(sizeof(Navigation));
         n->first = left; 
         n->second = right;
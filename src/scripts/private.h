@@ -25,6 +25,7 @@ typedef struct ScriptContext_s ScriptContext;
 #include "../js.h" 
 #include "../soup.h" 
 #include "../domain.h" 
+#include "../requestpolicy.h" 
 #include "../application.h" 
 #include "../completion.h" 
 #include "../entry.h" 
@@ -49,6 +50,7 @@ typedef struct ScriptContext_s ScriptContext;
 #include "cl_frame.h"
 #include "cl_message.h"
 #include "cl_gtimer.h"
+#include "cl_urlpattern.h"
 #include "cl_history.h"
 #include "cl_widget.h"
 #include "cl_menu.h"
@@ -83,6 +85,7 @@ enum {
     CLASS_DOM_EVENT, 
 #endif
     CLASS_TIMER,
+    CLASS_URL_PATTERN_SET,
     CLASS_LAST,
 };
 
@@ -101,6 +104,7 @@ enum {
     CONSTRUCTOR_MENU,
     CONSTRUCTOR_ARRAY,
     CONSTRUCTOR_TIMER, 
+    CONSTRUCTOR_URL_PATTERN_SET, 
     CONSTRUCTOR_LAST,
 };
 
@@ -176,7 +180,7 @@ JSObjectRef
 scripts_create_object(JSContextRef, JSClassRef, JSObjectRef, JSClassAttributes, const char *, void *); 
 
 JSValueRef 
-scripts_include(JSContextRef, const char *, const char *, gboolean, gboolean , size_t, const JSValueRef *, JSValueRef *exc);
+scripts_include(JSContextRef, const char *, const char *, int, gboolean, gboolean , size_t, const JSValueRef *, JSValueRef *exc);
 
 JSObjectRef
 scripts_get_exports(JSContextRef ctx, const char *path);
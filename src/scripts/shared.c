@@ -22,14 +22,14 @@ JSObjectRef
 suri_to_object(JSContextRef ctx, SoupURI *uri, JSValueRef *exception)
 {
     JSObjectRef o = JSObjectMake(ctx, NULL, NULL);
-    js_set_object_property(ctx, o, "scheme", uri->scheme, exception);
-    js_set_object_property(ctx, o, "user", uri->user, exception);
-    js_set_object_property(ctx, o, "password", uri->password, exception);
-    js_set_object_property(ctx, o, "host", uri->host, exception);
-    js_set_object_number_property(ctx, o, "port", uri->port, exception);
-    js_set_object_property(ctx, o, "path", uri->path, exception);
-    js_set_object_property(ctx, o, "query", uri->query, exception);
-    js_set_object_property(ctx, o, "fragment", uri->fragment, exception);
+    js_set_object_property_interned(ctx, o, JS_PROP_SCHEME, uri->scheme, exception);
+    js_set_object_property_interned(ctx, o, JS_PROP_USER, uri->user, exception);
+    js_set_object_property_interned(ctx, o, JS_PROP_PASSWORD, uri->password, exception);
+    js_set_object_property_interned(ctx, o, JS_PROP_HOST, uri->host, exception);
+    js_set_object_number_property_interned(ctx, o, JS_PROP_PORT, uri->port, exception);
+    js_set_object_property_interned(ctx, o, JS_PROP_PATH, uri->path, exception);
+    js_set_object_property_interned(ctx, o, JS_PROP_QUERY, uri->query, exception);
+    js_set_object_property_interned(ctx, o, JS_PROP_FRAGMENT, uri->fragment, exception);
     return o;
 }
 
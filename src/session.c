@@ -25,18 +25,42 @@
 
 static char *s_session_name;
 static gboolean s_has_marked = true;
+static char *s_session_dir;
+static char *s_written_path;
+static char *s_written;
+static GHashTable *s_tab_cache;
 
 typedef struct _SessionTab {
     GList *gl;
     unsigned int lock;
 } SessionTab;
 
-/* session_get_groups()                 return  char  ** (alloc){{{*/
+typedef struct _SessionItems {
+    GList *items;
+    int forward;
+    unsigned int lock;
+} SessionItems;
+
+/* Serialized state of a tab, keyed by the id of the view. The data is reused
+ * as long as the current history item, the length of the back-forward list,
+ * the lock state and the title are unchanged */
+typedef struct _SessionTabCache {
+    gconstpointer item;
+    guint serial;
+    int back;
+    int forward;
+    unsigned int lock;
+    char *uri;
+    char *title;
+    char *data;
+} SessionTabCache;
+
+/* session_split_groups(const char *)             return  char  ** (alloc){{{*/
 static char **
-session_get_groups() 
+session_split_groups(const char *filename) 
 {
     char **groups = NULL;
-    char *content = util_get_file_content(dwb.files[FILES_SESSION], NULL);
+    char *content = util_get_file_content(filename, NULL);
     if (content) 
     {
         groups = g_regex_split_simple("^g:", content, G_REGEX_MULTILINE, G_REGEX_MATCH_NOTEMPTY);
@@ -45,36 +69,97 @@ session_get_groups()
     return groups;
 }/*}}}*/
 
+/* session_get_filename(const char *)     return char* (alloc){{{*/
+static char *
+session_get_filename(const char *dir, const char *name) 
+{
+    char *escaped = g_uri_escape_string(name, NULL, false);
+    char *filename;
+    if (*escaped == '.') 
+    {
+        char *tmp = g_strconcat("%2E", escaped + 1, NULL);
+        filename = g_build_filename(dir, tmp, NULL);
+        g_free(tmp);
+    }
+    else 
+        filename = g_build_filename(dir, escaped, NULL);
+    g_free(escaped);
+    return filename;
+}/*}}}*/
+
+/* session_migrate(const char *dir) {{{*/
+/* 
+ * Older versions stored all sessions in a single file, every group is moved
+ * into its own file 
+ * */
+static void
+session_migrate(const char *dir)
+{
+    gboolean success = true;
+    if (! g_file_test(dwb.files[FILES_SESSION], G_FILE_TEST_IS_REGULAR)) 
+        return;
+
+    char **groups = session_split_groups(dwb.files[FILES_SESSION]);
+    if (groups == NULL || groups[0] == NULL || groups[1] == NULL) 
+    {
+        g_strfreev(groups);
+        return;
+    }
+    for (int i=1; groups[i]; i++) 
+    {
+        const char *name = *groups[i] == '*' ? groups[i] + 1 : groups[i];
+        const char *end = strchr(name, '\n');
+        if (end == NULL || end == name) 
+            continue;
+
+        char *groupname = g_strndup(name, end - name);
+        char *filename = session_get_filename(dir, groupname);
+        if (! g_file_test(filename, G_FILE_TEST_EXISTS)) 
+        {
+            char *content = g_strconcat("g:", groups[i], NULL);
+            success = util_set_file_content(filename, content) && success;
+            g_free(content);
+        }
+        g_free(filename);
+        g_free(groupname);
+    }
+    if (success) 
+        util_set_file_content(dwb.files[FILES_SESSION], "");
+    g_strfreev(groups);
+}/*}}}*/
+
+/* session_get_dir()                    return const char * {{{*/
+static const char *
+session_get_dir() 
+{
+    if (s_session_dir == NULL) 
+    {
+        char *path = g_path_get_dirname(dwb.files[FILES_SESSION]);
+        s_session_dir = util_check_directory(g_build_filename(path, "sessions", NULL));
+        session_migrate(s_session_dir);
+        g_free(path);
+    }
+    return s_session_dir;
+}/*}}}*/
+
 /* session_get_group(const char *)     return char* (alloc){{{*/
 static char *
 session_get_group(const char *name, gboolean *is_marked) 
 {
-    char *content = NULL;
-    gboolean mark;
-    guint l = strlen (name);
-    const char *group = NULL;
-
-    char **groups = session_get_groups();
-    if (groups) {
-        int i=1;
-        while (groups[i]) {
-            group = groups[i];
-            mark = false;
-            if (*groups[i] == '*') 
-            {
-                group++;
-                mark = true;
-            }
-            if (strlen(group) > l+1 && !strncmp(group, name, l) && group[l] == '\n') 
-            {
-                content = g_strdup(groups[i]);
-                *is_marked = mark;
-            }
-            i++;
-        }
-        g_strfreev(groups);
+    char *content = NULL, *group = NULL;
+    char *filename = session_get_filename(session_get_dir(), name);
+
+    if (g_file_test(filename, G_FILE_TEST_IS_REGULAR)) 
+        content = util_get_file_content(filename, NULL);
+
+    if (content != NULL && g_str_has_prefix(content, "g:")) 
+    {
+        *is_marked = content[2] == '*';
+        group = g_strdup(content + (*is_marked ? 3 : 2));
     }
-    return content;
+    g_free(content);
+    g_free(filename);
+    return group;
 }/*}}}*/
 
 /* session_save_file (const char *group, const char *content, gboolean * mark_group) {{{*/
@@ -84,41 +169,28 @@ session_save_file(const char *groupname, const char *content, gboolean mark)
     if (groupname == NULL || content == NULL)
         return;
 
-    gboolean set = false;
-    GString *buffer = g_string_new(NULL);
-    char *group = NULL;
+    char *filename = session_get_filename(session_get_dir(), groupname);
+    char *buffer = g_strdup_printf("g:%s%s\n%s", mark ? "*" : "", groupname, content);
 
-    char **groups = session_get_groups();
-    if (groups) 
+    /* Periodic syncs mostly save an unchanged session */
+    if (!g_strcmp0(filename, s_written_path) && !g_strcmp0(buffer, s_written)) 
     {
-        int i=1;
-        group = g_strconcat(groupname,  "\n", NULL);
-        int l = strlen(group);
-        while(groups[i]) 
-        {
-            if (*groups[i] == '*') 
-            {
-                if (!strncmp(groups[i]+1, group, l-1)) 
-                {
-                    g_string_append_printf(buffer, "g:%s%s\n%s", mark ? "*" : "", groupname, content);
-                    set = true;
-                }
-                else 
-                    g_string_append_printf(buffer, "g:%s", groups[i]+1);
-
-            }
-            else if (strncmp(groups[i], group, l)) 
-                g_string_append_printf(buffer, "g:%s", groups[i]);
-            i++;
-        }
+        g_free(filename);
+        g_free(buffer);
+        return;
+    }
+    if (util_set_file_content(filename, buffer)) 
+    {
+        g_free(s_written_path);
+        g_free(s_written);
+        s_written_path = filename;
+        s_written = buffer;
+    }
+    else 
+    {
+        g_free(filename);
+        g_free(buffer);
     }
-    if (!set) 
-        g_string_append_printf(buffer, "g:%s%s\n%s", mark ? "*" : "", groupname, content);
-
-    util_set_file_content(dwb.files[FILES_SESSION], buffer->str);
-    g_string_free(buffer, true);
-    g_free(group);
-    g_strfreev(groups);
 }/*}}}*/
 
 void
@@ -140,9 +212,9 @@ session_clear_session()
     session_save_file(s_session_name ? s_session_name : "default", "", true);
 }
 
-/* session_load_webview(WebKitWebView *, char *, int *){{{*/
+/* session_load_webview(GList *, int, int){{{*/
 static void
-session_load_webview(GList *gl, char *uri, int last, int lock_status) \
+session_load_webview(GList *gl, int last, int lock_status) 
 {
     if (last > 0) 
         webkit_web_view_go_back_or_forward(WEBVIEW(gl), -last);
@@ -165,38 +237,72 @@ void
 session_list() 
 {
     char *path = util_build_path();
-    dwb.files[FILES_SESSION] = util_check_directory(g_build_filename(path, dwb.misc.profile, "session", NULL));
-    char **content = session_get_groups();
-    if (content == NULL) 
+    GSList *names = NULL;
+    const char *filename;
+    int i=1;
+
+    dwb.files[FILES_SESSION] = g_build_filename(path, dwb.misc.profile, "session", NULL);
+    GDir *dir = g_dir_open(session_get_dir(), 0, NULL);
+    if (dir != NULL) 
     {
-        fprintf(stderr, "No sessions found for profile: %s\n", dwb.misc.profile);
-        exit(EXIT_SUCCESS);
+        while ((filename = g_dir_read_name(dir)) != NULL) 
+        {
+            char *path = g_build_filename(s_session_dir, filename, NULL);
+            char *content = util_get_file_content(path, NULL);
+            if (content != NULL && g_str_has_prefix(content, "g:")) 
+            {
+                char *end = strchr(content, '\n');
+                names = g_slist_insert_sorted(names, 
+                        end ? g_strndup(content + 2, end - content - 2) : g_strdup(content + 2), (GCompareFunc)g_strcmp0);
+            }
+            g_free(content);
+            g_free(path);
+        }
+        g_dir_close(dir);
     }
-    int i=1;
-    while (content[i]) 
+    if (names == NULL) 
     {
-        char **group = g_strsplit(content[i], "\n", -1);
-        fprintf(stdout, "%d: %s\n", i++, group[0]);
-        g_strfreev(group);
+        fprintf(stderr, "No sessions found for profile: %s\n", dwb.misc.profile);
+        exit(EXIT_SUCCESS);
     }
-    g_strfreev(content);
+    for (GSList *l = names; l; l=l->next) 
+        fprintf(stdout, "%d: %s\n", i++, (char*)l->data);
+    g_slist_free_full(names, g_free);
     g_free(path);
 
     exit(EXIT_SUCCESS);
 }/*}}}*/
 
+/* session_clear_all {{{*/
+void
+session_clear_all() 
+{
+    const char *filename;
+    GDir *dir = g_dir_open(session_get_dir(), 0, NULL);
+    if (dir != NULL) 
+    {
+        while ((filename = g_dir_read_name(dir)) != NULL) 
+        {
+            char *path = g_build_filename(s_session_dir, filename, NULL);
+            remove(path);
+            g_free(path);
+        }
+        g_dir_close(dir);
+    }
+    FREE0(s_written_path);
+    FREE0(s_written);
+}/*}}}*/
+
 /* session_restore(const char *name) {{{*/
 gboolean
 session_restore(char *name, int flags) 
 {
     gboolean is_marked = false;
-    char *uri = NULL;
-    GList *currentview = NULL, *lastview = NULL;
-    WebKitWebBackForwardList *bf_list = NULL;
+    GList *tabs = NULL;
+    SessionItems *tab = NULL;
     int last = 1;
     char *end;
     gboolean ret = false;
-    int locked_state = 0;
     if (name == NULL) 
         s_session_name = g_strdup("default");
     else 
@@ -228,42 +334,71 @@ session_restore(char *name, int flags)
         {
             int current = strtol(line[0], &end, 10);
 
-            if (current <= last) 
+            if (tab == NULL || current <= last) 
             {
-                currentview = view_add(NULL, false);
-                bf_list = webkit_web_view_get_back_forward_list(WEBVIEW(currentview));
-                if (lastview) 
-                {
-                    session_load_webview(lastview, uri, last, locked_state);
-                    locked_state = 0;
-                }
-                lastview = currentview;
+                tab = dwb_malloc(sizeof(SessionItems));
+                tab->items = NULL;
+                tab->forward = 0;
+                tab->lock = 0;
+                tabs = g_list_append(tabs, tab);
             }
             if (current == 0 && *end == '|') 
-                locked_state = strtol(end+1, NULL, 10);
-            if (bf_list != NULL) 
-            {
-                WebKitWebHistoryItem *item = webkit_web_history_item_new_with_data(line[1], line[2]);
-                webkit_web_back_forward_list_add_item(bf_list, item);
-            }
+                tab->lock = strtol(end+1, NULL, 10);
+            else if (current > 0)
+                tab->forward++;
+            tab->items = g_list_append(tab->items, dwb_navigation_new(line[1], line[2]));
             last = current;
-            g_free(uri);
-            uri = g_strdup(line[1]);
         }
-        if (i == length && lastview)
-            session_load_webview(lastview, uri, last, locked_state);
-
         g_strfreev(line);
     }
     g_strfreev(lines);
 
+    /* Only the last tab gets focus, all other tabs are restored as
+     * hibernated tabs and are loaded when they get focus. Every tab is
+     * inserted after the previously restored tab, background tabs would
+     * otherwise be placed according to new-tab-position-policy. */
+    GList *gl, *last = NULL;
+    for (GList *l = tabs; l; l=l->next) 
+    {
+        tab = l->data;
+        int items = g_list_length(tab->items);
+        int position = last != NULL ? dwb_tab_index(last) + 1 : dwb_tab_count();
+        if (tab->forward >= items)
+            tab->forward = items - 1;
+
+        if (l->next != NULL) 
+            gl = view_add_hibernated(tab->items, tab->forward, tab->lock, position);
+        else if ((gl = view_add_at(NULL, false, position)) == NULL)
+            g_list_free_full(tab->items, (GDestroyNotify)dwb_navigation_free);
+        else 
+        {
+            WebKitWebBackForwardList *bf_list = webkit_web_view_get_back_forward_list(WEBVIEW(gl));
+            for (GList *item = tab->items; item; item=item->next) 
+            {
+                Navigation *n = item->data;
+                WebKitWebHistoryItem *hi = webkit_web_history_item_new_with_data(n->first, n->second);
+                webkit_web_back_forward_list_add_item(bf_list, hi);
+                g_object_unref(hi);
+            }
+            session_load_webview(gl, tab->forward, tab->lock);
+            g_list_free_full(tab->items, (GDestroyNotify)dwb_navigation_free);
+        }
+        if (gl != NULL) 
+        {
+            /* The saved order must be kept */
+            g_warn_if_fail(last == NULL || dwb_tab_index(gl) == dwb_tab_index(last) + 1);
+            last = gl;
+        }
+        g_free(tab);
+    }
+    g_list_free(tabs);
+
     if (!dwb.state.views) 
     {
         view_add(NULL, false);
         dwb_open_startpage(dwb.state.fview);
     }
     dwb_focus(dwb.state.fview);
-    g_free(uri);
     ret = true;
 
 clean:
@@ -286,6 +421,95 @@ session_get_name()
 }
 
 
+/* session_tab_cache_free(SessionTabCache *) {{{*/
+static void
+session_tab_cache_free(SessionTabCache *c) 
+{
+    g_free(c->uri);
+    g_free(c->title);
+    g_free(c->data);
+    g_free(c);
+}/*}}}*/
+
+/* session_tab_state(GList *, SessionTabCache *) {{{*/
+static void
+session_tab_state(GList *gl, SessionTabCache *state) 
+{
+    View *v = VIEW(gl);
+    ViewHibernation *h = v->status->hibernation;
+
+    state->back = state->forward = 0;
+    state->serial = 0;
+    state->uri = state->title = NULL;
+    state->lock = v->status->lockprotect;
+    if (h != NULL) 
+    {
+        state->item = h;
+        state->serial = h->serial;
+        state->lock |= h->lockprotect;
+    }
+    else if (v->status->deferred) 
+    {
+        state->item = v->status->deferred_uri;
+        state->uri = v->status->deferred_uri;
+    }
+    else 
+    {
+        WebKitWebBackForwardList *bf_list = webkit_web_view_get_back_forward_list(WEBVIEW(gl));
+        WebKitWebHistoryItem *item = webkit_web_back_forward_list_get_current_item(bf_list);
+        state->item = item;
+        state->back = webkit_web_back_forward_list_get_back_length(bf_list);
+        state->forward = webkit_web_back_forward_list_get_forward_length(bf_list);
+        /* The uri of the current item is changed in place by
+         * history.replaceState and fragment navigation */
+        if (item != NULL) 
+        {
+            state->uri = (char *)webkit_web_history_item_get_uri(item);
+            state->title = (char *)webkit_web_history_item_get_title(item);
+        }
+    }
+}/*}}}*/
+
+/* session_serialize_tab(GList *, GString *) {{{*/
+static void
+session_serialize_tab(GList *gl, GString *buffer) 
+{
+    View *v = VIEW(gl);
+    ViewHibernation *h = v->status->hibernation;
+    if (h != NULL)
+    {
+        int i = h->forward - g_list_length(h->items) + 1;
+        for (GList *item = h->items; item; item=item->next, i++)
+        {
+            Navigation *n = item->data;
+            g_string_append_printf(buffer, "%d", i);
+            if (i == 0)
+                g_string_append_printf(buffer, "|%d", v->status->lockprotect | h->lockprotect);
+            g_string_append_printf(buffer, " %s %s\n", n->first, n->second);
+        }
+        return;
+    }
+    if (v->status->deferred)
+    {
+        g_string_append_printf(buffer, "0|%d %s unknown\n", v->status->lockprotect, v->status->deferred_uri);
+        return;
+    }
+    WebKitWebBackForwardList *bf_list = webkit_web_view_get_back_forward_list(WEBVIEW(gl));
+    for (int i= -webkit_web_back_forward_list_get_back_length(bf_list); i<=webkit_web_back_forward_list_get_forward_length(bf_list); i++) 
+    {
+        WebKitWebHistoryItem *item = webkit_web_back_forward_list_get_nth_item(bf_list, i);
+        if (item) 
+        {
+            g_string_append_printf(buffer, "%d", i);
+            if (i == 0) 
+                g_string_append_printf(buffer, "|%d", v->status->lockprotect);
+
+            g_string_append_printf(buffer, " %s %s\n", 
+                    webkit_web_history_item_get_uri(item), webkit_web_history_item_get_title(item));
+        }
+    }
+}/*}}}*/
+
 /* session_save(const char *) {{{*/
 gboolean  
 session_save(const char *name, int flags) 
@@ -300,30 +524,38 @@ session_save(const char *name, int flags)
     if (!s_has_marked && (flags & SESSION_FORCE) == 0) 
         return false;
     GString *buffer = g_string_new(NULL);
+    GHashTable *cache = g_hash_table_new_full(NULL, NULL, NULL, (GDestroyNotify)session_tab_cache_free);
 
     for (GList *l = g_list_first(dwb.state.views); l; l=l->next) 
     {
-        WebKitWebView *web = WEBVIEW(l);
-        WebKitWebBackForwardList *bf_list = webkit_web_view_get_back_forward_list(web);
-        if (VIEW(l)->status->deferred) 
+        SessionTabCache state;
+        gpointer id = GUINT_TO_POINTER(VIEW(l)->id);
+        SessionTabCache *c = s_tab_cache != NULL ? g_hash_table_lookup(s_tab_cache, id) : NULL;
+
+        session_tab_state(l, &state);
+        if (c != NULL && c->item == state.item && c->serial == state.serial && c->back == state.back && c->forward == state.forward 
+                && c->lock == state.lock && !g_strcmp0(c->uri, state.uri) && !g_strcmp0(c->title, state.title)) 
         {
-            g_string_append_printf(buffer, "0|%d %s unknown\n", VIEW(l)->status->lockprotect, VIEW(l)->status->deferred_uri);
-            continue;
+            g_hash_table_steal(s_tab_cache, id);
         }
-        for (int i= -webkit_web_back_forward_list_get_back_length(bf_list); i<=webkit_web_back_forward_list_get_forward_length(bf_list); i++) 
+        else 
         {
-            WebKitWebHistoryItem *item = webkit_web_back_forward_list_get_nth_item(bf_list, i);
-            if (item) 
-            {
-                g_string_append_printf(buffer, "%d", i);
-                if (i == 0) 
-                    g_string_append_printf(buffer, "|%d", VIEW(l)->status->lockprotect);
+            GString *data = g_string_new(NULL);
+            session_serialize_tab(l, data);
 
-                g_string_append_printf(buffer, " %s %s\n", 
-                        webkit_web_history_item_get_uri(item), webkit_web_history_item_get_title(item));
-            }
+            c = dwb_malloc(sizeof(SessionTabCache));
+            *c = state;
+            c->uri = g_strdup(state.uri);
+            c->title = g_strdup(state.title);
+            c->data = g_string_free(data, false);
         }
+        g_hash_table_insert(cache, id, c);
+        g_string_append(buffer, c->data);
     }
+    if (s_tab_cache != NULL) 
+        g_hash_table_unref(s_tab_cache);
+    s_tab_cache = cache;
+
     session_save_file(name, buffer->str, (flags & SESSION_SYNC) != 0);
 
     if (! (flags & SESSION_SYNC))
@@ -29,6 +29,7 @@ gboolean session_save(const char *, int);
 gboolean session_restore(char *, int);
 void session_list(void);
 void session_clear_session(void);
+void session_clear_all(void);
 void session_set_name(const char *);
 const char * session_get_name();
 
@@ -27,6 +27,7 @@
 #include "scripts.h"
 #include "soup.h"
 #include "js.h"
+#include "journal.h"
 #define DWB_SOUP_CHECK_EXPIRATION(multiplier) \
     (s_expiration = (s_expiration != LONG_MIN && s_expiration != LONG_MAX && LONG_MAX / (multiplier) > s_expiration) ? \
         s_expiration * (multiplier) : -1)
@@ -37,6 +38,8 @@ static SoupCookieJar *s_jar;
 static guint s_changed_id;
 static SoupCookieJar *s_tmp_jar;
 static long int s_expiration;
+static Journal *s_journal;
+static SoupSession *s_script_session;
 
 const char *
 dwb_soup_get_host(WebKitWebFrame *frame)
@@ -69,9 +72,9 @@ dwb_soup_clear_jar(SoupCookieJar *jar)
     soup_cookies_free(all_cookies);
 }/*}}}*/
 
-/* dwb_soup_allow_cookie(GList *, const char, CookieStorePolicy) {{{*/
+/* dwb_soup_allow_cookie(DomainIndex *, const char, CookieStorePolicy) {{{*/
 static DwbStatus
-dwb_soup_allow_cookie_simple(GList **whitelist, const char *filename, CookieStorePolicy policy) 
+dwb_soup_allow_cookie_simple(DomainIndex *whitelist, const char *filename, CookieStorePolicy policy) 
 {
     GSList *list = domain_get_cookie_domains(CURRENT_WEBVIEW());
     char *domain;
@@ -82,11 +85,11 @@ dwb_soup_allow_cookie_simple(GList **whitelist, const char *filename, CookieStor
     for (GSList *l = list; l; l=l->next) 
     {
         domain = l->data;
-        if ( *whitelist == NULL || g_list_find_custom(*whitelist, domain, (GCompareFunc) g_strcmp0) == NULL ) 
+        if (domain_index_lookup(whitelist, domain) == 0) 
         {
             if (dwb_confirm(dwb.state.fview, "Allow %s cookies for domain %s [y/n]", policy == COOKIE_ALLOW_PERSISTENT ? "persistent" : "session", domain)) 
             {
-                *whitelist = g_list_append(*whitelist, g_strdup(domain));
+                domain_index_add(whitelist, domain, DOMAIN_INDEX_PERSISTENT);
                 util_file_add(filename, domain, true, -1);
             }
         }
@@ -141,8 +144,7 @@ dwb_soup_allow_cookie_tmp()
     for (GSList *l = last_cookies; l; l=l->next) 
     {
         domain = l->data;
-        if ( g_list_find_custom(dwb.fc.cookies_session_allow, domain, (GCompareFunc)g_strcmp0)  == NULL ) 
-            dwb.fc.cookies_session_allow = g_list_append(dwb.fc.cookies_session_allow, g_strdup(domain));
+        domain_index_add(dwb.fc.cookies_session_allow, domain, DOMAIN_INDEX_TEMPORARY);
     }
 
     dwb_reload(dwb.state.fview);
@@ -152,7 +154,7 @@ dwb_soup_allow_cookie_tmp()
 }
 
 DwbStatus
-dwb_soup_allow_cookie(GList **whitelist, const char *filename, CookieStorePolicy policy) 
+dwb_soup_allow_cookie(DomainIndex *whitelist, const char *filename, CookieStorePolicy policy) 
 {
     DwbStatus ret = STATUS_ERROR;
     int length;
@@ -169,7 +171,7 @@ dwb_soup_allow_cookie(GList **whitelist, const char *filename, CookieStorePolicy
     {
         c = l->data;
         domain = soup_cookie_get_domain(c);
-        if ( *whitelist == NULL || g_list_find_custom(*whitelist, domain, (GCompareFunc) g_strcmp0) == NULL ) 
+        if (domain_index_lookup(whitelist, domain) == 0) 
         {
             /* only ask once, if it was already prompted for this domain and allowed it will be handled
              * in the else clause */
@@ -178,7 +180,7 @@ dwb_soup_allow_cookie(GList **whitelist, const char *filename, CookieStorePolicy
 
             if (dwb_confirm(dwb.state.fview, "Allow %s cookies for domain %s [y/n]", policy == COOKIE_ALLOW_PERSISTENT ? "persistent" : "session", domain)) 
             {
-                *whitelist = g_list_append(*whitelist, g_strdup(domain));
+                domain_index_add(whitelist, domain, DOMAIN_INDEX_PERSISTENT);
                 util_file_add(filename, domain, true, -1);
                 allowed = g_slist_prepend(allowed, soup_cookie_copy(c));
             }
@@ -253,18 +255,13 @@ dwb_soup_save_cookies(GSList *cookies)
     close(fd);
 }/*}}}*/
 
-/* dwb_test_cookie_allowed(const char *)     return:  gboolean{{{*/
+/* dwb_test_cookie_allowed(DomainIndex *, SoupCookie *)     return:  gboolean{{{*/
 static gboolean 
-dwb_soup_test_cookie_allowed(GList *list, SoupCookie *cookie) 
+dwb_soup_test_cookie_allowed(DomainIndex *whitelist, SoupCookie *cookie) 
 {
     g_return_val_if_fail(cookie != NULL, false);
     g_return_val_if_fail(cookie->domain != NULL, false);
-    for (GList *l = list; l; l=l->next) 
-    {
-        if (l->data && soup_cookie_domain_matches(cookie, l->data)) 
-            return true;
-    }
-    return false;
+    return domain_index_match_cookie_domain(whitelist, cookie->domain);
 }/*}}}*/
 
 /* dwb_soup_set_cookie_accept_policy {{{*/
@@ -305,17 +302,103 @@ dwb_soup_get_cookie_store_policy(const char *policy)
         return COOKIE_STORE_SESSION;
 }/*}}}*/
 
+/* dwb_soup_cookie_to_line, dwb_soup_cookie_from_line {{{*/
+/* Cookies are serialized in the same format as the cookies file */
+static char *
+dwb_soup_cookie_to_line(SoupCookie *cookie)
+{
+    return g_strdup_printf("%s%s\t%s\t%s\t%s\t%lu\t%s\t%s", 
+            cookie->http_only ? "#HttpOnly_" : "", 
+            cookie->domain, 
+            *cookie->domain == '.' ? "TRUE" : "FALSE", 
+            cookie->path, 
+            cookie->secure ? "TRUE" : "FALSE", 
+            (gulong)soup_date_to_time_t(cookie->expires), 
+            cookie->name, 
+            cookie->value);
+}
+static SoupCookie *
+dwb_soup_cookie_from_line(const char *line)
+{
+    SoupCookie *cookie = NULL;
+    SoupDate *date;
+    gboolean http_only = false;
+    char **token;
+
+    if (g_str_has_prefix(line, "#HttpOnly_")) 
+    {
+        http_only = true;
+        line += 10;
+    }
+    token = g_strsplit(line, "\t", -1);
+    if (g_strv_length(token) == 7) 
+    {
+        cookie = soup_cookie_new(token[5], token[6], token[0], token[2], -1);
+        date = soup_date_new_from_time_t(strtol(token[4], NULL, 10));
+        soup_cookie_set_expires(cookie, date);
+        soup_cookie_set_secure(cookie, !g_strcmp0(token[3], "TRUE"));
+        soup_cookie_set_http_only(cookie, http_only);
+        soup_date_free(date);
+    }
+    g_strfreev(token);
+    return cookie;
+}/*}}}*/
+
+/* dwb_soup_journal_cookie {{{*/
+/* Shares persistent cookies with other instances, session cookies are never
+ * written to the cookies file, so they aren't shared either */
+static void
+dwb_soup_journal_cookie(char op, SoupCookie *cookie)
+{
+    if (s_journal == NULL || cookie == NULL || cookie->expires == NULL || cookie->domain == NULL)
+        return;
+
+    char *line = dwb_soup_cookie_to_line(cookie);
+    journal_append(s_journal, op, line);
+    g_free(line);
+}/*}}}*/
+
+/* dwb_soup_journal_apply {{{*/
+static void
+dwb_soup_journal_apply(char op, const char *data, gpointer user_data)
+{
+    SoupCookie *cookie;
+
+    g_signal_handler_block(s_jar, s_changed_id);
+    switch (op) 
+    {
+        case JOURNAL_ADD: 
+            if ((cookie = dwb_soup_cookie_from_line(data)) != NULL)
+                soup_cookie_jar_add_cookie(s_jar, cookie);
+            break;
+        case JOURNAL_REMOVE: 
+            if ((cookie = dwb_soup_cookie_from_line(data)) != NULL) 
+            {
+                soup_cookie_jar_delete_cookie(s_jar, cookie);
+                soup_cookie_free(cookie);
+            }
+            break;
+        case JOURNAL_CLEAR:
+            dwb_soup_clear_jar(s_jar);
+            break;
+        default: 
+            break;
+    }
+    g_signal_handler_unblock(s_jar, s_changed_id);
+}/*}}}*/
+
 void
 dwb_soup_cookie_save(SoupCookie *cookie)
 {
     g_signal_handler_block(s_jar, s_changed_id);
     soup_cookie_jar_add_cookie(s_jar, soup_cookie_copy(cookie));
     g_signal_handler_unblock(s_jar, s_changed_id);
-
+    dwb_soup_journal_cookie(JOURNAL_ADD, cookie);
 }
 void
 dwb_soup_cookie_delete(SoupCookie *cookie)
 {
+    dwb_soup_journal_cookie(JOURNAL_REMOVE, cookie);
     g_signal_handler_block(s_jar, s_changed_id);
     soup_cookie_jar_delete_cookie(s_jar, cookie);
     g_signal_handler_unblock(s_jar, s_changed_id);
@@ -395,15 +478,17 @@ dwb_soup_cookie_changed_cb(SoupCookieJar *jar, SoupCookie *old, SoupCookie *new_
 
         if (dwb.state.cookie_store_policy == COOKIE_STORE_PERSISTENT || dwb_soup_test_cookie_allowed(dwb.fc.cookies_allow, new_cookie)) 
         {
-            if (s_expiration <= 0) 
-                return;
             date = soup_cookie_get_expires(new_cookie);
             // session cookie
             if (!date) 
                 return;
-            max_time = soup_date_to_time_t(date) - time(NULL);
-            if (max_time > 0)
-                soup_cookie_set_max_age(new_cookie, MIN(s_expiration, max_time));
+            if (s_expiration > 0) 
+            {
+                max_time = soup_date_to_time_t(date) - time(NULL);
+                if (max_time > 0)
+                    soup_cookie_set_max_age(new_cookie, MIN(s_expiration, max_time));
+            }
+            dwb_soup_journal_cookie(JOURNAL_ADD, new_cookie);
         } 
         else 
         { 
@@ -421,19 +506,14 @@ dwb_soup_cookie_changed_cb(SoupCookieJar *jar, SoupCookie *old, SoupCookie *new_
             }
         }
     }
+    else if (old != NULL)
+        dwb_soup_journal_cookie(JOURNAL_REMOVE, old);
 }/*}}}*/
 
-void
-dwb_soup_sync_cookies() 
+/* dwb_soup_write_cookies {{{*/
+static void
+dwb_soup_write_cookies(gpointer data) 
 {
-    int fd = open(dwb.files[FILES_COOKIES], 0);
-    if (fd == -1)
-    {
-        perror("open");
-        return;
-    }
-
-    flock(fd, LOCK_EX);
     SoupDate *date;
     if ( unlink(dwb.files[FILES_COOKIES]) == -1)
     {
@@ -467,16 +547,56 @@ dwb_soup_sync_cookies()
 
 
     g_object_unref(j);
+}/*}}}*/
 
+/* dwb_soup_sync_cookies(gboolean force) {{{*/
+/* Writes all cookies to the cookies file, if cookies are shared the file is
+ * only rewritten if force is true or the journal has grown too large */
+void
+dwb_soup_sync_cookies(gboolean force) 
+{
+    if (s_journal != NULL) 
+    {
+        journal_compact(s_journal, dwb_soup_write_cookies, force);
+        return;
+    }
+
+    int fd = open(dwb.files[FILES_COOKIES], 0);
+    if (fd == -1)
+    {
+        perror("open");
+        return;
+    }
+
+    flock(fd, LOCK_EX);
+    dwb_soup_write_cookies(NULL);
     flock(fd, LOCK_UN);
     close(fd);
-}
+}/*}}}*/
+
+/* dwb_soup_share_cookies(gboolean share) {{{*/
+void
+dwb_soup_share_cookies(gboolean share) 
+{
+    if (share && s_journal == NULL) 
+        s_journal = journal_new(dwb.files[FILES_COOKIES], dwb_soup_journal_apply, NULL);
+    else if (!share && s_journal != NULL) 
+    {
+        journal_compact(s_journal, dwb_soup_write_cookies, true);
+        journal_free(s_journal);
+        s_journal = NULL;
+    }
+}/*}}}*/
 
 void 
 dwb_soup_clear_cookies() 
 {
     dwb_soup_clear_jar(s_tmp_jar);
+    g_signal_handler_block(s_jar, s_changed_id);
     dwb_soup_clear_jar(s_jar);
+    g_signal_handler_unblock(s_jar, s_changed_id);
+    if (s_journal != NULL)
+        journal_append(s_journal, JOURNAL_CLEAR, NULL);
 }
 
 /* dwb_soup_init_cookies {{{*/
@@ -488,7 +608,7 @@ dwb_soup_init_cookies(SoupSession *s)
     s_jar = soup_cookie_jar_new(); 
     s_tmp_jar = soup_cookie_jar_new();
 
-    dwb_soup_set_cookie_accept_policy(GET_CHAR("cookies-accept-policy"));
+    dwb_soup_set_cookie_accept_policy(GET_CHAR(SETTINGS_COOKIES_ACCEPT_POLICY));
     SoupCookieJar *old_cookies = soup_cookie_jar_text_new(dwb.files[FILES_COOKIES], true);
 
     GSList *l = soup_cookie_jar_all_cookies(old_cookies);
@@ -513,8 +633,8 @@ void
 dwb_soup_init_proxy() 
 {
     const char *proxy;
-    gboolean use_proxy = GET_BOOL("proxy");
-    if ( !(proxy =  g_getenv("http_proxy")) && !(proxy =  GET_CHAR("proxy-url")) )
+    gboolean use_proxy = GET_BOOL(SETTINGS_PROXY);
+    if ( !(proxy =  g_getenv("http_proxy")) && !(proxy =  GET_CHAR(SETTINGS_PROXY_URL)) )
         return;
 
     if (dwb.misc.proxyuri)
@@ -523,6 +643,8 @@ dwb_soup_init_proxy()
     dwb.misc.proxyuri = g_strrstr(proxy, "://") ? g_strdup(proxy) : g_strdup_printf("http://%s", proxy);
     SoupURI *uri = soup_uri_new(dwb.misc.proxyuri);
     g_object_set(dwb.misc.soupsession, "proxy-uri", use_proxy ? uri : NULL, NULL); 
+    if (s_script_session != NULL)
+        g_object_set(s_script_session, "proxy-uri", use_proxy ? uri : NULL, NULL); 
     soup_uri_free(uri);
 }/*}}}*/
 
@@ -566,29 +688,72 @@ dwb_soup_set_cookie_expiration(const char *expiration_string)
 }
 
 /* dwb_soup_init_session_features() {{{*/
-DwbStatus 
-dwb_soup_init_session_features() 
+static void 
+dwb_soup_set_session_features(SoupSession *session) 
 {
 #ifdef WITH_LIBSOUP_2_38
-    gboolean cert = GET_BOOL("ssl-use-system-ca-file");
-    g_object_set(dwb.misc.soupsession, 
+    gboolean cert = GET_BOOL(SETTINGS_SSL_USE_SYSTEM_CA_FILE);
+    g_object_set(session, 
             SOUP_SESSION_SSL_USE_SYSTEM_CA_FILE, cert, NULL);
 #else 
-    char *cert = GET_CHAR("ssl-ca-cert");
+    char *cert = GET_CHAR(SETTINGS_SSL_CA_CERT);
     if (cert != NULL && g_file_test(cert, G_FILE_TEST_EXISTS)) 
     {
-        g_object_set(dwb.misc.soupsession, 
+        g_object_set(session, 
                 SOUP_SESSION_SSL_CA_FILE, cert, NULL);
     }
 #endif
-    g_object_set(dwb.misc.soupsession, SOUP_SESSION_SSL_STRICT, GET_BOOL("ssl-strict"), NULL);
+    g_object_set(session, SOUP_SESSION_SSL_STRICT, GET_BOOL(SETTINGS_SSL_STRICT), NULL);
+}
+DwbStatus 
+dwb_soup_init_session_features() 
+{
+    dwb_soup_set_session_features(dwb.misc.soupsession);
+    if (s_script_session != NULL)
+        dwb_soup_set_session_features(s_script_session);
     return STATUS_OK;
 }/*}}}*/
 
+/* dwb_soup_get_script_session() {{{*/
+/* 
+ * Session used for requests sent by scripts, it shares cookies, proxy and
+ * ssl settings with the webkit session but has its own connection pool so
+ * script requests don't block connections needed by page loads. 
+ * */
+SoupSession * 
+dwb_soup_get_script_session() 
+{
+    SoupURI *proxy = NULL;
+    if (s_script_session == NULL) 
+    {
+        s_script_session = soup_session_async_new_with_options(
+                SOUP_SESSION_MAX_CONNS, SOUP_SCRIPT_MAX_CONNS, 
+                SOUP_SESSION_MAX_CONNS_PER_HOST, SOUP_SCRIPT_MAX_CONNS_PER_HOST, 
+                NULL);
+        g_object_get(dwb.misc.soupsession, "proxy-uri", &proxy, NULL);
+        if (proxy != NULL) 
+        {
+            g_object_set(s_script_session, "proxy-uri", proxy, NULL);
+            soup_uri_free(proxy);
+        }
+        dwb_soup_set_session_features(s_script_session);
+        soup_session_add_feature(s_script_session, SOUP_SESSION_FEATURE(s_jar));
+    }
+    return s_script_session;
+}/*}}}*/
+
 /* dwb_soup_end(() {{{*/
 void
 dwb_soup_end() 
 {
+    journal_free(s_journal);
+    s_journal = NULL;
+    if (s_script_session != NULL) 
+    {
+        soup_session_abort(s_script_session);
+        g_object_unref(s_script_session);
+        s_script_session = NULL;
+    }
     g_object_unref(s_tmp_jar);
     g_object_unref(s_jar);
     g_free(dwb.misc.proxyuri);
@@ -19,12 +19,16 @@
 #ifndef __DWB_SOUP_H__
 #define __DWB_SOUP_H__
 
+#define SOUP_SCRIPT_MAX_CONNS           16
+#define SOUP_SCRIPT_MAX_CONNS_PER_HOST  4
+
 void dwb_soup_clean(void);
-void dwb_soup_sync_cookies();
+void dwb_soup_sync_cookies(gboolean);
+void dwb_soup_share_cookies(gboolean);
 void dwb_soup_allow_cookie_tmp(void);
 GSList * dwb_soup_get_all_cookies(void);
 GSList * dwb_soup_get_cookies(SoupURI *uri, gboolean http_only);
-DwbStatus dwb_soup_allow_cookie(GList **, const char *, CookieStorePolicy);
+DwbStatus dwb_soup_allow_cookie(DomainIndex *, const char *, CookieStorePolicy);
 const char * dwb_soup_get_host_from_request(WebKitNetworkRequest *);
 SoupMessage * dwb_soup_get_message(WebKitWebFrame *);
 SoupMessage * dwb_soup_get_message_from_wv(WebKitWebView *);
@@ -35,6 +39,7 @@ void dwb_soup_save_cookies(GSList *);
 void dwb_soup_init_cookies(SoupSession *);
 void dwb_soup_init_proxy();
 DwbStatus dwb_soup_init_session_features();
+SoupSession * dwb_soup_get_script_session(void);
 void dwb_soup_end();
 void dwb_soup_init();
 void dwb_soup_clear_cookies();
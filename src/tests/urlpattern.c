@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2010-2014 Stefan Bolte <portix@gmx.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <stdlib.h>
+#include "../dwb.h"
+#include "../urlpattern.h"
+
+/* domain.c allocates with dwb_malloc, util.c would pull in all of dwb */
+void *
+dwb_malloc(size_t size) 
+{
+    return g_malloc(size);
+}
+
+/* Returns whether uri matches exactly the ids in expected, terminated by 0 */
+static gboolean
+matches(UrlPatternSet *set, const char *uri, const int *expected) 
+{
+    GArray *ids = url_pattern_set_match(set, uri);
+    guint n = 0;
+    gboolean ret = true;
+
+    for (; expected[n] != 0; n++) 
+    {
+        if (n >= ids->len || g_array_index(ids, int, n) != expected[n])
+            ret = false;
+    }
+    ret = ret && n == ids->len;
+    g_array_free(ids, true);
+    return ret;
+}
+
+static void
+test_empty_host(void) 
+{
+    UrlPatternSet *set = url_pattern_set_new();
+
+    g_assert(url_pattern_set_add(set, 1, "file:///*", URL_PATTERN_INCLUDE | URL_PATTERN_MATCH));
+    g_assert(url_pattern_set_add(set, 2, "*://example.com/*", URL_PATTERN_INCLUDE | URL_PATTERN_MATCH));
+
+    g_assert(matches(set, "file:///home/user/index.html", (int[]) { 1, 0 }));
+    g_assert(matches(set, "http://example.com/", (int[]) { 2, 0 }));
+    g_assert(matches(set, "http://example.org/", (int[]) { 0 }));
+
+    url_pattern_set_remove(set, 1);
+    g_assert(matches(set, "file:///home/user/index.html", (int[]) { 0 }));
+
+    url_pattern_set_free(set);
+}
+
+static void
+test_hosts(void) 
+{
+    UrlPatternSet *set = url_pattern_set_new();
+
+    g_assert(url_pattern_set_add(set, 1, "*://*.example.com/foo*", URL_PATTERN_INCLUDE | URL_PATTERN_MATCH));
+    g_assert(url_pattern_set_add(set, 2, "http://www.example.com/*", URL_PATTERN_INCLUDE));
+    g_assert(url_pattern_set_add(set, 2, "http://www.example.com/private/*", URL_PATTERN_EXCLUDE));
+
+    g_assert(matches(set, "https://www.example.com/foo/bar", (int[]) { 1, 0 }));
+    g_assert(matches(set, "http://www.example.com/foo", (int[]) { 1, 2, 0 }));
+    g_assert(matches(set, "http://www.example.com/private/foo", (int[]) { 0 }));
+    g_assert(matches(set, "http://example.com/foo", (int[]) { 1, 0 }));
+    g_assert(matches(set, "http://example.org/foo", (int[]) { 0 }));
+
+    url_pattern_set_free(set);
+}
+
+int 
+main(int argc, char **argv) 
+{
+    g_test_init(&argc, &argv, NULL);
+    g_test_add_func("/urlpattern/empty-host", test_empty_host);
+    g_test_add_func("/urlpattern/hosts", test_hosts);
+    return g_test_run();
+}
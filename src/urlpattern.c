@@ -0,0 +1,497 @@
+/*
+ * Copyright (c) 2010-2014 Stefan Bolte <portix@gmx.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+#include "dwb.h"
+#include "domain.h"
+#include "urlpattern.h"
+
+/*
+ * A set of url patterns, every pattern belongs to an id, e.g. a userscript.
+ * Supported patterns are 
+ *
+ *  - globs where * matches any sequence, e.g. *://example.com/foo*, a glob
+ *    that contains .tld matches the base domain with any top level domain
+ *  - regular expressions enclosed in slashes, e.g. /^https?:\/\/example/
+ *  - match patterns (URL_PATTERN_MATCH), i.e. <all_urls> or
+ *    <scheme>://<host>/<path> where scheme is *, http, https, file or ftp and
+ *    host is *, *.<domain> or a hostname
+ *
+ * Patterns that are bound to a host are stored in a table of hosts, so only
+ * the patterns of the host of a uri and its parent domains and patterns without
+ * a fixed host are tested.
+ * */
+
+typedef enum {
+    URL_PATTERN_GLOB, 
+    URL_PATTERN_REGEX, 
+    URL_PATTERN_MATCH_PATH, 
+    URL_PATTERN_ALL_URLS, 
+} UrlPatternType;
+
+typedef struct _UrlPattern {
+    int id;
+    guint flags;
+    UrlPatternType type;
+    /* glob or regex contains .tld */
+    gboolean tld;
+    /* match pattern with host *.<domain> */
+    gboolean subdomains;
+    /* scheme of a match pattern, NULL matches http and https */
+    char *scheme;
+    /* host of a match pattern, NULL matches all hosts */
+    char *host;
+    /* the glob or the path of a match pattern */
+    char *pattern;
+    GRegex *regex;
+} UrlPattern;
+
+struct _UrlPatternSet {
+    /* host -> GSList of UrlPattern */
+    GHashTable *hosts;
+    /* patterns that are not bound to a host */
+    GSList *generic;
+    /* id -> GSList of UrlPattern */
+    GHashTable *ids;
+};
+
+typedef struct _UrlParts {
+    char scheme[32];
+    char host[DOMAIN_INDEX_MAX_LENGTH];
+    const char *host_start;
+    const char *host_end;
+    const char *path;
+    const char *path_end;
+} UrlParts;
+
+/* url_pattern_free(UrlPattern *) {{{*/
+static void 
+url_pattern_free(UrlPattern *p) 
+{
+    g_free(p->scheme);
+    g_free(p->host);
+    g_free(p->pattern);
+    if (p->regex != NULL)
+        g_regex_unref(p->regex);
+    g_free(p);
+}/*}}}*/
+
+/* url_pattern_glob(const char *pattern, const char *s, const char *end) {{{*/
+/* Matches s up to end against a glob, * matches any sequence */
+static gboolean
+url_pattern_glob(const char *pattern, const char *s, const char *end) 
+{
+    const char *star = NULL, *next = s;
+    while (s < end) 
+    {
+        if (*pattern == '*') 
+        {
+            star = pattern++;
+            next = s;
+        }
+        else if (*pattern == *s) 
+        {
+            pattern++;
+            s++;
+        }
+        else if (star != NULL) 
+        {
+            pattern = star + 1;
+            s = ++next;
+        }
+        else 
+            return false;
+    }
+    while (*pattern == '*')
+        pattern++;
+    return *pattern == '\0';
+}/*}}}*/
+
+/* url_pattern_parse_uri(const char *, UrlParts *) {{{*/
+static gboolean 
+url_pattern_parse_uri(const char *uri, UrlParts *parts) 
+{
+    const char *colon, *at, *port, *end;
+    size_t len;
+
+    memset(parts, 0, sizeof(UrlParts));
+    if ((colon = strchr(uri, ':')) == NULL || colon == uri || (size_t)(colon - uri) >= sizeof(parts->scheme))
+        return false;
+
+    for (const char *c = uri; c < colon; c++)
+        parts->scheme[c - uri] = g_ascii_tolower(*c);
+
+    if (strncmp(colon, "://", 3)) 
+    {
+        parts->path = parts->path_end = colon + 1;
+        while (*parts->path_end && *parts->path_end != '#')
+            parts->path_end++;
+        return true;
+    }
+
+    parts->host_start = colon + 3;
+    end = parts->host_start + strcspn(parts->host_start, "/?#");
+    if ((at = memchr(parts->host_start, '@', end - parts->host_start)) != NULL)
+        parts->host_start = at + 1;
+    port = memchr(parts->host_start, ':', end - parts->host_start);
+    parts->host_end = port != NULL && *parts->host_start != '[' ? port : end;
+
+    len = MIN((size_t)(parts->host_end - parts->host_start), sizeof(parts->host) - 1);
+    for (size_t i=0; i<len; i++)
+        parts->host[i] = g_ascii_tolower(parts->host_start[i]);
+
+    parts->path = parts->path_end = end;
+    while (*parts->path_end && *parts->path_end != '#')
+        parts->path_end++;
+    return true;
+}/*}}}*/
+
+/* url_pattern_tld_uri(const char *, UrlParts *) {{{*/
+/* Replaces the top level domain of a uri with .tld, e.g.
+ * http://www.example.co.uk/ with http://www.example.tld/ */
+static char *
+url_pattern_tld_uri(const char *uri, UrlParts *parts) 
+{
+    const char *base, *dot;
+    if (*parts->host == '\0' || (base = domain_get_base_for_host(parts->host)) == NULL)
+        return NULL;
+    if ((dot = strchr(base, '.')) == NULL)
+        return NULL;
+
+    size_t offset = strlen(parts->host) - strlen(base);
+    return g_strdup_printf("%.*s%.*s.tld%s", 
+            (int)(parts->host_start - uri + offset), uri, 
+            (int)(dot - base), base, 
+            parts->host_end);
+}/*}}}*/
+
+/* url_pattern_matches(UrlPattern *, const char *, UrlParts *, char **) {{{*/
+static gboolean
+url_pattern_matches(UrlPattern *p, const char *uri, UrlParts *parts, char **tld_uri) 
+{
+    if (p->tld) 
+    {
+        if (*tld_uri == NULL)
+            *tld_uri = url_pattern_tld_uri(uri, parts);
+        if (*tld_uri != NULL)
+            uri = *tld_uri;
+    }
+    switch (p->type) 
+    {
+        case URL_PATTERN_GLOB: 
+            return url_pattern_glob(p->pattern, uri, uri + strlen(uri));
+        case URL_PATTERN_REGEX: 
+            return g_regex_match(p->regex, uri, 0, NULL);
+        case URL_PATTERN_ALL_URLS: 
+            return !strcmp(parts->scheme, "http") || !strcmp(parts->scheme, "https") 
+                || !strcmp(parts->scheme, "file") || !strcmp(parts->scheme, "ftp");
+        case URL_PATTERN_MATCH_PATH: 
+            if (p->scheme == NULL ? strcmp(parts->scheme, "http") && strcmp(parts->scheme, "https") : strcmp(parts->scheme, p->scheme))
+                return false;
+            if (p->host != NULL && strcmp(parts->host, p->host)) 
+            {
+                size_t hl = strlen(parts->host), pl = strlen(p->host);
+                if (!p->subdomains || hl <= pl || parts->host[hl - pl - 1] != '.' || strcmp(parts->host + hl - pl, p->host))
+                    return false;
+            }
+            return url_pattern_glob(p->pattern, *parts->path ? parts->path : "/", *parts->path ? parts->path_end : parts->path + 1);
+    }
+    return false;
+}/*}}}*/
+
+/* url_pattern_parse_match(UrlPattern *, const char *) {{{*/
+static gboolean 
+url_pattern_parse_match(UrlPattern *p, const char *pattern) 
+{
+    const char *sep, *host, *path;
+
+    if (!strcmp(pattern, "<all_urls>")) 
+    {
+        p->type = URL_PATTERN_ALL_URLS;
+        return true;
+    }
+    if ((sep = strstr(pattern, "://")) == NULL)
+        return false;
+
+    p->type = URL_PATTERN_MATCH_PATH;
+    if (sep - pattern != 1 || *pattern != '*') 
+    {
+        p->scheme = g_ascii_strdown(pattern, sep - pattern);
+        if (strcmp(p->scheme, "http") && strcmp(p->scheme, "https") && strcmp(p->scheme, "file") && strcmp(p->scheme, "ftp"))
+            return false;
+    }
+
+    host = sep + 3;
+    if ((path = strchr(host, '/')) == NULL)
+        return false;
+
+    if (path - host == 1 && *host == '*') 
+        p->host = NULL;
+    else 
+    {
+        if (g_str_has_prefix(host, "*.")) 
+        {
+            p->subdomains = true;
+            host += 2;
+        }
+        if (memchr(host, '*', path - host) != NULL)
+            return false;
+        p->host = g_ascii_strdown(host, path - host);
+    }
+    p->pattern = g_strdup(path);
+    return true;
+}/*}}}*/
+
+/* url_pattern_glob_host(const char *) {{{*/
+/* Returns the fixed host of a glob or NULL */
+static char *
+url_pattern_glob_host(const char *pattern) 
+{
+    const char *sep = strstr(pattern, "://"), *host, *end;
+    if (sep == NULL || memchr(pattern, '*', sep - pattern) != NULL)
+        return NULL;
+
+    host = sep + 3;
+    end = host + strcspn(host, "/:?#*@");
+    if (*end == '*' || *end == '@' || end == host)
+        return NULL;
+    return g_ascii_strdown(host, end - host);
+}/*}}}*/
+
+/* url_pattern_get_host(UrlPattern *) {{{*/
+/* 
+ * Returns the key of a pattern in the host table or NULL if the pattern is
+ * generic, patterns with an empty host, e.g. file:///*, are generic since
+ * uris without a host are only tested against generic patterns
+ * */
+static char *
+url_pattern_get_host(UrlPattern *p) 
+{
+    if (p->type == URL_PATTERN_MATCH_PATH)
+        return p->host != NULL && *p->host != '\0' ? g_strdup(p->host) : NULL;
+    if (p->type == URL_PATTERN_GLOB && !p->tld)
+        return url_pattern_glob_host(p->pattern);
+    return NULL;
+}/*}}}*/
+
+/* url_pattern_set_add(UrlPatternSet *, int, const char *, guint) {{{*/
+/* 
+ * Adds a pattern for id, flags is either URL_PATTERN_INCLUDE or
+ * URL_PATTERN_EXCLUDE, combined with URL_PATTERN_MATCH for match patterns.
+ * Returns false if the pattern is invalid.
+ * */
+gboolean
+url_pattern_set_add(UrlPatternSet *set, int id, const char *pattern, guint flags) 
+{
+    g_return_val_if_fail(set != NULL, false);
+    g_return_val_if_fail(pattern != NULL, false);
+
+    UrlPattern *p = g_malloc0(sizeof(UrlPattern));
+    size_t len = strlen(pattern);
+    char *host;
+    GSList *list;
+
+    p->id = id;
+    p->flags = flags;
+
+    if (flags & URL_PATTERN_MATCH) 
+    {
+        if (!url_pattern_parse_match(p, pattern)) 
+        {
+            url_pattern_free(p);
+            return false;
+        }
+    }
+    else 
+    {
+        p->tld = strstr(pattern, ".tld") != NULL;
+        if (len > 2 && *pattern == '/' && pattern[len-1] == '/') 
+        {
+            char *regex = g_strndup(pattern + 1, len - 2);
+            p->type = URL_PATTERN_REGEX;
+            p->regex = g_regex_new(regex, G_REGEX_OPTIMIZE, 0, NULL);
+            g_free(regex);
+            if (p->regex == NULL) 
+            {
+                url_pattern_free(p);
+                return false;
+            }
+        }
+        else 
+        {
+            p->type = URL_PATTERN_GLOB;
+            p->pattern = g_strdup(pattern);
+        }
+    }
+
+    if ((host = url_pattern_get_host(p)) != NULL) 
+    {
+        list = g_hash_table_lookup(set->hosts, host);
+        if (list == NULL)
+            g_hash_table_insert(set->hosts, host, g_slist_prepend(NULL, p));
+        else 
+        {
+            list = g_slist_append(list, p);
+            g_free(host);
+        }
+    }
+    else 
+        set->generic = g_slist_append(set->generic, p);
+
+    list = g_hash_table_lookup(set->ids, GINT_TO_POINTER(id));
+    g_hash_table_insert(set->ids, GINT_TO_POINTER(id), g_slist_prepend(list, p));
+    return true;
+}/*}}}*/
+
+/* url_pattern_set_remove(UrlPatternSet *, int) {{{*/
+void
+url_pattern_set_remove(UrlPatternSet *set, int id) 
+{
+    g_return_if_fail(set != NULL);
+
+    GSList *patterns = g_hash_table_lookup(set->ids, GINT_TO_POINTER(id)), *list;
+    for (GSList *l = patterns; l; l=l->next) 
+    {
+        UrlPattern *p = l->data;
+        char *host = url_pattern_get_host(p);
+        if (host != NULL) 
+        {
+            GSList *old = g_hash_table_lookup(set->hosts, host);
+            list = g_slist_remove(old, p);
+            if (list == NULL)
+                g_hash_table_remove(set->hosts, host);
+            else if (list != old)
+                g_hash_table_replace(set->hosts, g_strdup(host), list);
+            g_free(host);
+        }
+        else 
+            set->generic = g_slist_remove(set->generic, p);
+        url_pattern_free(p);
+    }
+    g_slist_free(patterns);
+    g_hash_table_remove(set->ids, GINT_TO_POINTER(id));
+}/*}}}*/
+
+/* url_pattern_set_test(GSList *, ...) {{{*/
+static void
+url_pattern_set_test(GSList *patterns, gboolean parent, const char *uri, UrlParts *parts, char **tld_uri, GHashTable *included, GHashTable *excluded)
+{
+    for (GSList *l = patterns; l; l=l->next) 
+    {
+        UrlPattern *p = l->data;
+        GHashTable *table = p->flags & URL_PATTERN_EXCLUDE ? excluded : included;
+
+        if (parent && !p->subdomains)
+            continue;
+        if (g_hash_table_contains(table, GINT_TO_POINTER(p->id)) || g_hash_table_contains(excluded, GINT_TO_POINTER(p->id)))
+            continue;
+        if (url_pattern_matches(p, uri, parts, tld_uri))
+            g_hash_table_add(table, GINT_TO_POINTER(p->id));
+    }
+}/*}}}*/
+
+static gint
+url_pattern_compare_id(gconstpointer a, gconstpointer b) 
+{
+    return *(const int *)a - *(const int *)b;
+}
+
+/* url_pattern_set_match(UrlPatternSet *, const char *) {{{*/
+/* 
+ * Returns the ids that have a matching include or match pattern and no
+ * matching exclude pattern, sorted in ascending order
+ * */
+GArray *
+url_pattern_set_match(UrlPatternSet *set, const char *uri) 
+{
+    g_return_val_if_fail(set != NULL, NULL);
+
+    GArray *ret = g_array_new(false, false, sizeof(int));
+    GHashTable *included, *excluded;
+    GHashTableIter iter;
+    gpointer key;
+    UrlParts parts;
+    char *tld_uri = NULL;
+
+    if (uri == NULL || !url_pattern_parse_uri(uri, &parts))
+        return ret;
+
+    included = g_hash_table_new(NULL, NULL);
+    excluded = g_hash_table_new(NULL, NULL);
+
+    if (*parts.host != '\0') 
+    {
+        const char *host = parts.host;
+        url_pattern_set_test(g_hash_table_lookup(set->hosts, host), false, uri, &parts, &tld_uri, included, excluded);
+        while ((host = strchr(host, '.')) != NULL) 
+        {
+            host++;
+            url_pattern_set_test(g_hash_table_lookup(set->hosts, host), true, uri, &parts, &tld_uri, included, excluded);
+        }
+    }
+    url_pattern_set_test(set->generic, false, uri, &parts, &tld_uri, included, excluded);
+
+    g_hash_table_iter_init(&iter, included);
+    while (g_hash_table_iter_next(&iter, &key, NULL)) 
+    {
+        int id = GPOINTER_TO_INT(key);
+        if (!g_hash_table_contains(excluded, key))
+            g_array_append_val(ret, id);
+    }
+    g_array_sort(ret, url_pattern_compare_id);
+
+    g_hash_table_unref(included);
+    g_hash_table_unref(excluded);
+    g_free(tld_uri);
+    return ret;
+}/*}}}*/
+
+/* url_pattern_set_new() {{{*/
+UrlPatternSet *
+url_pattern_set_new() 
+{
+    UrlPatternSet *set = g_malloc(sizeof(UrlPatternSet));
+    set->hosts = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+    set->generic = NULL;
+    set->ids = g_hash_table_new(NULL, NULL);
+    return set;
+}/*}}}*/
+
+/* url_pattern_set_free(UrlPatternSet *) {{{*/
+void
+url_pattern_set_free(UrlPatternSet *set) 
+{
+    GHashTableIter iter;
+    gpointer value;
+
+    if (set == NULL)
+        return;
+
+    g_hash_table_iter_init(&iter, set->hosts);
+    while (g_hash_table_iter_next(&iter, NULL, &value)) 
+        g_slist_free(value);
+
+    g_hash_table_iter_init(&iter, set->ids);
+    while (g_hash_table_iter_next(&iter, NULL, &value)) 
+        g_slist_free_full(value, (GDestroyNotify)url_pattern_free);
+
+    g_hash_table_unref(set->ids);
+    g_hash_table_unref(set->hosts);
+    g_slist_free(set->generic);
+    g_free(set);
+}/*}}}*/
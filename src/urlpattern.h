@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2010-2014 Stefan Bolte <portix@gmx.net>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __DWB_URL_PATTERN_H__
+#define __DWB_URL_PATTERN_H__
+
+typedef struct _UrlPatternSet UrlPatternSet;
+
+enum {
+    URL_PATTERN_INCLUDE = 1<<0,
+    URL_PATTERN_EXCLUDE = 1<<1,
+    URL_PATTERN_MATCH   = 1<<2,
+};
+
+UrlPatternSet * url_pattern_set_new(void);
+void url_pattern_set_free(UrlPatternSet *);
+gboolean url_pattern_set_add(UrlPatternSet *, int id, const char *pattern, guint flags);
+void url_pattern_set_remove(UrlPatternSet *, int id);
+GArray * url_pattern_set_match(UrlPatternSet *, const char *uri);
+#endif
@@ -33,10 +33,15 @@
 #include "js.h"
 #include "scripts.h"
 #include "dom.h"
+#include "domain.h"
 #include "ipc.h"
 #include "entry.h"
+#include "requestpolicy.h"
 
 static void view_ssl_state(GList *);
+static GList * view_add_tab(const char *, gboolean, gboolean, int);
+/* Ids are never reused, unlike the address of a View */
+static guint s_view_id;
 static unsigned long s_click_time;
 static guint s_sig_caret_button_release;
 static guint s_sig_caret_motion;
@@ -80,6 +85,9 @@ view_main_frame_committed_cb(WebKitWebFrame *frame, GList *gl) {
 static void 
 view_resource_request_cb(WebKitWebView *wv, WebKitWebFrame *frame, WebKitWebResource *resource, WebKitNetworkRequest *request, WebKitNetworkResponse *response, GList *gl) 
 {
+    if (request_policy_check(gl, request))
+        return;
+
     if (EMIT_SCRIPT(RESOURCE))  
     {
         /**
@@ -150,7 +158,7 @@ view_document_finished(WebKitWebView *wv, WebKitWebFrame *frame, GList *gl)
         ScriptSignal signal = { SCRIPTS_WV(gl), { G_OBJECT(frame) }, SCRIPTS_SIG_META(NULL, DOCUMENT_LOADED, 1) };
         scripts_emit(&signal);
     }
-    IPC_SEND_HOOK(document_finished, "%d %s", g_list_position(dwb.state.views, gl) + 1, 
+    IPC_SEND_HOOK(document_finished, "%d %s", dwb_tab_index(gl) + 1, 
             webkit_web_view_get_main_frame(wv) ? "true" : "false");
 }
 #endif
@@ -253,14 +261,13 @@ view_button_press_cb(WebKitWebView *web, GdkEventButton *e, GList *gl)
          * @returns {Boolean}
          *      Return true to prevent the default action
          * */
-        char *json = util_create_json(8, 
-                UINTEGER, "time", e->time, UINTEGER,    "type", e->type, 
-                DOUBLE,   "x", e->x, DOUBLE,            "y", e->y, 
-                UINTEGER, "state", e->state, UINTEGER,  "button", e->button, 
-                DOUBLE,   "xRoot", e->x_root, DOUBLE,   "yRoot", e->y_root);
-        ScriptSignal signal = { SCRIPTS_WV(gl), { G_OBJECT(result) }, SCRIPTS_SIG_META(json, BUTTON_PRESS, 1) };
+        JSObjectRef payload = scripts_create_payload(8, 
+                UINTEGER, JS_PROP_TIME, e->time, UINTEGER,    JS_PROP_TYPE, e->type, 
+                DOUBLE,   JS_PROP_X, e->x, DOUBLE,            JS_PROP_Y, e->y, 
+                UINTEGER, JS_PROP_STATE, e->state, UINTEGER,  JS_PROP_BUTTON, e->button, 
+                DOUBLE,   JS_PROP_X_ROOT, e->x_root, DOUBLE,   JS_PROP_Y_ROOT, e->y_root);
+        ScriptSignal signal = { SCRIPTS_WV(gl), { G_OBJECT(result) }, SCRIPTS_SIG_PAYLOAD(payload, BUTTON_PRESS, 1) };
         ret = scripts_emit(&signal);
-        g_free(json);
         if (ret) 
             goto clean;
     }
@@ -375,14 +382,13 @@ view_button_release_cb(WebKitWebView *web, GdkEventButton *e, GList *gl)
          * @returns {Boolean}
          *      Return true to prevent the default action
          * */
-        char *json = util_create_json(7, 
-                UINTEGER, "time", e->time, 
-                DOUBLE,   "x", e->x, DOUBLE,            "y", e->y, 
-                UINTEGER, "state", e->state, UINTEGER,  "button", e->button, 
-                DOUBLE,   "xRoot", e->x_root, DOUBLE,   "yRoot", e->y_root);
-        ScriptSignal signal = { SCRIPTS_WV(gl), { G_OBJECT(result) }, SCRIPTS_SIG_META(json, BUTTON_RELEASE, 1) };
+        JSObjectRef payload = scripts_create_payload(7, 
+                UINTEGER, JS_PROP_TIME, e->time, 
+                DOUBLE,   JS_PROP_X, e->x, DOUBLE,            JS_PROP_Y, e->y, 
+                UINTEGER, JS_PROP_STATE, e->state, UINTEGER,  JS_PROP_BUTTON, e->button, 
+                DOUBLE,   JS_PROP_X_ROOT, e->x_root, DOUBLE,   JS_PROP_Y_ROOT, e->y_root);
+        ScriptSignal signal = { SCRIPTS_WV(gl), { G_OBJECT(result) }, SCRIPTS_SIG_PAYLOAD(payload, BUTTON_RELEASE, 1) };
         ret = scripts_emit(&signal);
-        g_free(json);
         if (ret) 
             goto clean;
     }
@@ -600,10 +606,10 @@ view_inspect_web_view_cb(WebKitWebInspector *inspector, WebKitWebView *wv, GList
 
     GtkWidget *webview = webkit_web_view_new();
     WebKitWebSettings *settings = webkit_web_view_get_settings(WEBKIT_WEB_VIEW(webview));
-    g_object_set(settings, "user-stylesheet-uri", GET_CHAR("user-stylesheet-uri"), NULL);
+    g_object_set(settings, "user-stylesheet-uri", GET_CHAR(SETTINGS_USER_STYLESHEET_URI), NULL);
     gtk_window_set_title(GTK_WINDOW(window), "dwb-web-inspector");
 
-    gtk_window_set_default_size(GTK_WINDOW(window), GET_INT("default-width"), GET_INT("default-height"));
+    gtk_window_set_default_size(GTK_WINDOW(window), GET_INT(SETTINGS_DEFAULT_WIDTH), GET_INT(SETTINGS_DEFAULT_HEIGHT));
     gtk_window_set_geometry_hints(GTK_WINDOW(window), NULL, NULL, GDK_HINT_MIN_SIZE);
 
     gtk_container_add(GTK_CONTAINER(window), webview);
@@ -621,7 +627,7 @@ view_hovering_over_link_cb(WebKitWebView *web, char *title, char *uri, GList *gl
     if (uri) 
     {
         VIEW(gl)->status->hover_uri = g_strdup(uri);
-        dwb_set_status_bar_text(dwb.gui.urilabel, uri, &dwb.color.active_fg, NULL, false);
+        dwb_set_uri_label(uri, &dwb.color.active_fg);
     }
     else 
     {
@@ -704,7 +710,7 @@ view_navigation_policy_cb(WebKitWebView *web, WebKitWebFrame *frame, WebKitNetwo
     gint button = webkit_web_navigation_action_get_button(action);
     VIEW(gl)->status->reason = reason;
 
-    IPC_SEND_HOOK(navigation, "%d %s %s", g_list_position(dwb.state.views, gl) + 1, 
+    IPC_SEND_HOOK(navigation, "%d %s %s", dwb_tab_index(gl) + 1, 
                             frame == webkit_web_view_get_main_frame(web) ? "true" : "false", 
                             uri);
 
@@ -863,7 +869,7 @@ view_navigation_policy_cb(WebKitWebView *web, WebKitWebFrame *frame, WebKitNetwo
             if (dwb.state.mode == SEARCH_FIELD_MODE) 
             {
                 webkit_web_policy_decision_ignore(policy);
-                char *hint_search_submit = GET_CHAR("searchengine-submit-pattern");
+                char *hint_search_submit = GET_CHAR(SETTINGS_SEARCHENGINE_SUBMIT_PATTERN);
                 if (hint_search_submit == NULL) 
                     hint_search_submit = HINT_SEARCH_SUBMIT;
                 
@@ -985,16 +991,17 @@ view_scroll_cb(GtkWidget *w, GdkEventScroll *e, GList *gl)
             case GDK_SCROLL_RIGHT : direction = "right"; break;
             default : direction = ""; break;
         }
-        char *json = util_create_json(7, 
-                CHAR, "direction", direction,
-                DOUBLE,   "x", e->x, DOUBLE, "y", e->y, 
-                UINTEGER, "state", e->state, UINTEGER, "time", e->time, 
-                DOUBLE,   "xRoot", e->x_root, DOUBLE,   "yRoot", e->y_root);
-        ScriptSignal signal = { SCRIPTS_WV(gl), SCRIPTS_SIG_META(json, SCROLL, 0) };
-        SCRIPTS_EMIT_RETURN(signal, json, true);
+        JSObjectRef payload = scripts_create_payload(7, 
+                CHAR, JS_PROP_DIRECTION, direction,
+                DOUBLE,   JS_PROP_X, e->x, DOUBLE, JS_PROP_Y, e->y, 
+                UINTEGER, JS_PROP_STATE, e->state, UINTEGER, JS_PROP_TIME, e->time, 
+                DOUBLE,   JS_PROP_X_ROOT, e->x_root, DOUBLE,   JS_PROP_Y_ROOT, e->y_root);
+        ScriptSignal signal = { SCRIPTS_WV(gl), SCRIPTS_SIG_PAYLOAD(payload, SCROLL, 0) };
+        if (scripts_emit(&signal))
+            return true;
     }
-    dwb_update_status_text(gl, NULL);
-    if (GET_BOOL("enable-frame-flattening")) 
+    dwb_queue_status_update(gl, STATUS_UPDATE_TEXT);
+    if (GET_BOOL(SETTINGS_ENABLE_FRAME_FLATTENING)) 
     {
         Arg a = { .n = e->direction };
         commands_scroll(NULL, &a);
@@ -1009,21 +1016,21 @@ view_scroll_tab_cb(GtkWidget *w, GdkEventScroll *e, GList *gl)
 {
     const char *event;
     int pos = -1;
-    if (GET_BOOL("mouse-cycles-through-tabs")) 
+    if (GET_BOOL(SETTINGS_MOUSE_CYCLES_THROUGH_TABS)) 
     {
         if (e->direction == GDK_SCROLL_DOWN)
         {
-            pos = util_modulo(g_list_position(dwb.state.views, dwb.state.fview) + 1, g_list_length(dwb.state.views));
+            pos = util_modulo(dwb_tab_index(dwb.state.fview) + 1, dwb_tab_count());
             event = "focus_next";
         }
         else if (e->direction == GDK_SCROLL_UP)
         {
-            pos = util_modulo(g_list_position(dwb.state.views, dwb.state.fview) - 1, g_list_length(dwb.state.views));
+            pos = util_modulo(dwb_tab_index(dwb.state.fview) - 1, dwb_tab_count());
             event = "focus_prev";
         }
         if (pos != -1)
         {
-            dwb_focus_view(g_list_nth(dwb.state.views, pos), event);
+            dwb_focus_view(dwb_tab_nth(pos), event);
         }
     }
     return false;
@@ -1033,7 +1040,7 @@ view_scroll_tab_cb(GtkWidget *w, GdkEventScroll *e, GList *gl)
 static gboolean
 view_value_changed_cb(GtkAdjustment *a, GList *gl) 
 {
-    dwb_update_status_text(gl, a);
+    dwb_queue_status_update(gl, STATUS_UPDATE_TEXT);
     return false;
 }/* }}} */
 #if WEBKIT_CHECK_VERSION(1, 10, 0)
@@ -1061,7 +1068,7 @@ view_icon_loaded(WebKitWebView *web, char *icon_uri, GList *gl)
 static void 
 view_title_cb(WebKitWebView *web, GParamSpec *pspec, GList *gl) 
 {
-    dwb_update_status(gl, NULL);
+    dwb_queue_status_update(gl, STATUS_UPDATE_ALL);
 }/*}}}*/
 
 /* view_title_cb {{{*/
@@ -1080,7 +1087,7 @@ view_progress_cb(WebKitWebView *web, GParamSpec *pspec, GList *gl)
     if (v->status->progress == 100) 
         v->status->progress = 0;
     
-    dwb_update_status(gl, NULL);
+    dwb_queue_status_update(gl, STATUS_UPDATE_ALL);
 }/*}}}*/
 
 /* view_popup_activate_cb {{{*/
@@ -1202,8 +1209,7 @@ view_load_status_cb(WebKitWebView *web, GParamSpec *pspec, GList *gl)
                 plugins_connect(gl);
             if (VIEW(gl)->status->scripts & SCRIPTS_BLOCKED 
                     && (((host = dwb_get_host(web)) 
-                            && (g_list_find_custom(dwb.fc.pers_scripts, host, (GCompareFunc)g_strcmp0) || g_list_find_custom(dwb.fc.pers_scripts, uri, (GCompareFunc)g_strcmp0) 
-                                || g_list_find_custom(dwb.fc.tmp_scripts, host, (GCompareFunc)g_strcmp0) || g_list_find_custom(dwb.fc.tmp_scripts, uri, (GCompareFunc)g_strcmp0)))
+                            && (domain_index_match_host(dwb.fc.scripts_allow, host) || domain_index_lookup(dwb.fc.scripts_allow, uri)))
                         ||  g_str_has_prefix(uri, "dwb:") || !g_strcmp0(uri, "Error"))) 
             {
                 g_object_set(webkit_web_view_get_settings(web), "enable-scripts", true, NULL);
@@ -1211,13 +1217,12 @@ view_load_status_cb(WebKitWebView *web, GParamSpec *pspec, GList *gl)
             }
             if (v->plugins->status & PLUGIN_STATUS_ENABLED 
                     && ( (host != NULL || (host = dwb_get_host(web))) 
-                        && (g_list_find_custom(dwb.fc.pers_plugins, host, (GCompareFunc)g_strcmp0) || g_list_find_custom(dwb.fc.pers_plugins, uri, (GCompareFunc)g_strcmp0)
-                            || g_list_find_custom(dwb.fc.tmp_plugins, host, (GCompareFunc)g_strcmp0) || g_list_find_custom(dwb.fc.tmp_plugins, uri, (GCompareFunc)g_strcmp0) )
+                        && (domain_index_match_host(dwb.fc.plugins_allow, host) || domain_index_lookup(dwb.fc.plugins_allow, uri))
                        )) 
             {
                 plugins_disconnect(gl);
             }
-            IPC_SEND_HOOK(load_committed, "%d %s", g_list_position(dwb.state.views, dwb.state.fview) + 1, uri);
+            IPC_SEND_HOOK(load_committed, "%d %s", dwb_tab_index(dwb.state.fview) + 1, uri);
             /**
              * Emitted when the load has just been commited, no data has been loaded
              * when this signal is emitted. This is the preferred signal for
@@ -1248,15 +1253,14 @@ view_load_status_cb(WebKitWebView *web, GParamSpec *pspec, GList *gl)
             if (!dwb.misc.private_browsing 
                     && g_strcmp0(uri, "about:blank")
                     && !g_str_has_prefix(uri, "dwb:") 
-                    && (dwb_prepend_navigation(gl, &dwb.fc.history) == STATUS_OK)
-                    && dwb.misc.sync_interval <= 0) 
+                    && (dwb_prepend_navigation(gl, &dwb.fc.history) == STATUS_OK)) 
             {
-                util_file_add_navigation(dwb.files[FILES_HISTORY], dwb.fc.history->data, false, dwb.misc.history_length);
+                dwb_history_add_item(dwb.fc.history->data);
             }
             if (dwb.state.auto_insert_mode) 
                 dwb_check_auto_insert(gl);
 
-            IPC_SEND_HOOK(load_finished, "%d %s", g_list_position(dwb.state.views, dwb.state.fview) + 1, uri);
+            IPC_SEND_HOOK(load_finished, "%d %s", dwb_tab_index(dwb.state.fview) + 1, uri);
             /**
              * Emitted when the site has completely loaded.
              *
@@ -1416,13 +1420,14 @@ view_motion_notify_cb(WebKitWebView *web, GdkEventButton *e, GList *gl)
          * @returns {Boolean}
          *      Return true to prevent the movement
          * */
-        char *json = util_create_json(7, 
-                UINTEGER, "time", e->time, 
-                DOUBLE,   "x", e->x, DOUBLE,            "y", e->y, 
-                UINTEGER, "state", e->state, UINTEGER,  "button", e->button, 
-                DOUBLE,   "xRoot", e->x_root, DOUBLE,   "yRoot", e->y_root);
-        ScriptSignal signal = { SCRIPTS_WV(gl), SCRIPTS_SIG_META(json, MOUSE_MOVE, 0) };
-        SCRIPTS_EMIT_RETURN(signal, json, true);
+        JSObjectRef payload = scripts_create_payload(7, 
+                UINTEGER, JS_PROP_TIME, e->time, 
+                DOUBLE,   JS_PROP_X, e->x, DOUBLE,            JS_PROP_Y, e->y, 
+                UINTEGER, JS_PROP_STATE, e->state, UINTEGER,  JS_PROP_BUTTON, e->button, 
+                DOUBLE,   JS_PROP_X_ROOT, e->x_root, DOUBLE,   JS_PROP_Y_ROOT, e->y_root);
+        ScriptSignal signal = { SCRIPTS_WV(gl), SCRIPTS_SIG_PAYLOAD(payload, MOUSE_MOVE, 0) };
+        if (scripts_emit(&signal))
+            return true;
     }
     return false;
 }
@@ -1474,13 +1479,14 @@ view_tab_button_press_cb(GtkWidget *tabevent, GdkEventButton *e, GList *gl)
          * @returns {Boolean}
          *      Return true to prevent the default action
          * */
-        char *json = util_create_json(8, 
-                UINTEGER, "time", e->time, UINTEGER,    "type", e->type, 
-                DOUBLE,   "x", e->x, DOUBLE,            "y", e->y, 
-                UINTEGER, "state", e->state, UINTEGER,  "button", e->button, 
-                DOUBLE,   "xRoot", e->x_root, DOUBLE,   "yRoot", e->y_root);
-        ScriptSignal signal = { SCRIPTS_WV(gl), { G_OBJECT(tabevent) }, SCRIPTS_SIG_META(json, TAB_BUTTON_PRESS, 1) };
-        SCRIPTS_EMIT_RETURN(signal, json, true);
+        JSObjectRef payload = scripts_create_payload(8, 
+                UINTEGER, JS_PROP_TIME, e->time, UINTEGER,    JS_PROP_TYPE, e->type, 
+                DOUBLE,   JS_PROP_X, e->x, DOUBLE,            JS_PROP_Y, e->y, 
+                UINTEGER, JS_PROP_STATE, e->state, UINTEGER,  JS_PROP_BUTTON, e->button, 
+                DOUBLE,   JS_PROP_X_ROOT, e->x_root, DOUBLE,   JS_PROP_Y_ROOT, e->y_root);
+        ScriptSignal signal = { SCRIPTS_WV(gl), { G_OBJECT(tabevent) }, SCRIPTS_SIG_PAYLOAD(payload, TAB_BUTTON_PRESS, 1) };
+        if (scripts_emit(&signal))
+            return true;
     }
     if (e->button == 1 && e->type == GDK_BUTTON_PRESS) 
     {
@@ -1538,7 +1544,7 @@ view_set_active_style(GList *gl)
 void 
 view_set_normal_style(GList *gl) 
 {
-    if (g_list_position(dwb.state.views, gl) % 2 == 0)
+    if (dwb_tab_index(gl) % 2 == 0)
         view_modify_style(gl, &dwb.color.tab_normal_fg1, &dwb.color.tab_normal_bg1, dwb.font.fd_inactive);
     else
         view_modify_style(gl, &dwb.color.tab_normal_fg2, &dwb.color.tab_normal_bg2, dwb.font.fd_inactive);
@@ -1549,17 +1555,15 @@ static void
 view_init_settings(GList *gl) 
 {
     View *v = gl->data;
-    v->settings = webkit_web_settings_copy(dwb.state.web_settings);
+    if (v->settings == NULL)
+        v->settings = webkit_web_settings_copy(dwb.state.web_settings);
     webkit_web_view_set_settings(WEBKIT_WEB_VIEW(v->web), v->settings);
-    GList *l;
-    for (l = g_hash_table_get_values(dwb.settings); l; l=l->next) 
+    for (int i=SETTINGS_FIRST; i<SETTINGS_LAST; i++) 
     {
-        WebSettings *s = l->data;
+        WebSettings *s = dwb.settings_table[i];
         if (s->apply & SETTING_PER_VIEW && s->func != NULL) 
             s->func(gl, s);
     }
-    if (l != NULL) 
-        g_list_free(l);
 }/*}}}*/
 
 static gboolean
@@ -1614,12 +1618,23 @@ view_key_ignore_cb(WebKitWebView *wv, GdkEventKey *e, GList *gl)
     return !(dwb.state.mode & INSERT_MODE);
 }
 
+/* view_init_tab_signals(GList *) {{{*/
+/* Signals of the widgets that are kept when the webview is replaced */
+static void
+view_init_tab_signals(GList *gl) 
+{
+    View *v = gl->data;
+    GtkAdjustment *a = gtk_scrolled_window_get_vadjustment(GTK_SCROLLED_WINDOW(v->scroll));
+    v->status->signals[SIG_SCROLL_TAB]            = g_signal_connect(v->tabevent, "scroll-event",                          G_CALLBACK(view_scroll_tab_cb), gl);
+    v->status->signals[SIG_VALUE_CHANGED]         = g_signal_connect(a,      "value-changed",                         G_CALLBACK(view_value_changed_cb), gl);
+    v->status->signals[SIG_TAB_BUTTON_PRESS]      = g_signal_connect(v->tabevent, "button-press-event",               G_CALLBACK(view_tab_button_press_cb), gl);
+}/*}}}*/
+
 /* view_init_signals(View *v) {{{*/
 static void
 view_init_signals(GList *gl) 
 {
     View *v = gl->data;
-    GtkAdjustment *a = gtk_scrolled_window_get_vadjustment(GTK_SCROLLED_WINDOW(v->scroll));
     g_signal_connect(v->web, "key-press-event", G_CALLBACK(view_key_ignore_cb), gl);
     g_signal_connect(v->web, "key-release-event", G_CALLBACK(view_key_ignore_cb), gl);
     v->status->signals[SIG_BUTTON_PRESS]          = g_signal_connect(v->web, "button-press-event",                    G_CALLBACK(view_button_press_cb), gl);
@@ -1647,18 +1662,15 @@ view_init_signals(GList *gl)
     v->status->signals[SIG_TITLE]                 = g_signal_connect(v->web, "notify::title",                         G_CALLBACK(view_title_cb), gl);
     v->status->signals[SIG_URI]                   = g_signal_connect(v->web, "notify::uri",                           G_CALLBACK(view_uri_cb), gl);
     v->status->signals[SIG_SCROLL]                = g_signal_connect(v->web, "scroll-event",                          G_CALLBACK(view_scroll_cb), gl);
-    v->status->signals[SIG_SCROLL_TAB]            = g_signal_connect(v->tabevent, "scroll-event",                          G_CALLBACK(view_scroll_tab_cb), gl);
 #if WEBKIT_CHECK_VERSION(1, 10, 0) 
     v->status->signals[SIG_RUN_FILE_CHOOSER]      = g_signal_connect(v->web,      "run-file-chooser",                         G_CALLBACK(view_run_file_chooser_cb), gl);
 #endif
-    v->status->signals[SIG_VALUE_CHANGED]         = g_signal_connect(a,      "value-changed",                         G_CALLBACK(view_value_changed_cb), gl);
-    if (GET_BOOL("enable-favicon")) 
+    if (GET_BOOL(SETTINGS_ENABLE_FAVICON)) 
         v->status->signals[SIG_ICON_LOADED]           = g_signal_connect(v->web, "icon-loaded",                           G_CALLBACK(view_icon_loaded), gl);
 
     /* v->status->signals[SIG_ENTRY_ACTIVATE]        = g_signal_connect(v->entry, "activate",                            G_CALLBACK(view_entry_activate_cb), gl); */
 
     v->status->signals[SIG_MOTION_NOTIFY] = g_signal_connect(v->web, "motion-notify-event", G_CALLBACK(view_motion_notify_cb), gl);
-    v->status->signals[SIG_TAB_BUTTON_PRESS]      = g_signal_connect(v->tabevent, "button-press-event",               G_CALLBACK(view_tab_button_press_cb), gl);
     //WebKitWebFrame *frame = webkit_web_view_get_main_frame(WEBKIT_WEB_VIEW(v->web));
     //v->status->signals[SIG_MAIN_FRAME_COMMITTED]  = g_signal_connect(frame, "load-committed", G_CALLBACK(view_main_frame_committed_cb), gl);
 
@@ -1667,6 +1679,26 @@ view_init_signals(GList *gl)
     g_signal_connect(inspector, "inspect-web-view", G_CALLBACK(view_inspect_web_view_cb), gl);
 } /*}}}*/
 
+/* view_new_web(View *) {{{*/
+/* 
+ * Creates the webview of a tab, signals and settings are applied by
+ * view_init_signals and view_init_settings. 
+ * */
+static void
+view_new_web(View *v) 
+{
+    v->web = webkit_web_view_new();
+    gtk_container_add(GTK_CONTAINER(v->scroll), v->web);
+#if !_HAS_GTK3
+    if (! GET_BOOL(SETTINGS_SCROLLBARS)) 
+    {
+        WebKitWebFrame *frame = webkit_web_view_get_main_frame(WEBKIT_WEB_VIEW(v->web));
+        g_signal_connect(frame, "scrollbars-policy-changed", G_CALLBACK(gtk_true), NULL);
+    }
+#endif
+    gtk_widget_show(v->web);
+}/*}}}*/
+
 /* view_create_web_view(View *v)         return: GList * {{{*/
 static View * 
 view_create_web_view() 
@@ -1687,31 +1719,33 @@ view_create_web_view()
     status->lockprotect = 0;
     status->frames = NULL;
     status->group = 0;
-    status->deferred = GET_BOOL("load-on-focus");
+    status->deferred = GET_BOOL(SETTINGS_LOAD_ON_FOCUS);
     status->deferred_uri = NULL;
+    status->hibernation = NULL;
+    status->last_focus = g_get_monotonic_time();
+    status->blocked_requests = 0;
+    status->third_party = NULL;
+    status->pending_update = 0;
 
     v->js_base = NULL;
     v->inspector_window = NULL;
+    v->index = -1;
+    v->id = ++s_view_id;
     v->plugins = plugins_new();
     for (int i=0; i<SIG_LAST; i++) 
         status->signals[i] = 0;
     v->status = status;
     CLEAR_MARKS(v);
 
-    v->web = webkit_web_view_new();
+    v->settings = NULL;
 
     /* Srolling */
     v->scroll = gtk_scrolled_window_new(NULL, NULL);
-    gtk_container_add(GTK_CONTAINER(v->scroll), v->web);
-
 #if !_HAS_GTK3
-    if (! GET_BOOL("scrollbars")) 
-    {
-        WebKitWebFrame *frame = webkit_web_view_get_main_frame(WEBKIT_WEB_VIEW(v->web));
-        g_signal_connect(frame, "scrollbars-policy-changed", G_CALLBACK(gtk_true), NULL);
+    if (! GET_BOOL(SETTINGS_SCROLLBARS)) 
         gtk_scrolled_window_set_policy(GTK_SCROLLED_WINDOW(v->scroll), GTK_POLICY_NEVER, GTK_POLICY_NEVER);
-    }
 #endif
+    view_new_web(v);
 
 
     /* Tabbar */
@@ -1742,7 +1776,7 @@ view_create_web_view()
     gtk_box_pack_end(GTK_BOX(v->tabbox), v->tabicon, false, false, 0);
 
     GtkWidget *alignment = gtk_alignment_new(0.5, 0.5, 1, 1);
-    int padding = GET_INT("bars-padding");
+    int padding = GET_INT(SETTINGS_BARS_PADDING);
     gtk_alignment_set_padding(GTK_ALIGNMENT(alignment), padding, padding, padding, padding);
     gtk_container_add(GTK_CONTAINER(alignment), v->tabbox);
     gtk_container_add(GTK_CONTAINER(v->tabevent), alignment);
@@ -1765,6 +1799,264 @@ view_clear_tab(GList *gl)
     dwb_load_uri(gl, "about:blank");
 }/*}}}*/
 
+/* view_hibernation_free {{{*/
+static void
+view_hibernation_free(ViewHibernation *h)
+{
+    if (h == NULL)
+        return;
+    g_list_free_full(h->items, (GDestroyNotify)dwb_navigation_free);
+    g_free(h);
+}/*}}}*/
+
+/* view_can_hibernate(GList *) {{{*/
+static gboolean
+view_can_hibernate(GList *gl)
+{
+    View *v = VIEW(gl);
+    const char *uri;
+
+    if (gl == dwb.state.fview || v->status->deferred || v->status->hibernation != NULL)
+        return false;
+    if (v->status->lockprotect != 0 || v->status->progress != 0 || v->inspector_window != NULL)
+        return false;
+    uri = webkit_web_view_get_uri(WEBKIT_WEB_VIEW(v->web));
+    return uri != NULL && strcmp(uri, "about:blank");
+}/*}}}*/
+
+/* view_suspend(GList *, ViewHibernation *) {{{*/
+/*
+ * Puts a tab into hibernated state, the webview of the tab must be an empty
+ * webview without signals and settings, it is set up when the tab is woken
+ * up. 
+ * */
+static void
+view_suspend(GList *gl, ViewHibernation *h)
+{
+    View *v = VIEW(gl);
+    static guint serial;
+
+    h->current = g_list_nth_data(h->items, g_list_length(h->items) - h->forward - 1);
+    h->serial = ++serial;
+    g_free(v->status->deferred_uri);
+    v->status->deferred_uri = g_strdup(h->current->first);
+    v->status->deferred = true;
+    v->status->hibernation = h;
+    v->status->progress = 0;
+
+    dwb_tab_label_set_text(gl, NULL);
+}/*}}}*/
+
+/* view_replace_web(GList *) {{{*/
+/*
+ * Destroys the webview of a tab and replaces it by an empty one, the scrolled
+ * window and the tab label are kept, scripts get a new webview object for the
+ * tab.
+ * */
+static void
+view_replace_web(GList *gl)
+{
+    View *v = VIEW(gl);
+
+    plugins_disconnect(gl);
+    adblock_disconnect(gl);
+    if (v->js_base != NULL)
+    {
+        JSValueUnprotect(JS_CONTEXT_REF(gl), v->js_base);
+        v->js_base = NULL;
+    }
+    g_slist_free_full(v->status->frames, (GDestroyNotify)util_free_weak_ref);
+    v->status->frames = NULL;
+
+    /* Handlers on the old webview are gone with it */
+    for (int i=0; i<SIG_LAST; i++) 
+    {
+        if (i != SIG_SCROLL_TAB && i != SIG_VALUE_CHANGED && i != SIG_TAB_BUTTON_PRESS)
+            v->status->signals[i] = 0;
+    }
+    webkit_web_view_stop_loading(WEBKIT_WEB_VIEW(v->web));
+    gtk_widget_destroy(v->web);
+    view_new_web(v);
+    scripts_reset_tab(gl);
+}/*}}}*/
+
+/* view_hibernate(GList *) {{{*/
+/*
+ * Unloads the page of a background tab, the back-forward list and the scroll
+ * position are kept and restored when the tab gets focus again. 
+ * */
+gboolean
+view_hibernate(GList *gl)
+{
+    if (!view_can_hibernate(gl))
+        return false;
+
+    View *v = VIEW(gl);
+    WebKitWebBackForwardList *bf_list = webkit_web_view_get_back_forward_list(WEBKIT_WEB_VIEW(v->web));
+    GList *items = NULL;
+    int forward = 0;
+
+    for (int i = -webkit_web_back_forward_list_get_back_length(bf_list); i<=webkit_web_back_forward_list_get_forward_length(bf_list); i++)
+    {
+        Navigation *n = dwb_navigation_from_webkit_history_item(webkit_web_back_forward_list_get_nth_item(bf_list, i));
+        if (n != NULL)
+        {
+            items = g_list_append(items, n);
+            if (i > 0)
+                forward++;
+        }
+    }
+    if (items == NULL || forward == (int)g_list_length(items))
+    {
+        g_list_free_full(items, (GDestroyNotify)dwb_navigation_free);
+        return false;
+    }
+
+    ViewHibernation *h = dwb_malloc(sizeof(ViewHibernation));
+    h->items = items;
+    h->forward = forward;
+    h->lockprotect = 0;
+    h->gl = gl;
+    h->hscroll = gtk_adjustment_get_value(gtk_scrolled_window_get_hadjustment(GTK_SCROLLED_WINDOW(v->scroll)));
+    h->vscroll = gtk_adjustment_get_value(gtk_scrolled_window_get_vadjustment(GTK_SCROLLED_WINDOW(v->scroll)));
+
+    view_replace_web(gl);
+    view_suspend(gl, h);
+    return true;
+}/*}}}*/
+
+/* view_add_hibernated(GList *, int, unsigned int, int) {{{*/
+/*
+ * Adds a placeholder tab that only holds a back-forward list and a tab label,
+ * its webview is neither set up nor realized until the tab gets focus for the
+ * first time, then the list is applied and loaded. Takes ownership of items,
+ * a list of Navigation, forward is the number of items after the current
+ * item. The tab is inserted at position, see view_add_at.
+ * */
+GList *
+view_add_hibernated(GList *items, int forward, unsigned int lockprotect, int position)
+{
+    g_return_val_if_fail(items != NULL && forward < (int)g_list_length(items), NULL);
+
+    GList *gl = view_add_tab(NULL, true, true, position);
+    if (gl == NULL)
+    {
+        g_list_free_full(items, (GDestroyNotify)dwb_navigation_free);
+        return NULL;
+    }
+
+    ViewHibernation *h = dwb_malloc(sizeof(ViewHibernation));
+    h->items = items;
+    h->forward = forward;
+    h->lockprotect = lockprotect;
+    h->hscroll = h->vscroll = 0;
+    h->gl = gl;
+
+    view_suspend(gl, h);
+    return gl;
+}/*}}}*/
+
+/* view_wake_load_status_cb {{{*/
+static void
+view_wake_load_status_cb(WebKitWebView *web, GParamSpec *p, ViewHibernation *h)
+{
+    WebKitLoadStatus status = webkit_web_view_get_load_status(web);
+    if (status == WEBKIT_LOAD_FINISHED)
+    {
+        GtkScrolledWindow *sw = GTK_SCROLLED_WINDOW(VIEW(h->gl)->scroll);
+        gtk_adjustment_set_value(gtk_scrolled_window_get_hadjustment(sw), h->hscroll);
+        gtk_adjustment_set_value(gtk_scrolled_window_get_vadjustment(sw), h->vscroll);
+        if (h->lockprotect != 0)
+        {
+            VIEW(h->gl)->status->lockprotect = h->lockprotect;
+            dwb_tab_label_set_text(h->gl, NULL);
+        }
+    }
+    if (status == WEBKIT_LOAD_FINISHED || status == WEBKIT_LOAD_FAILED)
+        g_signal_handlers_disconnect_by_func(web, view_wake_load_status_cb, h);
+}/*}}}*/
+
+/* view_wake(GList *) {{{*/
+void
+view_wake(GList *gl)
+{
+    View *v = VIEW(gl);
+    ViewHibernation *h = v->status->hibernation;
+    if (h == NULL)
+        return;
+
+    int forward = h->forward;
+    WebKitWebView *web = WEBKIT_WEB_VIEW(v->web);
+    WebKitWebBackForwardList *bf_list = webkit_web_view_get_back_forward_list(web);
+
+    v->status->hibernation = NULL;
+    v->status->deferred = false;
+
+    view_init_signals(gl);
+    view_init_settings(gl);
+    /* adblock may have been reconnected to the empty webview */
+    adblock_disconnect(gl);
+    if (GET_BOOL(SETTINGS_ADBLOCKER))
+        adblock_connect(gl);
+
+    for (GList *l = h->items; l; l=l->next)
+    {
+        Navigation *n = l->data;
+        WebKitWebHistoryItem *item = webkit_web_history_item_new_with_data(n->first, n->second);
+        webkit_web_back_forward_list_add_item(bf_list, item);
+        g_object_unref(item);
+    }
+    if (h->hscroll > 0 || h->vscroll > 0 || h->lockprotect != 0)
+        g_signal_connect_data(web, "notify::load-status", G_CALLBACK(view_wake_load_status_cb), h,
+                (GClosureNotify)view_hibernation_free, 0);
+    else
+        view_hibernation_free(h);
+
+    if (forward > 0)
+        webkit_web_view_go_back_or_forward(web, -forward);
+    else
+        webkit_web_view_go_to_back_forward_item(web, webkit_web_back_forward_list_get_nth_item(bf_list, 0));
+}/*}}}*/
+
+/* view_hibernate_idle(int timeout, int max_tabs) {{{*/
+static int
+view_compare_last_focus(GList *a, GList *b)
+{
+    gint64 la = VIEW(a)->status->last_focus, lb = VIEW(b)->status->last_focus;
+    return la < lb ? -1 : la > lb;
+}
+/*
+ * Hibernates background tabs that haven't had focus for timeout seconds and
+ * least recently focused tabs while more than max_tabs tabs are loaded, 0
+ * disables either of them.
+ * */
+void
+view_hibernate_idle(int timeout, int max_tabs)
+{
+    gint64 now = g_get_monotonic_time();
+    GList *candidates = NULL;
+    int loaded = 0;
+
+    for (GList *gl = dwb.state.views; gl; gl=gl->next)
+    {
+        if (!VIEW(gl)->status->deferred)
+            loaded++;
+        if (view_can_hibernate(gl))
+            candidates = g_list_prepend(candidates, gl);
+    }
+    candidates = g_list_sort(candidates, (GCompareFunc)view_compare_last_focus);
+    for (GList *l = candidates; l; l=l->next)
+    {
+        gint64 idle = now - VIEW(l->data)->status->last_focus;
+        if ((timeout > 0 && idle >= (gint64)timeout * G_USEC_PER_SEC) || (max_tabs > 0 && loaded > max_tabs))
+        {
+            if (view_hibernate(l->data))
+                loaded--;
+        }
+    }
+    g_list_free(candidates);
+}/*}}}*/
+
 void
 view_clean(GList *gl) 
 {
@@ -1809,11 +2101,15 @@ view_clean(GList *gl)
         g_slist_free(v->status->styles);
     }
 
-    g_object_unref(v->settings);
+    if (v->settings != NULL)
+        g_object_unref(v->settings);
     /* Destroy widget */
     gtk_widget_destroy(v->web);
     gtk_widget_destroy(v->scroll);
 
+    view_hibernation_free(v->status->hibernation);
+    if (v->status->third_party != NULL)
+        g_hash_table_unref(v->status->third_party);
     FREE0(v->status->deferred_uri);
     FREE0(v->status->hover_uri);
 #ifdef WITH_LIBSOUP_2_38
@@ -1841,7 +2137,7 @@ view_remove(GList *gl)
     }
     if (dwb.state.nummod >= 0) 
     {
-        gl = g_list_nth(dwb.state.views, dwb.state.nummod - 1);
+        gl = dwb_tab_nth(dwb.state.nummod - 1);
         if (gl == NULL)
             return STATUS_OK;
     }
@@ -1849,7 +2145,7 @@ view_remove(GList *gl)
         gl = dwb.state.fview;
 
     View *v = gl->data;
-    int position = g_list_position(dwb.state.views, gl);
+    int position = dwb_tab_index(gl);
     /* Check for protected tab */
     if (LP_PROTECTED(v) && !dwb_confirm(dwb.state.fview, "Really close tab %d [y/n]?", position + 1) ) 
     {
@@ -1895,30 +2191,46 @@ view_remove(GList *gl)
         dwb.state.last_tab = -1;
     }
 
-    /* Get History for the undo list */
-    WebKitWebBackForwardList *bflist = webkit_web_view_get_back_forward_list(WEBKIT_WEB_VIEW(v->web));
-    if ( bflist != NULL ) 
+    /* Get History for the undo list, the webview of a hibernated tab has no
+     * history, it is stored in the hibernation */
+    GList *store = NULL;
+    if (v->status->hibernation != NULL) 
     {
-        GList *store = NULL;
-
-        for (int i = -webkit_web_back_forward_list_get_back_length(bflist); i<=0; i++) 
+        ViewHibernation *h = v->status->hibernation;
+        int back = (int)g_list_length(h->items) - h->forward;
+        int i = 0;
+        for (GList *l = h->items; l && i < back; l=l->next, i++) 
         {
-            WebKitWebHistoryItem *item = webkit_web_back_forward_list_get_nth_item(bflist, i);
-            Navigation *n = dwb_navigation_from_webkit_history_item(item);
-            if (n) 
-                store = g_list_append(store, n);
+            Navigation *n = l->data;
+            store = g_list_append(store, dwb_navigation_new(n->first, n->second));
+        }
+    }
+    else 
+    {
+        WebKitWebBackForwardList *bflist = webkit_web_view_get_back_forward_list(WEBKIT_WEB_VIEW(v->web));
+        if ( bflist != NULL ) 
+        {
+            for (int i = -webkit_web_back_forward_list_get_back_length(bflist); i<=0; i++) 
+            {
+                WebKitWebHistoryItem *item = webkit_web_back_forward_list_get_nth_item(bflist, i);
+                Navigation *n = dwb_navigation_from_webkit_history_item(item);
+                if (n) 
+                    store = g_list_append(store, n);
+            }
         }
-        dwb.state.undo_list = g_list_prepend(dwb.state.undo_list, store);
     }
+    if (store != NULL)
+        dwb.state.undo_list = g_list_prepend(dwb.state.undo_list, store);
 
     dwb_focus_view(new_fview, "close_tab");
     view_clean(gl);
 
-    IPC_SEND_HOOK(close_tab, "%d", g_list_position(dwb.state.views, gl) + 1);
+    IPC_SEND_HOOK(close_tab, "%d", position + 1);
 
     dwb_source_remove();
 
     dwb.state.views = g_list_delete_link(dwb.state.views, gl);
+    dwb_tabs_reindex();
     if (!dwb.state.views->next && !dwb.misc.show_single_tab)
         gtk_widget_hide(dwb.gui.tabbox);
 
@@ -1954,9 +2266,14 @@ view_ssl_state(GList *gl)
 }/*}}}*/
 
 
-/* view_add(Arg *arg)               return: View *{{{*/
-GList *  
-view_add(const char *uri, gboolean background) 
+/* view_add_tab(const char *, gboolean, gboolean, int)     return: GList *{{{*/
+/* 
+ * Adds a tab, the webview of a placeholder tab gets no signals and settings,
+ * they are applied by view_wake. If position is negative the position is
+ * determined by new-tab-position-policy.
+ * */
+static GList *  
+view_add_tab(const char *uri, gboolean background, gboolean placeholder, int position) 
 {
     GList *ret = NULL;
 
@@ -1972,18 +2289,20 @@ view_add(const char *uri, gboolean background)
     gtk_box_pack_end(GTK_BOX(dwb.gui.tabcontainer), v->tabevent, true, true, 0);
 #endif
 
-    int length = g_list_length(dwb.state.views);
+    int length = dwb_tab_count();
     if (dwb.state.fview) 
     {
         int p;
-        if (dwb.misc.tab_position & TAB_POSITION_RIGHTMOST) 
+        if (position >= 0)
+            p = MIN(position, length);
+        else if (dwb.misc.tab_position & TAB_POSITION_RIGHTMOST) 
             p = length;
         else if (dwb.misc.tab_position & TAB_POSITION_LEFT) 
-            p = g_list_position(dwb.state.views, dwb.state.fview);
+            p = dwb_tab_index(dwb.state.fview);
         else if (dwb.misc.tab_position & TAB_POSITION_LEFTMOST) 
             p = 0;
         else 
-            p = g_list_position(dwb.state.views, dwb.state.fview) + 1;
+            p = dwb_tab_index(dwb.state.fview) + 1;
 
 #if _HAS_GTK3
         gtk_box_reorder_child(GTK_BOX(dwb.gui.tabbox), v->tabevent, length - p);
@@ -1992,7 +2311,8 @@ view_add(const char *uri, gboolean background)
 #endif
         gtk_box_insert(GTK_BOX(dwb.gui.mainbox), v->scroll, true, true, 0, p, GTK_PACK_START);
         dwb.state.views = g_list_insert(dwb.state.views, v, p);
-        ret = g_list_nth(dwb.state.views, p);
+        dwb_tabs_reindex();
+        ret = dwb_tab_nth(p);
         scripts_create_tab(ret);
 
         if (background) 
@@ -2009,6 +2329,7 @@ view_add(const char *uri, gboolean background)
     {
         gtk_box_pack_start(GTK_BOX(dwb.gui.mainbox), v->scroll, true, true, 0);
         dwb.state.views = g_list_prepend(dwb.state.views, v);
+        dwb_tabs_reindex();
         ret = dwb.state.views;
         scripts_create_tab(ret);
         dwb_focus(ret);
@@ -2027,7 +2348,7 @@ view_add(const char *uri, gboolean background)
 #endif
         }
     }
-    IPC_SEND_HOOK(new_tab, "%d %s", g_list_position(dwb.state.views, ret) + 1, uri ? uri : "");
+    IPC_SEND_HOOK(new_tab, "%d %s", dwb_tab_index(ret) + 1, uri ? uri : "");
     if (EMIT_SCRIPT(CREATE_TAB)) 
     {
         /**
@@ -2053,10 +2374,14 @@ view_add(const char *uri, gboolean background)
         g_free(json);
     }
 
-    view_init_signals(ret);
-    view_init_settings(ret);
-    if (GET_BOOL("adblocker"))
-        adblock_connect(ret);
+    view_init_tab_signals(ret);
+    if (!placeholder) 
+    {
+        view_init_signals(ret);
+        view_init_settings(ret);
+        if (GET_BOOL(SETTINGS_ADBLOCKER))
+            adblock_connect(ret);
+    }
 
     dwb_update_layout();
 
@@ -2066,4 +2391,23 @@ view_add(const char *uri, gboolean background)
     return ret;
 } /*}}}*/
 
+/* view_add(const char *, gboolean)               return: GList *{{{*/
+GList *  
+view_add(const char *uri, gboolean background) 
+{
+    return view_add_tab(uri, background, false, -1);
+} /*}}}*/
+
+/* view_add_at(const char *, gboolean, int)       return: GList *{{{*/
+/*
+ * Adds a tab at position, ignoring new-tab-position-policy, a position
+ * greater than the number of tabs appends the tab
+ * */
+GList *  
+view_add_at(const char *uri, gboolean background, int position) 
+{
+    g_return_val_if_fail(position >= 0, NULL);
+    return view_add_tab(uri, background, false, position);
+} /*}}}*/
+
 /*}}}*/
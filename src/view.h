@@ -20,6 +20,7 @@
 #define __DWB_VIEW_H__
 
 GList * view_add(const char *uri, gboolean background);
+GList * view_add_at(const char *uri, gboolean background, int position);
 DwbStatus view_remove(GList *gl);
 void view_clean(GList *gl);
 DwbStatus view_push_master(Arg *);
@@ -29,6 +30,10 @@ void view_modify_style(GList *, DwbColor *tabfg, DwbColor *tabbg, PangoFontDescr
 void view_icon_loaded(WebKitWebView *web, char *icon_uri, GList *gl);
 void view_set_favicon(GList *gl, gboolean);
 void view_clear_tab(GList *gl);
+gboolean view_hibernate(GList *gl);
+GList * view_add_hibernated(GList *items, int forward, unsigned int lockprotect, int position);
+void view_wake(GList *gl);
+void view_hibernate_idle(int timeout, int max_tabs);
 
 GtkWidget * dwb_web_view_create_plugin_widget_cb(WebKitWebView *, char *, char *, GHashTable *, GList *);
 #endif